@@ -1,6 +1,13 @@
 `timescale 1ns / 1ps
 
-module WaveGen(
+// PARALLEL_DAC selects the sample strobe: 0 = the SPI DAC's LDAC pulse,
+// 1 = ParallelDAC (12-bit DDR bus on gpio[15:4], DAC clock on gpio[23],
+// clk100 / PAR_DAC_CLK_DIV samples per second; set the IP's
+// SAMPLING_FREQUENCY to match). The SPI DAC keeps running either way.
+module WaveGen #(
+    parameter bit PARALLEL_DAC = 1'b0,
+    parameter int PAR_DAC_CLK_DIV = 20
+)(
     input wire clk100,
     output wire [9:0] led,
     output wire [2:0] rgb0,
@@ -68,7 +75,13 @@ module WaveGen(
 
     wire [11:0] dac_a_out, dac_b_out;
     wire sdi, cs, ldac, sck;
-    assign gpio = {4'b0, ldac, sdi, sck, cs, 16'b0};
+    wire sync_out;
+    wire [11:0] par_data;
+    wire par_clk, par_en;
+    // gpio[20] is the external trigger input, gpio[21] the sync input and
+    // gpio[3:0] the profile select inputs (released to high-Z); gpio[22]
+    // is the sync output
+    assign gpio = {par_clk, sync_out, 1'bz, 1'bz, ldac, sdi, sck, cs, par_data, 4'bz};
     
     // Instantiate DACs
     voltsToDACWords #(
@@ -96,6 +109,53 @@ module WaveGen(
         .sdi(sdi),
         .ldac(ldac)
     );  
+
+    // Parallel DAC: nominal two-point codes for a +/-2.5 V 12-bit DAC,
+    // replace with measured values as for the SPI DAC
+    generate
+        if (PARALLEL_DAC) begin : parallel
+            wire [11:0] code_a, code_b;
+
+            voltsToDACCodes #(
+                .DAC_TWOPOINTFIVE(4095),
+                .DAC_ZERO(2048),
+                .M(12)
+            ) cal_a (
+                .clk(clk100),
+                .in(out_a),
+                .calibrated(code_a)
+            );
+
+            voltsToDACCodes #(
+                .DAC_TWOPOINTFIVE(4095),
+                .DAC_ZERO(2048),
+                .M(12)
+            ) cal_b (
+                .clk(clk100),
+                .in(out_b),
+                .calibrated(code_b)
+            );
+
+            ParallelDAC #(
+                .WIDTH(12),
+                .CLK_DIV(PAR_DAC_CLK_DIV),
+                .DDR(1'b1),
+                .TWOS_COMPLEMENT(1'b1)
+            ) dac (
+                .clk(clk100),
+                .code_a(code_a),
+                .code_b(code_b),
+                .sample_en(par_en),
+                .dac_clk(par_clk),
+                .data_a(par_data),
+                .data_b()
+            );
+        end else begin : no_parallel
+            assign par_data = 12'b0;
+            assign par_clk = 1'b0;
+            assign par_en = 1'b0;
+        end
+    endgenerate
     
     system_wrapper system_wrapper_i (
         .DDR_addr(ddr_addr),
@@ -113,7 +173,11 @@ module WaveGen(
         .DDR_ras_n(ddr_ras_n),
         .DDR_reset_n(ddr_reset_n),
         .DDR_we_n(ddr_we_n),
-        .EN_0(ldac == 1'b0),
+        .EN_0(PARALLEL_DAC ? par_en : ldac == 1'b0),
+        .EXT_TRIG_0(gpio[20]),
+        .PROFILE_SEL_0(gpio[3:0]),
+        .SYNC_IN_0(gpio[21]),
+        .SYNC_OUT_0(sync_out),
         .FIXED_IO_ddr_vrn(fixed_io_ddr_vrn),
         .FIXED_IO_ddr_vrp(fixed_io_ddr_vrp),
         .FIXED_IO_mio(fixed_io_mio),
@@ -2,13 +2,26 @@
 
 module wavegen_v1_0 #(
     parameter integer C_S00_AXI_DATA_WIDTH = 32,
-    parameter integer C_S00_AXI_ADDR_WIDTH = 14,
+    parameter integer C_S00_AXI_ADDR_WIDTH = 16,
     parameter integer SAMPLING_FREQUENCY = 50000,
-    parameter integer ARB_WAVEFORM_DEPTH = 1024
+    parameter integer ARB_WAVEFORM_DEPTH = 1024,
+    parameter integer INTERP_STAGES = 0,
+    parameter integer SINE_LUT_ADDR_WIDTH = 9,
+    parameter integer SINE_LUT_DATA_WIDTH = 16,
+    parameter         SINE_LUT_FILE = "coe/sin_LUT.hex",
+    parameter integer SINE_CORDIC = 0,
+    parameter integer CORDIC_ITERATIONS = 16,
+    parameter integer CORDIC_WIDTH = 16,
+    parameter integer NUM_PROFILES = 8,
+    parameter integer CAPTURE_DEPTH = 1024
 )(
     // Users to add ports here
     input wire clk,
     input wire en,
+    input wire ext_trigger,
+    input wire [3:0] profile_sel,
+    input wire sync_in,
+    output wire sync_out,
     output wire signed [15:0] out_a,
     output wire signed [15:0] out_b,
     // User ports ends
@@ -42,7 +55,16 @@ module wavegen_v1_0 #(
     wavegen_v1_0_S00_AXI #(
         .C_S_AXI_ADDR_WIDTH(C_S00_AXI_ADDR_WIDTH),
         .SAMPLING_FREQUENCY(SAMPLING_FREQUENCY),
-        .ARB_WAVEFORM_DEPTH(ARB_WAVEFORM_DEPTH)
+        .ARB_WAVEFORM_DEPTH(ARB_WAVEFORM_DEPTH),
+        .INTERP_STAGES(INTERP_STAGES),
+        .SINE_LUT_ADDR_WIDTH(SINE_LUT_ADDR_WIDTH),
+        .SINE_LUT_DATA_WIDTH(SINE_LUT_DATA_WIDTH),
+        .SINE_LUT_FILE(SINE_LUT_FILE),
+        .SINE_CORDIC(SINE_CORDIC),
+        .CORDIC_ITERATIONS(CORDIC_ITERATIONS),
+        .CORDIC_WIDTH(CORDIC_WIDTH),
+        .NUM_PROFILES(NUM_PROFILES),
+        .CAPTURE_DEPTH(CAPTURE_DEPTH)
     ) wavegen_v1_0_S00_AXI_inst (
         .s_axi_aclk(s00_axi_aclk),
         .s_axi_aresetn(s00_axi_aresetn),
@@ -67,6 +89,10 @@ module wavegen_v1_0 #(
         .s_axi_rready(s00_axi_rready),
         .sample_clk(en),
         .lut_clk(clk),
+        .ext_trigger(ext_trigger),
+        .profile_sel(profile_sel),
+        .sync_in(sync_in),
+        .sync_out(sync_out),
         .out_a(out_a),
         .out_b(out_b)
     );
@@ -6,13 +6,44 @@
 // AXI4-Lite slave interface for the waveform generator IP.
 // Features:
 //   - Shadow register system for atomic parameter updates
-//   - Software trigger for synchronized channel start
+//   - Software/external trigger with armed start and latency counter
+//   - AM/FM/PM modulation from an internal oscillator or the other channel
+//   - Performance counters with coherent snapshot
+//   - Optional half-band interpolation between the engine and the DAC path
+//     (INTERP_STAGES; the engine runs at SAMPLING_FREQUENCY / 2^stages)
+//   - Configurable sine LUT resolution (SINE_LUT_ADDR_WIDTH/DATA_WIDTH;
+//     SINE_LUT_FILE must be generated with matching coe.py options), or a
+//     BRAM-free CORDIC sine engine (SINE_CORDIC, CORDIC_ITERATIONS/WIDTH)
+//   - Quadrature mode: a channel outputs the cosine of the other
+//     channel's phase, for I/Q pairs
+//   - Configuration profiles: NUM_PROFILES banks of per-channel settings,
+//     applied atomically by one PROFILE_SEL write or the profile_sel pins
+//   - Timed commit: shadows applied at a 64-bit engine sample timestamp
+//     or at the next phase wrap of a channel
+//   - Multi-board sync: sync_out pulse (on request or periodic) and a
+//     sync_in edge that restarts or releases the selected channels
+//   - Noise mode: per-channel seedable xorshift noise, uniform or gaussian
+//   - ARB playback of any table length, optionally linearly interpolated
+//   - Output capture: CAPTURE_DEPTH samples of both channels with
+//     pre-trigger depth and decimation, read back through a window
 //   - Status readback register
 //   - Arbitrary waveform data loading via extended address space
 //   - Dynamic reconfiguration with glitch-free parameter updates
 //
+// Address regions (address bits [15:14]):
+//   0x0000-0x3FFF  Control registers (decoded on bits [9:2])
+//   0x4000-0x7FFF  ARB sample window: sample n at 0x4000 + n*4
+//   0x8000-0xBFFF  Capture window [RO]: captured sample n (oldest first) at
+//                  0x8000 + n*4 as {out_b, out_a}
+//   0xC000-0xC3FF  Profile banks: profile p at 0xC000 + p*0x40, holding
+//                  MODE, FREQ_A, FREQ_B, OFFSET, AMPLTD, DTCYC, CYCLES and
+//                  PHASE_OFF at their register offsets (0x00-0x20; 0x04
+//                  is reserved). Read/write; applied only by PROFILE_SEL.
+//
 // Register Map (active registers, 32-bit aligned):
 //   0x00  MODE        [7:4]=mode_b, [3:0]=mode_a
+//                     (0=DC, 1=sine, 2=saw, 3=triangle, 4=square, 5=ARB,
+//                     6=noise, 7=quadrature)
 //   0x04  RUN         [1]=enable_b, [0]=enable_a
 //   0x08  FREQ_A      [31:0]=frequency channel A (100uHz units)
 //   0x0C  FREQ_B      [31:0]=frequency channel B (100uHz units)
@@ -21,23 +52,93 @@
 //   0x18  DTCYC       [31:16]=dtcyc_b, [15:0]=dtcyc_a
 //   0x1C  CYCLES      [31:16]=cycles_b, [15:0]=cycles_a
 //   0x20  PHASE_OFF   [31:16]=phase_off_b, [15:0]=phase_off_a
-//   0x24  ARB_DEPTH   [31:0]=arb waveform depth (samples)
-//   0x28  ARB_DATA    [15:0]=arb sample (addr via write offset)
+//   0x24  ARB_DEPTH   [31:0]=arb waveform depth (samples, any length up to
+//                     ARB_WAVEFORM_DEPTH; 0 = ARB_WAVEFORM_DEPTH)
+//   0x28  (reserved, formerly ARB_DATA; use the ARB window)
 //   0x2C  RECONFIG    Write any value to apply shadow registers
-//   0x30  STATUS      [RO] [3]=ch_b_running, [2]=ch_a_running,
+//   0x30  STATUS      [RO] [5]=ch_b_armed, [4]=ch_a_armed,
+//                           [3]=ch_b_running, [2]=ch_a_running,
 //                           [1]=reconfig_busy, [0]=ready
 //   0x34  TRIGGER     Write: [1]=trigger_b, [0]=trigger_a
 //   0x38  SOFT_RESET  Write: [1]=reset_b, [0]=reset_a
+//   0x3C  TRIG_CFG    [23:16]=trig_cfg_b, [7:0]=trig_cfg_a
+//                     per channel: [0]=arm, [1]=ext_en, [3:2]=edge
+//   0x40  TRIG_LAT_A  [RO] trigger-to-start latency A (lut_clk cycles)
+//   0x44  TRIG_LAT_B  [RO] trigger-to-start latency B (lut_clk cycles)
+//   0x48  MOD_CFG     [23:16]=mod_cfg_b, [7:0]=mod_cfg_a
+//                     per channel: [1:0]=type (off/AM/FM/PM), [2]=source
+//   0x4C  MOD_DEPTH   [31:16]=depth_b, [15:0]=depth_a (AM depth / PM dev)
+//   0x50  MOD_FREQ_A  [31:0]=internal modulator frequency A (100uHz units)
+//   0x54  MOD_FREQ_B  [31:0]=internal modulator frequency B (100uHz units)
+//   0x58  MOD_DEV_A   [31:0]=FM peak deviation A (100uHz units)
+//   0x5C  MOD_DEV_B   [31:0]=FM peak deviation B (100uHz units)
+//   0x60  CNT_CTRL    Write: [1]=clear counters, [0]=snapshot counters
+//   0x64  PROFILE_SEL [3:0]=profile, [8]=pin select, [23:16]=NUM_PROFILES (RO)
+//                     Writing with [8]=0 loads profile [3:0] into the shadow
+//                     and active registers in one cycle. With [8]=1 the
+//                     synchronized profile_sel pins choose the profile and
+//                     every stable change is applied the same way; reads
+//                     return the last applied profile in [3:0].
+//   0x68  COMMIT_CTRL Write [1:0]: 0=cancel, 1=apply shadows at COMMIT_TIME,
+//                     2=at next phase wrap of A, 3=at next phase wrap of B.
+//                     Read: [1:0]=pending commit (0 = none),
+//                     [4]=last timed commit was late (time already passed)
+//   0x6C  COMMIT_TIME_LO  [31:0] of the commit sample timestamp
+//   0x70  COMMIT_TIME_HI  [63:32] of the commit sample timestamp
+//   0x74  SAMPLE_CNT_LO   [RO] engine samples since reset, [31:0]; reading
+//                         it latches [63:32] for the next SAMPLE_CNT_HI read
+//   0x78  SAMPLE_CNT_HI   [RO] latched [63:32]
+//   0x7C  SYNC_CFG    [17:16]=sync_cfg_b, [1:0]=sync_cfg_a (immediate)
+//                     per channel: [0]=act on the next sync_in edge (cleared
+//                     when it does), [1]=act on every edge. Acting releases
+//                     an armed channel, or restarts a running one at phase 0
+//   0x80-0xBC         [RO] counter snapshot (see PerfCounters):
+//     0x80/0x84 clock count, 0x88/0x8C samples A, 0x90/0x94 samples B,
+//     0x98/0x9C clocks since trigger A, 0xA0/0xA4 clocks since trigger B
+//     (64-bit, lo/hi), 0xA8 cycles A, 0xAC cycles B, 0xB0 DAC frames,
+//     0xB4 underflows, 0xB8 overruns, 0xBC reconfig applies
+//   0xC0  SYNC_CTRL   Write: [0]=emit one sync_out pulse. R/W: [1]=loopback
+//                     (sync_out also drives the local sync input),
+//                     [2]=clear SAMPLE_CNT on every sync_in edge
+//   0xC4  SYNC_PERIOD [31:0]=emit sync_out every N engine samples (0 = off)
+//   0xC8  NOISE_CFG   [16]=gaussian_b, [0]=gaussian_a (0 = uniform)
+//   0xCC  NOISE_SEED_A [31:0]=noise seed A, loaded whenever A (re)starts
+//   0xD0  NOISE_SEED_B [31:0]=noise seed B
+//   0xD4  ARB_CFG     [16]=interp_b, [0]=interp_a (linear interpolation
+//                     between adjacent ARB samples), [9:8]=ARB memory
+//                     format for both channels (0 = 16-bit samples,
+//                     1 = 8-bit delta, 2 = 4-bit delta; see WaveForms)
+//   0xD8  CAP_CTRL    Write: [0]=arm capture, [1]=software trigger.
+//                     R/W: [2]=source (0 = engine waveform, 1 = output),
+//                     [5:4]=trigger (0 = software, 1 = channel A trigger,
+//                     2 = ext_trigger rising edge, 3 = sync event)
+//   0xDC  CAP_CFG     [31:16]=decimation (keep 1 of N+1), [15:0]=pre-trigger
+//                     samples
+//   0xE0  CAP_STATUS  [RO] [31:16]=CAPTURE_DEPTH, [2]=done, [1]=triggered,
+//                     [0]=waiting for trigger
 ////////////////////////////////////
 
 module wavegen_v1_0_S00_AXI #(
-    parameter integer C_S_AXI_ADDR_WIDTH = 14,
+    parameter integer C_S_AXI_ADDR_WIDTH = 16,
     parameter integer SAMPLING_FREQUENCY = 50000,
-    parameter integer ARB_WAVEFORM_DEPTH = 1024
+    parameter integer ARB_WAVEFORM_DEPTH = 1024,
+    parameter integer INTERP_STAGES = 0,
+    parameter integer SINE_LUT_ADDR_WIDTH = 9,
+    parameter integer SINE_LUT_DATA_WIDTH = 16,
+    parameter         SINE_LUT_FILE = "coe/sin_LUT.hex",
+    parameter integer SINE_CORDIC = 0,          // 1 = CORDIC instead of the LUT
+    parameter integer CORDIC_ITERATIONS = 16,
+    parameter integer CORDIC_WIDTH = 16,
+    parameter integer NUM_PROFILES = 8,         // 1-16 profile banks
+    parameter integer CAPTURE_DEPTH = 1024      // Power of two, up to 4096
 )(
     // Ports to top level module (what makes this the Wavegen IP module)
     input sample_clk,
     input lut_clk,
+    input ext_trigger,
+    input [3:0] profile_sel,    // External profile select (asynchronous)
+    input sync_in,              // Multi-board sync input (asynchronous)
+    output sync_out,            // Multi-board sync output
     output signed [15:0] out_a,
     output signed [15:0] out_b,
     
@@ -73,23 +174,63 @@ module wavegen_v1_0_S00_AXI #(
 );
 
     // ========================================================================
-    // Register number definitions (address bits [5:2])
+    // Address regions (address bits [15:14])
     // ========================================================================
-    localparam integer MODE_REG       = 4'b0000; // 0x00
-    localparam integer RUN_REG        = 4'b0001; // 0x04
-    localparam integer FREQ_A_REG     = 4'b0010; // 0x08
-    localparam integer FREQ_B_REG     = 4'b0011; // 0x0C
-    localparam integer OFFSET_REG     = 4'b0100; // 0x10
-    localparam integer AMPLTD_REG     = 4'b0101; // 0x14
-    localparam integer DTCYC_REG      = 4'b0110; // 0x18
-    localparam integer CYCLES_REG     = 4'b0111; // 0x1C
-    localparam integer PHASE_OFF_REG  = 4'b1000; // 0x20
-    localparam integer ARB_DEPTH_REG  = 4'b1001; // 0x24
-    localparam integer ARB_DATA_REG   = 4'b1010; // 0x28
-    localparam integer RECONFIG_REG   = 4'b1011; // 0x2C
-    localparam integer STATUS_REG     = 4'b1100; // 0x30
-    localparam integer TRIGGER_REG    = 4'b1101; // 0x34
-    localparam integer SOFT_RESET_REG = 4'b1110; // 0x38
+    localparam [1:0] REG_REGION = 2'b00; // 0x0000: control registers
+    localparam [1:0] ARB_REGION = 2'b01; // 0x4000: ARB sample window
+    localparam [1:0] CAP_REGION = 2'b10; // 0x8000: capture window
+    localparam [1:0] PROF_REGION = 2'b11; // 0xC000: profile banks
+
+    // ========================================================================
+    // Register number definitions (address bits [9:2])
+    // ========================================================================
+    localparam [7:0] MODE_REG       = 8'h00; // 0x00
+    localparam [7:0] RUN_REG        = 8'h01; // 0x04
+    localparam [7:0] FREQ_A_REG     = 8'h02; // 0x08
+    localparam [7:0] FREQ_B_REG     = 8'h03; // 0x0C
+    localparam [7:0] OFFSET_REG     = 8'h04; // 0x10
+    localparam [7:0] AMPLTD_REG     = 8'h05; // 0x14
+    localparam [7:0] DTCYC_REG      = 8'h06; // 0x18
+    localparam [7:0] CYCLES_REG     = 8'h07; // 0x1C
+    localparam [7:0] PHASE_OFF_REG  = 8'h08; // 0x20
+    localparam [7:0] ARB_DEPTH_REG  = 8'h09; // 0x24
+    localparam [7:0] RECONFIG_REG   = 8'h0B; // 0x2C
+    localparam [7:0] STATUS_REG     = 8'h0C; // 0x30
+    localparam [7:0] TRIGGER_REG    = 8'h0D; // 0x34
+    localparam [7:0] SOFT_RESET_REG = 8'h0E; // 0x38
+    localparam [7:0] TRIG_CFG_REG   = 8'h0F; // 0x3C
+    localparam [7:0] TRIG_LAT_A_REG = 8'h10; // 0x40
+    localparam [7:0] TRIG_LAT_B_REG = 8'h11; // 0x44
+    localparam [7:0] MOD_CFG_REG    = 8'h12; // 0x48
+    localparam [7:0] MOD_DEPTH_REG  = 8'h13; // 0x4C
+    localparam [7:0] MOD_FREQ_A_REG = 8'h14; // 0x50
+    localparam [7:0] MOD_FREQ_B_REG = 8'h15; // 0x54
+    localparam [7:0] MOD_DEV_A_REG  = 8'h16; // 0x58
+    localparam [7:0] MOD_DEV_B_REG  = 8'h17; // 0x5C
+    localparam [7:0] CNT_CTRL_REG   = 8'h18; // 0x60
+    localparam [7:0] PROFILE_SEL_REG = 8'h19; // 0x64
+    localparam [7:0] COMMIT_CTRL_REG = 8'h1A; // 0x68
+    localparam [7:0] COMMIT_TIME_LO_REG = 8'h1B; // 0x6C
+    localparam [7:0] COMMIT_TIME_HI_REG = 8'h1C; // 0x70
+    localparam [7:0] SAMPLE_CNT_LO_REG = 8'h1D; // 0x74
+    localparam [7:0] SAMPLE_CNT_HI_REG = 8'h1E; // 0x78
+    localparam [7:0] SYNC_CFG_REG   = 8'h1F; // 0x7C
+    localparam [7:0] SYNC_CTRL_REG  = 8'h30; // 0xC0
+    localparam [7:0] SYNC_PERIOD_REG = 8'h31; // 0xC4
+    localparam [7:0] NOISE_CFG_REG  = 8'h32; // 0xC8
+    localparam [7:0] NOISE_SEED_A_REG = 8'h33; // 0xCC
+    localparam [7:0] NOISE_SEED_B_REG = 8'h34; // 0xD0
+    localparam [7:0] ARB_CFG_REG    = 8'h35; // 0xD4
+    localparam [7:0] CAP_CTRL_REG   = 8'h36; // 0xD8
+    localparam [7:0] CAP_CFG_REG    = 8'h37; // 0xDC
+    localparam [7:0] CAP_STATUS_REG = 8'h38; // 0xE0
+
+    // COMMIT_CTRL modes
+    localparam [1:0] COMMIT_NONE   = 2'd0;
+    localparam [1:0] COMMIT_AT     = 2'd1;
+    localparam [1:0] COMMIT_WRAP_A = 2'd2;
+    localparam [1:0] COMMIT_WRAP_B = 2'd3;
+    localparam [3:0]   CNT_BLOCK      = 4'h2;  // 0x80-0xBC (bits [9:6])
 
     // ========================================================================
     // Active registers (directly drive the waveform generator)
@@ -103,6 +244,15 @@ module wavegen_v1_0_S00_AXI #(
     reg [15:0] cycles_a, cycles_b;
     reg signed [15:0] phase_off_a, phase_off_b;
     reg [31:0] arb_waveform_depth;
+    reg [7:0] trig_cfg_a, trig_cfg_b;
+    reg [7:0] mod_cfg_a, mod_cfg_b;
+    reg [15:0] mod_depth_a, mod_depth_b;
+    reg [31:0] mod_freq_a, mod_freq_b;
+    reg [31:0] mod_dev_a, mod_dev_b;
+    reg noise_gauss_a, noise_gauss_b;
+    reg [31:0] noise_seed_a, noise_seed_b;
+    reg arb_interp_a, arb_interp_b;
+    reg [1:0] arb_format;
 
     // ARB waveform write interface (memory is inside WaveForms module)
     reg arb_wr_en;
@@ -121,6 +271,79 @@ module wavegen_v1_0_S00_AXI #(
     reg [15:0] shadow_cycles_a, shadow_cycles_b;
     reg signed [15:0] shadow_phase_off_a, shadow_phase_off_b;
     reg [31:0] shadow_arb_waveform_depth;
+    reg [7:0] shadow_trig_cfg_a, shadow_trig_cfg_b;
+    reg [7:0] shadow_mod_cfg_a, shadow_mod_cfg_b;
+    reg [15:0] shadow_mod_depth_a, shadow_mod_depth_b;
+    reg [31:0] shadow_mod_freq_a, shadow_mod_freq_b;
+    reg [31:0] shadow_mod_dev_a, shadow_mod_dev_b;
+    reg shadow_noise_gauss_a, shadow_noise_gauss_b;
+    reg [31:0] shadow_noise_seed_a, shadow_noise_seed_b;
+    reg shadow_arb_interp_a, shadow_arb_interp_b;
+    reg [1:0] shadow_arb_format;
+
+    // ========================================================================
+    // Profile banks (written through the 0xC000 window)
+    // ========================================================================
+    reg [7:0]  prof_mode   [0:NUM_PROFILES-1];  // {mode_b, mode_a}
+    reg [31:0] prof_freq_a [0:NUM_PROFILES-1];
+    reg [31:0] prof_freq_b [0:NUM_PROFILES-1];
+    reg [31:0] prof_offset [0:NUM_PROFILES-1];  // {b, a} as in the registers
+    reg [31:0] prof_amp    [0:NUM_PROFILES-1];
+    reg [31:0] prof_dtcyc  [0:NUM_PROFILES-1];
+    reg [31:0] prof_cycles [0:NUM_PROFILES-1];
+    reg [31:0] prof_phase  [0:NUM_PROFILES-1];
+
+    integer prof_init;
+    initial begin
+        for (prof_init = 0; prof_init < NUM_PROFILES; prof_init = prof_init + 1) begin
+            prof_mode[prof_init]   = 8'h00;
+            prof_freq_a[prof_init] = 32'd0;
+            prof_freq_b[prof_init] = 32'd0;
+            prof_offset[prof_init] = 32'd0;
+            prof_amp[prof_init]    = 32'h7FFF7FFF;
+            prof_dtcyc[prof_init]  = 32'h80008000;
+            prof_cycles[prof_init] = 32'd0;
+            prof_phase[prof_init]  = 32'd0;
+        end
+    end
+
+    localparam [7:0] PROFILE_COUNT = NUM_PROFILES[7:0];
+
+    reg [3:0] profile_active;       // Last applied profile
+    reg profile_pins;               // Pins select the profile
+    reg profile_go;                 // PROFILE_SEL write: apply profile_go_idx
+    reg [3:0] profile_go_idx;
+
+    // ========================================================================
+    // Timed commit
+    // ========================================================================
+    reg [1:0]  commit_mode;         // Pending COMMIT_* (cleared when applied)
+    reg [63:0] commit_time;
+    reg        commit_late;
+    reg [63:0] sample_cnt;          // Engine samples since reset
+    reg [31:0] sample_cnt_hi_latch;
+
+    // ========================================================================
+    // Multi-board sync (immediate, not shadowed)
+    // ========================================================================
+    reg [1:0]  sync_cfg_a, sync_cfg_b;
+    reg        sync_fire;
+    reg        sync_loopback;
+    reg        sync_cnt_reset;      // SAMPLE_CNT restarts on each sync edge
+    reg [31:0] sync_period;
+    wire       sync_event;
+    wire       sync_hit_a, sync_hit_b;
+
+    // ========================================================================
+    // Output capture (immediate, not shadowed)
+    // ========================================================================
+    reg        cap_arm, cap_trigger;
+    reg        cap_source;          // 0 = engine waveform, 1 = scaled output
+    reg [1:0]  cap_trig_src;
+    reg [15:0] cap_pre, cap_decimation;
+    wire       cap_waiting, cap_triggered, cap_done;
+    wire [31:0] cap_rd_data;
+    localparam [15:0] CAPTURE_COUNT = CAPTURE_DEPTH[15:0];
 
     // ========================================================================
     // Control signals
@@ -128,6 +351,10 @@ module wavegen_v1_0_S00_AXI #(
     reg reconfig_pending;
     reg trigger_a, trigger_b;
     reg soft_reset_a, soft_reset_b;
+    reg cnt_snapshot, cnt_clear;
+    reg reconfig_applied;
+    wire armed_a, armed_b;
+    wire [31:0] trig_latency_a, trig_latency_b;
 
     // ========================================================================
     // AXI4-Lite interface signals
@@ -167,21 +394,55 @@ module wavegen_v1_0_S00_AXI #(
     // ========================================================================
     wire signed [15:0] wave_a_value;
     wire signed [15:0] wave_b_value;
+    wire signed [15:0] engine_a_value;
+    wire signed [15:0] engine_b_value;
+    wire engine_clk;
+    wire interp_underflow, interp_overrun;
+    wire trig_fired_a, trig_fired_b;
+    wire active_a, active_b;
+    wire cycle_tog_a, cycle_tog_b;
     
+    // 16 x 16 products, sign-extended to their 32-bit result as intended
+    /* verilator lint_off WIDTHEXPAND */
     wire signed [31:0] temp_a = $signed(amp_a) * wave_a_value;
     wire signed [31:0] temp_b = $signed(amp_b) * wave_b_value;
+    /* verilator lint_on WIDTHEXPAND */
     
-    assign out_a = enable_a ? ((temp_a >>> 15) + offset_a) : 16'sd0;
-    assign out_b = enable_b ? ((temp_b >>> 15) + offset_b) : 16'sd0;
+    assign out_a = enable_a ? ($signed(temp_a[30:15]) + offset_a) : 16'sd0;
+    assign out_b = enable_b ? ($signed(temp_b[30:15]) + offset_b) : 16'sd0;
+
+    // ========================================================================
+    // Interpolation (bypassed when INTERP_STAGES = 0)
+    // ========================================================================
+    Interpolator #(
+        .STAGES(INTERP_STAGES)
+    ) interp (
+        .clk(lut_clk),
+        .rst(~axi_resetn),
+        .sample_clk(sample_clk),
+        .engine_clk(engine_clk),
+        .in_a(engine_a_value),
+        .in_b(engine_b_value),
+        .out_a(wave_a_value),
+        .out_b(wave_b_value),
+        .underflow(interp_underflow),
+        .overrun(interp_overrun)
+    );
 
     // ========================================================================
     // WaveForms instantiation
     // ========================================================================
     WaveForms #(
-        .SAMPLING_FREQUENCY(SAMPLING_FREQUENCY),
-        .ARB_WAVEFORM_DEPTH(ARB_WAVEFORM_DEPTH)
+        .SAMPLING_FREQUENCY(SAMPLING_FREQUENCY >> INTERP_STAGES),
+        .ARB_WAVEFORM_DEPTH(ARB_WAVEFORM_DEPTH),
+        .SINE_LUT_ADDR_WIDTH(SINE_LUT_ADDR_WIDTH),
+        .SINE_LUT_DATA_WIDTH(SINE_LUT_DATA_WIDTH),
+        .SINE_LUT_FILE(SINE_LUT_FILE),
+        .SINE_CORDIC(SINE_CORDIC),
+        .CORDIC_ITERATIONS(CORDIC_ITERATIONS),
+        .CORDIC_WIDTH(CORDIC_WIDTH)
     ) waves (
-        .clk(sample_clk),
+        .clk(engine_clk),
         .lut_clk(lut_clk),
         .rst_a(soft_reset_a),
         .rst_b(soft_reset_b),
@@ -189,6 +450,9 @@ module wavegen_v1_0_S00_AXI #(
         .enb(enable_b),
         .trigger_a(trigger_a),
         .trigger_b(trigger_b),
+        .ext_trigger(ext_trigger),
+        .trig_cfg_a(trig_cfg_a),
+        .trig_cfg_b(trig_cfg_b),
         .mode_a(mode_a),
         .mode_b(mode_b),
         .freq_a(freq_a),
@@ -200,12 +464,47 @@ module wavegen_v1_0_S00_AXI #(
         .cycles_a(cycles_a),
         .cycles_b(cycles_b),
         .arb_waveform_depth(arb_waveform_depth),
+        .mod_cfg_a(mod_cfg_a),
+        .mod_cfg_b(mod_cfg_b),
+        .mod_depth_a(mod_depth_a),
+        .mod_depth_b(mod_depth_b),
+        .mod_freq_a(mod_freq_a),
+        .mod_freq_b(mod_freq_b),
+        .mod_dev_a(mod_dev_a),
+        .mod_dev_b(mod_dev_b),
+        .noise_gauss_a(noise_gauss_a),
+        .noise_gauss_b(noise_gauss_b),
+        .noise_seed_a(noise_seed_a),
+        .noise_seed_b(noise_seed_b),
+        .arb_interp_a(arb_interp_a),
+        .arb_interp_b(arb_interp_b),
+        .arb_format(arb_format),
+        .sync_in(sync_in),
+        .sync_out(sync_out),
+        .sync_fire(sync_fire),
+        .sync_loopback(sync_loopback),
+        .sync_period(sync_period),
+        .sync_cfg_a(sync_cfg_a),
+        .sync_cfg_b(sync_cfg_b),
+        .sync_hit_a(sync_hit_a),
+        .sync_hit_b(sync_hit_b),
+        .sync_event(sync_event),
         .arb_wr_clk(axi_clk),
         .arb_wr_en(arb_wr_en),
         .arb_wr_addr(arb_wr_addr),
         .arb_wr_data(arb_wr_data),
-        .wave_a(wave_a_value),
-        .wave_b(wave_b_value)
+        .wave_a(engine_a_value),
+        .wave_b(engine_b_value),
+        .armed_a(armed_a),
+        .armed_b(armed_b),
+        .trig_latency_a(trig_latency_a),
+        .trig_latency_b(trig_latency_b),
+        .trig_fired_a(trig_fired_a),
+        .trig_fired_b(trig_fired_b),
+        .active_a(active_a),
+        .active_b(active_b),
+        .cycle_tog_a(cycle_tog_a),
+        .cycle_tog_b(cycle_tog_b)
     );
 
     // ========================================================================
@@ -260,6 +559,86 @@ module wavegen_v1_0_S00_AXI #(
     wire wr = wr_add_data_valid && axi_awready && axi_wready;
     integer byte_index;
     integer arb_idx;
+
+    // ========================================================================
+    // Profile bank writes (no reset, so the banks map to distributed RAM)
+    //
+    // Bank indices are 4 bits wide for up to 16 banks. Each one is checked
+    // against PROFILE_COUNT before it is used, so with fewer banks the
+    // bits above the array's index range are zero; the index width
+    // warnings are waived where the banks are addressed.
+    // ========================================================================
+    wire [3:0] prof_wr_idx = waddr[9:6];
+
+    /* verilator lint_off WIDTHTRUNC */
+    always @(posedge axi_clk) begin
+        if (wr && waddr[15:14] == PROF_REGION && {4'd0, prof_wr_idx} < PROFILE_COUNT) begin
+            case (waddr[5:2])
+                4'h0: prof_mode[prof_wr_idx]   <= s_axi_wdata[7:0];
+                4'h2: prof_freq_a[prof_wr_idx] <= s_axi_wdata;
+                4'h3: prof_freq_b[prof_wr_idx] <= s_axi_wdata;
+                4'h4: prof_offset[prof_wr_idx] <= s_axi_wdata;
+                4'h5: prof_amp[prof_wr_idx]    <= s_axi_wdata;
+                4'h6: prof_dtcyc[prof_wr_idx]  <= s_axi_wdata;
+                4'h7: prof_cycles[prof_wr_idx] <= s_axi_wdata;
+                4'h8: prof_phase[prof_wr_idx]  <= s_axi_wdata;
+                default: ;
+            endcase
+        end
+    end
+    /* verilator lint_on WIDTHTRUNC */
+
+    // ========================================================================
+    // Profile select pins: 2-FF synchronizer, then apply a value once it has
+    // been stable for two cycles and differs from the last one applied
+    // (re-applied whenever pin select is switched on)
+    // ========================================================================
+    reg [3:0] pin_sync1 = 4'd0, pin_sync2 = 4'd0, pin_sync3 = 4'd0;
+    reg [3:0] pin_idx = 4'd0;
+    reg pin_valid = 1'b0;
+    reg pin_go = 1'b0;
+
+    always @(posedge axi_clk) begin
+        pin_sync1 <= profile_sel;
+        pin_sync2 <= pin_sync1;
+        pin_sync3 <= pin_sync2;
+        pin_go <= 1'b0;
+        if (axi_resetn == 1'b0 || !profile_pins) begin
+            pin_valid <= 1'b0;
+        end else if (pin_sync2 == pin_sync3 && {4'd0, pin_sync3} < PROFILE_COUNT &&
+                     (!pin_valid || pin_sync3 != pin_idx)) begin
+            pin_idx <= pin_sync3;
+            pin_valid <= 1'b1;
+            pin_go <= 1'b1;
+        end
+    end
+
+    // ========================================================================
+    // Engine sample counter and phase wrap events, in the axi_clk domain.
+    // engine_clk and the cycle toggles change at the (much slower) engine
+    // rate, so the synchronized edges land well before the next sample.
+    // ========================================================================
+    reg [2:0] engine_sync = 3'b000;
+    reg [2:0] wrap_a_sync = 3'b000, wrap_b_sync = 3'b000;
+
+    always @(posedge axi_clk) begin
+        engine_sync <= {engine_sync[1:0], engine_clk};
+        wrap_a_sync <= {wrap_a_sync[1:0], cycle_tog_a};
+        wrap_b_sync <= {wrap_b_sync[1:0], cycle_tog_b};
+        if (axi_resetn == 1'b0 || (sync_event && sync_cnt_reset))
+            sample_cnt <= 64'd0;
+        else if (engine_sync[1] && !engine_sync[2])
+            sample_cnt <= sample_cnt + 64'd1;
+    end
+
+    wire wrap_a = wrap_a_sync[1] ^ wrap_a_sync[2];
+    wire wrap_b = wrap_b_sync[1] ^ wrap_b_sync[2];
+    wire commit_due = (commit_mode == COMMIT_AT     && sample_cnt >= commit_time) ||
+                      (commit_mode == COMMIT_WRAP_A && wrap_a) ||
+                      (commit_mode == COMMIT_WRAP_B && wrap_b);
+
+    wire profile_apply = profile_go | pin_go;
+    wire [3:0] apply_idx = profile_go ? profile_go_idx : pin_idx;
     
     always @(posedge axi_clk) begin
         if (axi_resetn == 1'b0) begin
@@ -281,6 +660,23 @@ module wavegen_v1_0_S00_AXI #(
             shadow_phase_off_a <= 16'sb0;
             shadow_phase_off_b <= 16'sb0;
             shadow_arb_waveform_depth <= 32'd1024;
+            shadow_trig_cfg_a <= 8'b0;  // Free-running (not armed)
+            shadow_trig_cfg_b <= 8'b0;
+            shadow_mod_cfg_a <= 8'b0;   // Modulation off
+            shadow_mod_cfg_b <= 8'b0;
+            shadow_mod_depth_a <= 16'b0;
+            shadow_mod_depth_b <= 16'b0;
+            shadow_mod_freq_a <= 32'b0;
+            shadow_mod_freq_b <= 32'b0;
+            shadow_mod_dev_a <= 32'b0;
+            shadow_mod_dev_b <= 32'b0;
+            shadow_noise_gauss_a <= 1'b0;   // Uniform noise
+            shadow_noise_gauss_b <= 1'b0;
+            shadow_noise_seed_a <= 32'h2545F491;  // Distinct per channel
+            shadow_noise_seed_b <= 32'h6C078965;
+            shadow_arb_interp_a <= 1'b0;
+            shadow_arb_interp_b <= 1'b0;
+            shadow_arb_format <= 2'b0;  // Plain 16-bit samples
             
             // Reset active registers
             mode_a <= 4'b0;
@@ -300,6 +696,23 @@ module wavegen_v1_0_S00_AXI #(
             phase_off_a <= 16'sb0;
             phase_off_b <= 16'sb0;
             arb_waveform_depth <= 32'd1024;
+            trig_cfg_a <= 8'b0;
+            trig_cfg_b <= 8'b0;
+            mod_cfg_a <= 8'b0;
+            mod_cfg_b <= 8'b0;
+            mod_depth_a <= 16'b0;
+            mod_depth_b <= 16'b0;
+            mod_freq_a <= 32'b0;
+            mod_freq_b <= 32'b0;
+            mod_dev_a <= 32'b0;
+            mod_dev_b <= 32'b0;
+            noise_gauss_a <= 1'b0;
+            noise_gauss_b <= 1'b0;
+            noise_seed_a <= 32'h2545F491;
+            noise_seed_b <= 32'h6C078965;
+            arb_interp_a <= 1'b0;
+            arb_interp_b <= 1'b0;
+            arb_format <= 2'b0;
             
             // Reset control signals
             reconfig_pending <= 1'b0;
@@ -307,16 +720,51 @@ module wavegen_v1_0_S00_AXI #(
             trigger_b <= 1'b0;
             soft_reset_a <= 1'b0;
             soft_reset_b <= 1'b0;
+            cnt_snapshot <= 1'b0;
+            cnt_clear <= 1'b0;
+            reconfig_applied <= 1'b0;
             arb_wr_en <= 1'b0;
             arb_wr_addr <= 0;
             arb_wr_data <= 16'b0;
+            profile_active <= 4'd0;
+            profile_pins <= 1'b0;
+            profile_go <= 1'b0;
+            profile_go_idx <= 4'd0;
+            commit_mode <= COMMIT_NONE;
+            commit_time <= 64'd0;
+            commit_late <= 1'b0;
+            sync_cfg_a <= 2'b0;
+            sync_cfg_b <= 2'b0;
+            sync_fire <= 1'b0;
+            sync_loopback <= 1'b0;
+            sync_cnt_reset <= 1'b0;
+            sync_period <= 32'd0;
+            cap_arm <= 1'b0;
+            cap_trigger <= 1'b0;
+            cap_source <= 1'b1;
+            cap_trig_src <= 2'd0;
+            cap_pre <= 16'd0;
+            cap_decimation <= 16'd0;
         end else begin
             // Auto-clear single-cycle pulse signals
             trigger_a <= 1'b0;
             trigger_b <= 1'b0;
             soft_reset_a <= 1'b0;
             soft_reset_b <= 1'b0;
+            cnt_snapshot <= 1'b0;
+            cnt_clear <= 1'b0;
+            reconfig_applied <= 1'b0;
             arb_wr_en <= 1'b0;  // Default: no write
+            profile_go <= 1'b0;
+            sync_fire <= 1'b0;
+            cap_arm <= 1'b0;
+            cap_trigger <= 1'b0;
+
+            // One-shot sync ARM is consumed by the edge it acted on
+            if (sync_hit_a)
+                sync_cfg_a[0] <= 1'b0;
+            if (sync_hit_b)
+                sync_cfg_b[0] <= 1'b0;
             
             // Apply shadow registers to active on reconfig
             if (reconfig_pending) begin
@@ -337,11 +785,68 @@ module wavegen_v1_0_S00_AXI #(
                 phase_off_a <= shadow_phase_off_a;
                 phase_off_b <= shadow_phase_off_b;
                 arb_waveform_depth <= shadow_arb_waveform_depth;
+                trig_cfg_a <= shadow_trig_cfg_a;
+                trig_cfg_b <= shadow_trig_cfg_b;
+                mod_cfg_a <= shadow_mod_cfg_a;
+                mod_cfg_b <= shadow_mod_cfg_b;
+                mod_depth_a <= shadow_mod_depth_a;
+                mod_depth_b <= shadow_mod_depth_b;
+                mod_freq_a <= shadow_mod_freq_a;
+                mod_freq_b <= shadow_mod_freq_b;
+                mod_dev_a <= shadow_mod_dev_a;
+                mod_dev_b <= shadow_mod_dev_b;
+                noise_gauss_a <= shadow_noise_gauss_a;
+                noise_gauss_b <= shadow_noise_gauss_b;
+                noise_seed_a <= shadow_noise_seed_a;
+                noise_seed_b <= shadow_noise_seed_b;
+                arb_interp_a <= shadow_arb_interp_a;
+                arb_interp_b <= shadow_arb_interp_b;
+                arb_format <= shadow_arb_format;
                 reconfig_pending <= 1'b0;
+                reconfig_applied <= 1'b1;
+            end
+
+            // Timed commit: raise the same apply as a RECONFIG write. The
+            // copy lands a few cycles after the sample edge that made the
+            // commit due, long before the next engine sample.
+            if (commit_due) begin
+                reconfig_pending <= 1'b1;
+                commit_late <= (commit_mode == COMMIT_AT) && (sample_cnt != commit_time);
+                commit_mode <= COMMIT_NONE;
+            end
+
+            // Apply a profile to shadow and active registers together, so
+            // a later RECONFIG keeps it (after the RECONFIG copy: wins)
+            /* verilator lint_off WIDTHTRUNC */
+            if (profile_apply) begin
+                {mode_b, mode_a} <= prof_mode[apply_idx];
+                {shadow_mode_b, shadow_mode_a} <= prof_mode[apply_idx];
+                freq_a <= prof_freq_a[apply_idx];
+                freq_b <= prof_freq_b[apply_idx];
+                shadow_freq_a <= prof_freq_a[apply_idx];
+                shadow_freq_b <= prof_freq_b[apply_idx];
+                {offset_b, offset_a} <= prof_offset[apply_idx];
+                {shadow_offset_b, shadow_offset_a} <= prof_offset[apply_idx];
+                {amp_b, amp_a} <= prof_amp[apply_idx];
+                {shadow_amp_b, shadow_amp_a} <= prof_amp[apply_idx];
+                {dtcyc_b, dtcyc_a} <= prof_dtcyc[apply_idx];
+                {shadow_dtcyc_b, shadow_dtcyc_a} <= prof_dtcyc[apply_idx];
+                {cycles_b, cycles_a} <= prof_cycles[apply_idx];
+                {shadow_cycles_b, shadow_cycles_a} <= prof_cycles[apply_idx];
+                {phase_off_b, phase_off_a} <= prof_phase[apply_idx];
+                {shadow_phase_off_b, shadow_phase_off_a} <= prof_phase[apply_idx];
+                profile_active <= apply_idx;
+                reconfig_applied <= 1'b1;
             end
+            /* verilator lint_on WIDTHTRUNC */
             
-            if (wr) begin
-                case (waddr[5:2])
+            if (wr && waddr[15:14] == ARB_REGION) begin
+                // ARB window: drive write interface to WaveForms module
+                arb_wr_en   <= 1'b1;
+                arb_wr_addr <= waddr[$clog2(ARB_WAVEFORM_DEPTH)+1:2];
+                arb_wr_data <= s_axi_wdata[15:0];
+            end else if (wr && waddr[15:14] == REG_REGION) begin
+                case (waddr[9:2])
                     MODE_REG:
                         if (axi_wstrb[0] == 1) begin
                             shadow_mode_a <= s_axi_wdata[3:0];
@@ -415,12 +920,6 @@ module wavegen_v1_0_S00_AXI #(
                         for (byte_index = 0; byte_index <= 3; byte_index = byte_index + 1)
                             if (axi_wstrb[byte_index] == 1)
                                 shadow_arb_waveform_depth[(byte_index * 8) +: 8] <= s_axi_wdata[(byte_index * 8) +: 8];
-                    ARB_DATA_REG: begin
-                        // ARB data: drive write interface to WaveForms module
-                        arb_wr_en   <= 1'b1;
-                        arb_wr_addr <= waddr[$clog2(ARB_WAVEFORM_DEPTH)+1:2];
-                        arb_wr_data <= s_axi_wdata[15:0];
-                    end
                     RECONFIG_REG:
                         reconfig_pending <= 1'b1;
                     TRIGGER_REG: begin
@@ -431,6 +930,108 @@ module wavegen_v1_0_S00_AXI #(
                         soft_reset_a <= s_axi_wdata[0];
                         soft_reset_b <= s_axi_wdata[1];
                     end
+                    CNT_CTRL_REG: begin
+                        cnt_snapshot <= s_axi_wdata[0];
+                        cnt_clear <= s_axi_wdata[1];
+                    end
+                    COMMIT_CTRL_REG: begin
+                        commit_mode <= s_axi_wdata[1:0];
+                        commit_late <= 1'b0;
+                    end
+                    COMMIT_TIME_LO_REG:
+                        commit_time[31:0] <= s_axi_wdata;
+                    COMMIT_TIME_HI_REG:
+                        commit_time[63:32] <= s_axi_wdata;
+                    SYNC_CFG_REG: begin
+                        if (axi_wstrb[0] == 1)
+                            sync_cfg_a <= s_axi_wdata[1:0];
+                        if (axi_wstrb[2] == 1)
+                            sync_cfg_b <= s_axi_wdata[17:16];
+                    end
+                    SYNC_CTRL_REG: begin
+                        sync_fire <= s_axi_wdata[0];
+                        sync_loopback <= s_axi_wdata[1];
+                        sync_cnt_reset <= s_axi_wdata[2];
+                    end
+                    SYNC_PERIOD_REG:
+                        sync_period <= s_axi_wdata;
+                    CAP_CTRL_REG: begin
+                        cap_arm <= s_axi_wdata[0];
+                        cap_trigger <= s_axi_wdata[1];
+                        cap_source <= s_axi_wdata[2];
+                        cap_trig_src <= s_axi_wdata[5:4];
+                    end
+                    CAP_CFG_REG: begin
+                        cap_pre <= s_axi_wdata[15:0];
+                        cap_decimation <= s_axi_wdata[31:16];
+                    end
+                    PROFILE_SEL_REG: begin
+                        profile_pins <= s_axi_wdata[8];
+                        if (!s_axi_wdata[8] && {4'd0, s_axi_wdata[3:0]} < PROFILE_COUNT) begin
+                            profile_go <= 1'b1;
+                            profile_go_idx <= s_axi_wdata[3:0];
+                        end
+                    end
+                    TRIG_CFG_REG: begin
+                        if (axi_wstrb[0] == 1)
+                            shadow_trig_cfg_a <= s_axi_wdata[7:0];
+                        if (axi_wstrb[2] == 1)
+                            shadow_trig_cfg_b <= s_axi_wdata[23:16];
+                    end
+                    MOD_CFG_REG: begin
+                        if (axi_wstrb[0] == 1)
+                            shadow_mod_cfg_a <= s_axi_wdata[7:0];
+                        if (axi_wstrb[2] == 1)
+                            shadow_mod_cfg_b <= s_axi_wdata[23:16];
+                    end
+                    MOD_DEPTH_REG:
+                    begin
+                        for (byte_index = 0; byte_index <= 1; byte_index = byte_index + 1)
+                            if (axi_wstrb[byte_index] == 1)
+                                shadow_mod_depth_a[(byte_index * 8) +: 8] <= s_axi_wdata[(byte_index * 8) +: 8];
+
+                        for (byte_index = 2; byte_index <= 3; byte_index = byte_index + 1)
+                            if (axi_wstrb[byte_index] == 1)
+                                shadow_mod_depth_b[((byte_index - 2) * 8) +: 8] <= s_axi_wdata[(byte_index * 8) +: 8];
+                    end
+                    MOD_FREQ_A_REG:
+                        for (byte_index = 0; byte_index <= 3; byte_index = byte_index + 1)
+                            if (axi_wstrb[byte_index] == 1)
+                                shadow_mod_freq_a[(byte_index * 8) +: 8] <= s_axi_wdata[(byte_index * 8) +: 8];
+                    MOD_FREQ_B_REG:
+                        for (byte_index = 0; byte_index <= 3; byte_index = byte_index + 1)
+                            if (axi_wstrb[byte_index] == 1)
+                                shadow_mod_freq_b[(byte_index * 8) +: 8] <= s_axi_wdata[(byte_index * 8) +: 8];
+                    MOD_DEV_A_REG:
+                        for (byte_index = 0; byte_index <= 3; byte_index = byte_index + 1)
+                            if (axi_wstrb[byte_index] == 1)
+                                shadow_mod_dev_a[(byte_index * 8) +: 8] <= s_axi_wdata[(byte_index * 8) +: 8];
+                    MOD_DEV_B_REG:
+                        for (byte_index = 0; byte_index <= 3; byte_index = byte_index + 1)
+                            if (axi_wstrb[byte_index] == 1)
+                                shadow_mod_dev_b[(byte_index * 8) +: 8] <= s_axi_wdata[(byte_index * 8) +: 8];
+                    NOISE_CFG_REG: begin
+                        if (axi_wstrb[0] == 1)
+                            shadow_noise_gauss_a <= s_axi_wdata[0];
+                        if (axi_wstrb[2] == 1)
+                            shadow_noise_gauss_b <= s_axi_wdata[16];
+                    end
+                    NOISE_SEED_A_REG:
+                        for (byte_index = 0; byte_index <= 3; byte_index = byte_index + 1)
+                            if (axi_wstrb[byte_index] == 1)
+                                shadow_noise_seed_a[(byte_index * 8) +: 8] <= s_axi_wdata[(byte_index * 8) +: 8];
+                    NOISE_SEED_B_REG:
+                        for (byte_index = 0; byte_index <= 3; byte_index = byte_index + 1)
+                            if (axi_wstrb[byte_index] == 1)
+                                shadow_noise_seed_b[(byte_index * 8) +: 8] <= s_axi_wdata[(byte_index * 8) +: 8];
+                    ARB_CFG_REG: begin
+                        if (axi_wstrb[0] == 1)
+                            shadow_arb_interp_a <= s_axi_wdata[0];
+                        if (axi_wstrb[1] == 1)
+                            shadow_arb_format <= s_axi_wdata[9:8];
+                        if (axi_wstrb[2] == 1)
+                            shadow_arb_interp_b <= s_axi_wdata[16];
+                    end
                 endcase
             end
         end
@@ -472,16 +1073,102 @@ module wavegen_v1_0_S00_AXI #(
         end 
     end       
         
+    // ========================================================================
+    // Performance counters (read through the snapshot bank)
+    // ========================================================================
+    wire [31:0] perf_rd_data;
+
+    PerfCounters perf (
+        .clk(lut_clk),
+        .rst(~axi_resetn),
+        .snapshot(cnt_snapshot),
+        .clear(cnt_clear),
+        .engine_clk(engine_clk),
+        .sample_clk(sample_clk),
+        .active_a(active_a),
+        .active_b(active_b),
+        .cycle_tog_a(cycle_tog_a),
+        .cycle_tog_b(cycle_tog_b),
+        .trigger_a(trigger_a | trig_fired_a),
+        .trigger_b(trigger_b | trig_fired_b),
+        .underflow(interp_underflow),
+        .overrun(interp_overrun),
+        .reconfig(reconfig_applied),
+        .rd_index(raddr[5:2]),
+        .rd_data(perf_rd_data)
+    );
+
+    // ========================================================================
+    // Output capture (read port addressed at the read address handshake so
+    // the registered data is ready in the read data cycle)
+    // ========================================================================
+    localparam integer CAP_ADDR_BITS = $clog2(CAPTURE_DEPTH);
+
+    CaptureUnit #(
+        .DEPTH(CAPTURE_DEPTH)
+    ) capture (
+        .clk(lut_clk),
+        .rst(~axi_resetn),
+        .arm(cap_arm),
+        .sw_trigger(cap_trigger),
+        .source(cap_source),
+        .trig_src(cap_trig_src),
+        .pre(cap_pre),
+        .decimation(cap_decimation),
+        .engine_clk(engine_clk),
+        .engine_a(engine_a_value),
+        .engine_b(engine_b_value),
+        .sample_clk(sample_clk),
+        .out_a(out_a),
+        .out_b(out_b),
+        .trig_fired_a(trig_fired_a),
+        .ext_trigger(ext_trigger),
+        .sync_event(sync_event),
+        .waiting(cap_waiting),
+        .triggered(cap_triggered),
+        .done(cap_done),
+        .rd_index(s_axi_araddr[CAP_ADDR_BITS+1:2]),
+        .rd_data(cap_rd_data)
+    );
+
     // ========================================================================
     // Read data output
     // ========================================================================
+    wire [3:0] prof_rd_idx = raddr[9:6];
+    reg [31:0] prof_rdata;
+
+    /* verilator lint_off WIDTHTRUNC */
+    always @(*) begin
+        prof_rdata = 32'b0;
+        if ({4'd0, prof_rd_idx} < PROFILE_COUNT) begin
+            case (raddr[5:2])
+                4'h0: prof_rdata = {24'b0, prof_mode[prof_rd_idx]};
+                4'h2: prof_rdata = prof_freq_a[prof_rd_idx];
+                4'h3: prof_rdata = prof_freq_b[prof_rd_idx];
+                4'h4: prof_rdata = prof_offset[prof_rd_idx];
+                4'h5: prof_rdata = prof_amp[prof_rd_idx];
+                4'h6: prof_rdata = prof_dtcyc[prof_rd_idx];
+                4'h7: prof_rdata = prof_cycles[prof_rd_idx];
+                4'h8: prof_rdata = prof_phase[prof_rd_idx];
+                default: prof_rdata = 32'b0;
+            endcase
+        end
+    end
+    /* verilator lint_on WIDTHTRUNC */
+
     wire rd = axi_arvalid && axi_arready && ~axi_rvalid;
     always @(posedge axi_clk) begin
         if (axi_resetn == 1'b0) begin
             axi_rdata <= 32'b0;
         end else begin    
-            if (rd) begin
-                case (raddr[5:2])
+            if (rd && raddr[15:14] == PROF_REGION) begin
+                axi_rdata <= prof_rdata;
+            end else if (rd && raddr[15:14] == CAP_REGION) begin
+                axi_rdata <= cap_rd_data;
+            end else if (rd && raddr[15:14] != REG_REGION) begin
+                axi_rdata <= 32'b0;  // ARB window is write-only
+            end else if (rd) begin
+                case (raddr[9:2])
                     MODE_REG: 
                         axi_rdata <= {24'b0, mode_b, mode_a};
                     RUN_REG:
@@ -502,12 +1189,63 @@ module wavegen_v1_0_S00_AXI #(
                         axi_rdata <= {phase_off_b, phase_off_a};
                     ARB_DEPTH_REG:
                         axi_rdata <= arb_waveform_depth;
-                    ARB_DATA_REG:
-                        axi_rdata <= 32'b0;  // ARB data is write-only (memory inside WaveForms)
                     STATUS_REG:
-                        axi_rdata <= {28'b0, enable_b, enable_a, reconfig_pending, 1'b1};
+                        axi_rdata <= {26'b0, armed_b, armed_a,
+                                      enable_b, enable_a, reconfig_pending, 1'b1};
+                    TRIG_CFG_REG:
+                        axi_rdata <= {8'b0, trig_cfg_b, 8'b0, trig_cfg_a};
+                    TRIG_LAT_A_REG:
+                        axi_rdata <= trig_latency_a;
+                    TRIG_LAT_B_REG:
+                        axi_rdata <= trig_latency_b;
+                    MOD_CFG_REG:
+                        axi_rdata <= {8'b0, mod_cfg_b, 8'b0, mod_cfg_a};
+                    MOD_DEPTH_REG:
+                        axi_rdata <= {mod_depth_b, mod_depth_a};
+                    MOD_FREQ_A_REG:
+                        axi_rdata <= mod_freq_a;
+                    MOD_FREQ_B_REG:
+                        axi_rdata <= mod_freq_b;
+                    MOD_DEV_A_REG:
+                        axi_rdata <= mod_dev_a;
+                    MOD_DEV_B_REG:
+                        axi_rdata <= mod_dev_b;
+                    COMMIT_CTRL_REG:
+                        axi_rdata <= {27'b0, commit_late, 2'b0, commit_mode};
+                    COMMIT_TIME_LO_REG:
+                        axi_rdata <= commit_time[31:0];
+                    COMMIT_TIME_HI_REG:
+                        axi_rdata <= commit_time[63:32];
+                    SAMPLE_CNT_LO_REG: begin
+                        axi_rdata <= sample_cnt[31:0];
+                        sample_cnt_hi_latch <= sample_cnt[63:32];
+                    end
+                    SAMPLE_CNT_HI_REG:
+                        axi_rdata <= sample_cnt_hi_latch;
+                    SYNC_CFG_REG:
+                        axi_rdata <= {14'b0, sync_cfg_b, 14'b0, sync_cfg_a};
+                    SYNC_CTRL_REG:
+                        axi_rdata <= {29'b0, sync_cnt_reset, sync_loopback, 1'b0};
+                    SYNC_PERIOD_REG:
+                        axi_rdata <= sync_period;
+                    NOISE_CFG_REG:
+                        axi_rdata <= {15'b0, noise_gauss_b, 15'b0, noise_gauss_a};
+                    NOISE_SEED_A_REG:
+                        axi_rdata <= noise_seed_a;
+                    NOISE_SEED_B_REG:
+                        axi_rdata <= noise_seed_b;
+                    ARB_CFG_REG:
+                        axi_rdata <= {15'b0, arb_interp_b, 6'b0, arb_format, 7'b0, arb_interp_a};
+                    CAP_CTRL_REG:
+                        axi_rdata <= {26'b0, cap_trig_src, 1'b0, cap_source, 2'b0};
+                    CAP_CFG_REG:
+                        axi_rdata <= {cap_decimation, cap_pre};
+                    CAP_STATUS_REG:
+                        axi_rdata <= {CAPTURE_COUNT, 13'b0, cap_done, cap_triggered, cap_waiting};
+                    PROFILE_SEL_REG:
+                        axi_rdata <= {8'b0, PROFILE_COUNT, 7'b0, profile_pins, 4'b0, profile_active};
                     default:
-                        axi_rdata <= 32'b0;
+                        axi_rdata <= (raddr[9:6] == CNT_BLOCK) ? perf_rd_data : 32'b0;
                 endcase
             end   
         end
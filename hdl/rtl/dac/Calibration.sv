@@ -3,8 +3,8 @@
 //////////////////////////////////////////////////////////////////////////////
 // Module: voltsToDACWords
 //
-// Calibrates a signed 16-bit voltage value to a 12-bit DAC word using
-// a linear mapping between two calibration points:
+// Calibrates a signed 16-bit voltage value to an M-bit DAC word (12 bits
+// for the SPI DAC) using a linear mapping between two calibration points:
 //   - DAC_ZERO:        DAC code that produces 0V
 //   - DAC_TWOPOINTFIVE: DAC code that produces 2.5V
 //
@@ -15,7 +15,9 @@
 //   scale = (DAC_TWOPOINTFIVE - DAC_ZERO) * 2^16 / 25000
 //   calibrated = (scale * in) >>> 16 + DAC_ZERO
 //
-// This uses a single DSP multiply + shift instead of a divider.
+// This uses a single DSP multiply + shift instead of a divider. The
+// arithmetic is 64-bit so 16-bit DACs with a large code span do not
+// overflow; the results for narrower DACs are unchanged.
 //////////////////////////////////////////////////////////////////////////////
 
 module voltsToDACWords #(
@@ -31,16 +33,54 @@ module voltsToDACWords #(
     // Pre-computed scale factor (elaboration-time constant)
     // scale = (DAC_TWOPOINTFIVE - DAC_ZERO) * 65536 / 25000
     // For default values: (1 - 2048) * 65536 / 25000 = -5368 (approx)
-    localparam int SCALE_NUMER = (DAC_TWOPOINTFIVE - DAC_ZERO) * 65536;
-    localparam int SCALE = SCALE_NUMER / 25000;
+    localparam longint SCALE_NUMER = longint'(DAC_TWOPOINTFIVE - DAC_ZERO) * 65536;
+    localparam longint SCALE = SCALE_NUMER / 25000;
 
-    wire signed [31:0] product = SCALE * in;
-    wire signed [31:0] shifted = product >>> 16;
-    wire signed [31:0] result  = shifted + DAC_ZERO;
+    wire signed [63:0] product = SCALE * in;
+    wire signed [63:0] shifted = product >>> 16;
+    wire signed [63:0] result  = shifted + DAC_ZERO;
 
     // Clamp to valid DAC range [0, 2^M-1]
     assign calibrated = (result < 0) ? {M{1'b0}} :
-                         (result >= (1 << M)) ? {M{1'b1}} :
+                         (result >= (64'sd1 <<< M)) ? {M{1'b1}} :
                          result[M-1:0];
 
+endmodule
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: voltsToDACCodes
+//
+// voltsToDACWords with a register on the output, for the parallel DAC
+// path: the multiply has a full clock cycle at the DAC clock rate instead
+// of being chained into the output logic. Same parameters and mapping;
+// M is the parallel DAC width, the codes are offset binary (ParallelDAC
+// converts to two's complement where needed).
+//////////////////////////////////////////////////////////////////////////////
+
+module voltsToDACCodes #(
+    parameter int DAC_TWOPOINTFIVE = 1,
+    parameter int DAC_ZERO = 8192,
+    parameter int N = 16,
+    parameter int M = 14
+)(
+    input  logic                clk,
+    input  logic signed [N-1:0] in,
+    output logic [M-1:0]        calibrated
+);
+
+    logic [M-1:0] code;
+
+    voltsToDACWords #(
+        .DAC_TWOPOINTFIVE(DAC_TWOPOINTFIVE),
+        .DAC_ZERO(DAC_ZERO),
+        .N(N),
+        .M(M)
+    ) mapping (
+        .in(in),
+        .calibrated(code)
+    );
+
+    always_ff @(posedge clk)
+        calibrated <= code;
+
 endmodule
\ No newline at end of file
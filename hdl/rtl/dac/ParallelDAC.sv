@@ -0,0 +1,89 @@
+`timescale 1ns / 1ps
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: ParallelDAC
+//
+// Parallel output for high-speed dual DACs, as an alternative to the SPI
+// DAC_Controller. It sets the sample rate itself: sample_en pulses once
+// every CLK_DIV clocks and drives the IP's `en` input, and a new word
+// pair goes out on every pulse (clk / CLK_DIV samples per second, versus
+// about 55k for the SPI DAC).
+//
+// Codes are offset binary (voltsToDACCodes output) and are latched on
+// the same edge that raises sample_en, so the pair sent is the sample
+// computed after the previous strobe and one sample of latency is added.
+// TWOS_COMPLEMENT inverts the MSB for DACs with two's-complement input.
+//
+// Bus modes:
+//   CMOS (DDR = 0)  data_a / data_b change at the start of the period,
+//                   dac_clk rises half a period later (CLK_DIV >= 2)
+//   DDR  (DDR = 1)  one bus, data_a: channel A for the first half of the
+//                   period and channel B for the second; dac_clk rises in
+//                   the middle of A and falls in the middle of B, so the
+//                   DAC takes A on the rising and B on the falling edge
+//                   (CLK_DIV >= 4, a multiple of 4 for even spacing).
+//                   data_b is held at 0.
+//
+// The IP's SAMPLING_FREQUENCY must be set to clk / CLK_DIV.
+//////////////////////////////////////////////////////////////////////////////
+
+module ParallelDAC #(
+    parameter int WIDTH = 14,           // DAC word width
+    parameter int CLK_DIV = 20,         // clk cycles per sample
+    parameter bit DDR = 1'b0,           // 0 = CMOS, 1 = DDR interleaved
+    parameter bit TWOS_COMPLEMENT = 1'b0
+)(
+    input  logic             clk,
+    input  logic [WIDTH-1:0] code_a,    // Offset-binary codes
+    input  logic [WIDTH-1:0] code_b,
+    output logic             sample_en, // Sample strobe to the IP
+    output logic             dac_clk,
+    output logic [WIDTH-1:0] data_a,    // CMOS: channel A, DDR: A/B bus
+    output logic [WIDTH-1:0] data_b     // CMOS: channel B, DDR: 0
+);
+
+    localparam int PW = (CLK_DIV > 1) ? $clog2(CLK_DIV) : 1;
+    localparam int HALF = CLK_DIV / 2;
+    localparam int QUARTER = CLK_DIV / 4;
+
+    function automatic logic [WIDTH-1:0] format(input logic [WIDTH-1:0] code);
+        format = TWOS_COMPLEMENT ? {~code[WIDTH-1], code[WIDTH-2:0]} : code;
+    endfunction
+
+    logic [PW-1:0]    phase = '0;
+    logic [WIDTH-1:0] held_b;
+
+    always_ff @(posedge clk) begin
+        phase     <= (phase == CLK_DIV - 1) ? '0 : phase + 1'b1;
+        sample_en <= (phase == 0);
+    end
+
+    // ====================================================================
+    // Data and clock
+    // ====================================================================
+    always_ff @(posedge clk) begin
+        if (DDR) begin
+            data_b <= '0;
+            if (phase == 0) begin
+                data_a <= format(code_a);
+                held_b <= format(code_b);
+            end else if (phase == HALF) begin
+                data_a <= held_b;
+            end
+
+            if (phase == QUARTER)
+                dac_clk <= 1'b1;
+            else if (phase == HALF + QUARTER)
+                dac_clk <= 1'b0;
+        end else begin
+            if (phase == 0) begin
+                data_a  <= format(code_a);
+                data_b  <= format(code_b);
+                dac_clk <= 1'b0;
+            end else if (phase == HALF) begin
+                dac_clk <= 1'b1;
+            end
+        end
+    end
+
+endmodule
\ No newline at end of file
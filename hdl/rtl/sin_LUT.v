@@ -2,29 +2,35 @@
 //////////////////////////////////////////////////////////////////////////////////
 // Module Name: sin_LUT
 // Description: Dual-port synchronous ROM for quarter-wave sine lookup table.
-//              Stores 512 entries of 16-bit unsigned sine values for the
-//              first quadrant (0 to pi/2). The SineWaves module reconstructs
-//              the full waveform using sign and direction symmetry bits.
+//              Stores 2^ADDR_WIDTH entries of DATA_WIDTH-bit unsigned sine
+//              values for the first quadrant (0 to pi/2); the default is
+//              512 x 16. The SineWaves module reconstructs the full waveform
+//              using sign and direction symmetry bits.
 //
 // Port A and Port B provide independent read access for channels A and B.
-// Data is loaded from sin_LUT.hex via $readmemh at elaboration time.
+// Data is loaded from INIT_FILE via $readmemh at elaboration time; generate
+// a matching table with coe.py --samples 2^ADDR_WIDTH --bits DATA_WIDTH.
 //////////////////////////////////////////////////////////////////////////////////
 
-module sin_LUT (
-  input  wire        clka,
-  input  wire [8:0]  addra,
-  output reg  [15:0] douta,
-  input  wire        clkb,
-  input  wire [8:0]  addrb,
-  output reg  [15:0] doutb
+module sin_LUT #(
+  parameter integer ADDR_WIDTH = 9,
+  parameter integer DATA_WIDTH = 16,
+  parameter         INIT_FILE  = "coe/sin_LUT.hex"
+)(
+  input  wire                  clka,
+  input  wire [ADDR_WIDTH-1:0] addra,
+  output reg  [DATA_WIDTH-1:0] douta,
+  input  wire                  clkb,
+  input  wire [ADDR_WIDTH-1:0] addrb,
+  output reg  [DATA_WIDTH-1:0] doutb
 );
 
-  // Quarter-wave sine LUT: 512 entries x 16-bit
-  (* rom_style = "block" *) reg [15:0] lut_memory [0:511];
+  // Quarter-wave sine LUT: 2^ADDR_WIDTH entries x DATA_WIDTH
+  (* rom_style = "block" *) reg [DATA_WIDTH-1:0] lut_memory [0:(1 << ADDR_WIDTH)-1];
 
   // Load LUT data from hex file (one hex value per line)
   initial begin
-    $readmemh("coe/sin_LUT.hex", lut_memory);
+    $readmemh(INIT_FILE, lut_memory);
   end
 
   // Synchronous read - Port A
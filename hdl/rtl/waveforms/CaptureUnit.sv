@@ -0,0 +1,162 @@
+`timescale 1ns / 1ps
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: CaptureUnit
+//
+// On-chip capture of the two-channel sample stream into a block RAM, so
+// the output can be checked over the bus without a scope.
+//
+// Runs in the lut_clk domain. The sample strobe of the selected source
+// (engine_clk for the engine waveform, sample_clk for the scaled output)
+// is brought over with a 3-FF synchronizer like in PerfCounters; the data
+// was registered on the strobe edge and is stable when the synchronized
+// edge is seen. Every (decimation + 1)-th strobe stores {b, a} in one
+// 32-bit word of a DEPTH-entry ring.
+//
+// Capture sequence:
+//   arm      restart; the ring fills with `pre` pre-trigger samples first
+//   trigger  accepted once those are stored (earlier events are ignored);
+//            a software trigger or the event selected by trig_src:
+//              0 = software only, 1 = channel A armed-trigger release,
+//              2 = rising edge of ext_trigger, 3 = multi-board sync event
+//   done     after DEPTH - pre further samples the capture stops
+//
+// Reads are in time order: rd_index n returns the n-th oldest sample, so
+// with pre = P samples 0..P-1 precede the trigger and sample P is the
+// first one stored after it. rd_data is registered (one cycle latency).
+// DEPTH must be a power of two.
+//////////////////////////////////////////////////////////////////////////////
+
+module CaptureUnit #(
+    parameter int DEPTH = 1024
+)(
+    input  logic        clk,            // lut_clk
+    input  logic        rst,
+    input  logic        arm,            // Start a new capture (pulse)
+    input  logic        sw_trigger,     // Software trigger (pulse)
+    input  logic        source,         // 0 = engine waveform, 1 = output
+    input  logic [1:0]  trig_src,
+    input  logic [15:0] pre,            // Pre-trigger samples (< DEPTH)
+    input  logic [15:0] decimation,     // Store 1 of decimation + 1 samples
+    // Sample streams
+    input  logic        engine_clk,
+    input  logic signed [15:0] engine_a,
+    input  logic signed [15:0] engine_b,
+    input  logic        sample_clk,
+    input  logic signed [15:0] out_a,
+    input  logic signed [15:0] out_b,
+    // Trigger events (lut_clk pulses, except ext_trigger)
+    input  logic        trig_fired_a,
+    input  logic        ext_trigger,    // Asynchronous
+    input  logic        sync_event,
+    // Status and read port
+    output logic        waiting,        // Armed, trigger not seen yet
+    output logic        triggered,      // Storing post-trigger samples
+    output logic        done,
+    input  logic [$clog2(DEPTH)-1:0] rd_index,
+    output logic [31:0] rd_data
+);
+
+    localparam int AW = $clog2(DEPTH);
+
+    // ====================================================================
+    // Strobe synchronizers and trigger event selection
+    // ====================================================================
+    logic [2:0] engine_sync = 3'b000, sample_sync = 3'b000;
+    logic [2:0] ext_sync = 3'b000;
+
+    always_ff @(posedge clk) begin
+        engine_sync <= {engine_sync[1:0], engine_clk};
+        sample_sync <= {sample_sync[1:0], sample_clk};
+        ext_sync    <= {ext_sync[1:0], ext_trigger};
+    end
+
+    logic strobe, event_hit;
+    assign strobe = source ? (sample_sync[1] & ~sample_sync[2])
+                           : (engine_sync[1] & ~engine_sync[2]);
+
+    always_comb begin
+        case (trig_src)
+            2'd1:    event_hit = trig_fired_a;
+            2'd2:    event_hit = ext_sync[1] & ~ext_sync[2];
+            2'd3:    event_hit = sync_event;
+            default: event_hit = 1'b0;
+        endcase
+    end
+
+    // ====================================================================
+    // Capture control
+    // ====================================================================
+    (* ram_style = "block" *) logic [31:0] mem [0:DEPTH-1];
+
+    logic [AW-1:0] wr_ptr = '0;
+    logic [AW:0]   pre_cnt = '0;        // Pre-trigger samples stored
+    logic [AW:0]   post_left = '0;      // Post-trigger samples still to store
+    logic [15:0]   dec_cnt = '0;
+    logic          trig_seen = 1'b0;
+    logic [AW:0]   pre_len;
+
+    assign pre_len = (32'(pre) >= DEPTH) ? (AW+1)'(DEPTH - 1) : pre[AW:0];
+
+    logic keep;
+    assign keep = (waiting || triggered) && !rst && !arm && strobe && dec_cnt >= decimation;
+
+    always_ff @(posedge clk) begin
+        if (keep) begin
+            mem[wr_ptr] <= source ? {out_b, out_a} : {engine_b, engine_a};
+            wr_ptr <= wr_ptr + 1'b1;
+        end
+    end
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            waiting   <= 1'b0;
+            triggered <= 1'b0;
+            done      <= 1'b0;
+            trig_seen <= 1'b0;
+        end else if (arm) begin
+            waiting   <= 1'b1;
+            triggered <= 1'b0;
+            done      <= 1'b0;
+            trig_seen <= 1'b0;
+            pre_cnt   <= '0;
+            dec_cnt   <= '0;
+        end else if (waiting || triggered) begin
+            // A trigger counts once the pre-trigger part is full and is
+            // taken at the next stored sample
+            if (waiting && pre_cnt >= pre_len && (sw_trigger || event_hit))
+                trig_seen <= 1'b1;
+
+            if (strobe)
+                dec_cnt <= keep ? '0 : dec_cnt + 1'b1;
+
+            if (keep && waiting) begin
+                if (trig_seen) begin
+                    // This sample is the first one after the trigger
+                    waiting   <= 1'b0;
+                    post_left <= (AW+1)'(DEPTH) - pre_len - 1'b1;
+                    if (pre_len == (AW+1)'(DEPTH - 1))
+                        done      <= 1'b1;
+                    else
+                        triggered <= 1'b1;
+                end else if (pre_cnt < pre_len) begin
+                    pre_cnt <= pre_cnt + 1'b1;
+                end
+            end else if (keep) begin
+                post_left <= post_left - 1'b1;
+                if (post_left == 1) begin
+                    triggered <= 1'b0;
+                    done      <= 1'b1;
+                end
+            end
+        end
+    end
+
+    // ====================================================================
+    // Read port: index 0 is the oldest sample (the next one to overwrite)
+    // ====================================================================
+    always_ff @(posedge clk) begin
+        rd_data <= mem[wr_ptr + rd_index];
+    end
+
+endmodule
\ No newline at end of file
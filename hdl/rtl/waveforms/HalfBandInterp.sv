@@ -0,0 +1,193 @@
+`timescale 1ns / 1ps
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: HalfBandInterp
+//
+// One x2 interpolation stage: 19-tap half-band FIR in polyphase form,
+// shared between channels A and B.
+//
+// Every other coefficient of a half-band filter is zero and the centre tap
+// is 0.5, so at the output rate the two polyphase branches are:
+//   even: sum_i c_i * (x[4-i] + x[5+i]),  i = 0..4   (mid-point sample)
+//   odd : x[4]                                       (pure delay)
+// The symmetric pairs are pre-added, so one multiplier (one DSP slice with
+// pre-adder and accumulator) computes both channels in 2*TAPS cycles after
+// each new input sample.
+//
+// The stage is pull-driven: each out_req emits the next output sample.
+// After emitting the odd (delay) phase it pulses in_req to fetch the next
+// input, which must arrive (in_valid) before the following out_req;
+// `late` flags an out_req that found the mid-point sample not yet ready.
+//
+// Coefficients (gain 2 applied, Q1.17): least-squares design with the
+// passband to 0.2 fs_in and the image band from 0.8 fs_in attenuated by
+// ~100 dB.
+//////////////////////////////////////////////////////////////////////////////
+
+module HalfBandInterp (
+    input  logic        clk,
+    input  logic        rst,
+    // Upstream (input rate)
+    input  logic        in_valid,
+    input  logic signed [15:0] in_a,
+    input  logic signed [15:0] in_b,
+    output logic        in_req,
+    // Downstream (output rate = 2x input rate)
+    input  logic        out_req,
+    output logic        out_valid,
+    output logic signed [15:0] out_a,
+    output logic signed [15:0] out_b,
+    output logic        late
+);
+
+    localparam int TAPS  = 5;           // Non-zero coefficients per side
+    localparam int DEPTH = 2 * TAPS;    // Input history per channel
+
+    function automatic logic signed [17:0] coef(input logic [2:0] i);
+        case (i)
+            3'd0:    coef =  18'sd80180;
+            3'd1:    coef = -18'sd19314;
+            3'd2:    coef =  18'sd5848;
+            3'd3:    coef = -18'sd1342;
+            default: coef =  18'sd164;
+        endcase
+    endfunction
+
+    function automatic logic signed [15:0] round_sat(input logic signed [35:0] acc);
+        logic signed [35:0] r;
+        r = (acc + 36'sd65536) >>> 17;
+        if (r > 36'sd32767)
+            round_sat = 16'sd32767;
+        else if (r < -36'sd32768)
+            round_sat = -16'sd32768;
+        else
+            round_sat = r[15:0];
+    endfunction
+
+    // ====================================================================
+    // Input history (hist[0] = newest)
+    // ====================================================================
+    logic signed [15:0] hist_a [DEPTH];
+    logic signed [15:0] hist_b [DEPTH];
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            for (int k = 0; k < DEPTH; k++) begin
+                hist_a[k] <= 16'sd0;
+                hist_b[k] <= 16'sd0;
+            end
+        end else if (in_valid) begin
+            hist_a[0] <= in_a;
+            hist_b[0] <= in_b;
+            for (int k = 1; k < DEPTH; k++) begin
+                hist_a[k] <= hist_a[k-1];
+                hist_b[k] <= hist_b[k-1];
+            end
+        end
+    end
+
+    // ====================================================================
+    // Time-shared MAC: pre-add -> multiply-accumulate -> round
+    // ====================================================================
+    logic        busy;
+    logic [3:0]  step;
+    logic        step_ch;
+    logic [2:0]  step_tap;
+    logic [3:0]  near_tap, far_tap;     // History taps of the symmetric pair
+
+    assign step_ch  = (step >= 4'(TAPS));
+    assign step_tap = step_ch ? 3'(step - TAPS) : step[2:0];
+    assign near_tap = 4'(TAPS - 1) - {1'b0, step_tap};
+    assign far_tap  = 4'(TAPS) + {1'b0, step_tap};
+
+    logic signed [16:0] pre;
+    logic signed [17:0] coef_r;
+    logic               pre_valid, pre_first, pre_last, pre_ch;
+    logic signed [35:0] acc;
+    logic               acc_done, acc_ch;
+    logic signed [15:0] mid_a, mid_b;
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            busy      <= 1'b0;
+            step      <= 4'd0;
+            pre_valid <= 1'b0;
+            acc_done  <= 1'b0;
+            mid_a     <= 16'sd0;
+            mid_b     <= 16'sd0;
+        end else begin
+            // Sequencer (starts the cycle after the history shifts)
+            if (in_valid) begin
+                busy <= 1'b1;
+                step <= 4'd0;
+            end else if (busy) begin
+                step <= step + 1;
+                if (step == 4'(DEPTH - 1))
+                    busy <= 1'b0;
+            end
+
+            // Stage 1: symmetric pre-add and coefficient select
+            pre_valid <= busy;
+            pre_first <= (step_tap == 3'd0);
+            pre_last  <= (step_tap == 3'(TAPS - 1));
+            pre_ch    <= step_ch;
+            coef_r    <= coef(step_tap);
+            if (step_ch)
+                pre <= 17'(hist_b[near_tap]) + 17'(hist_b[far_tap]);
+            else
+                pre <= 17'(hist_a[near_tap]) + 17'(hist_a[far_tap]);
+
+            // Stage 2: multiply-accumulate
+            if (pre_valid)
+                acc <= (pre_first ? 36'sd0 : acc) + 36'(pre) * 36'(coef_r);
+            acc_done <= pre_valid && pre_last;
+            acc_ch   <= pre_ch;
+
+            // Stage 3: round and saturate the mid-point sample
+            if (acc_done) begin
+                if (acc_ch)
+                    mid_b <= round_sat(acc);
+                else
+                    mid_a <= round_sat(acc);
+            end
+        end
+    end
+
+    // ====================================================================
+    // Output phase: mid-point first, then the delayed input sample
+    // ====================================================================
+    logic odd_phase;
+    logic mid_ready;
+
+    always_ff @(posedge clk) begin
+        in_req    <= 1'b0;
+        out_valid <= 1'b0;
+        late      <= 1'b0;
+        if (rst) begin
+            odd_phase <= 1'b0;
+            mid_ready <= 1'b1;
+            out_a     <= 16'sd0;
+            out_b     <= 16'sd0;
+        end else begin
+            // Channel B finishes last
+            if (acc_done && acc_ch)
+                mid_ready <= 1'b1;
+
+            if (out_req) begin
+                out_valid <= 1'b1;
+                if (!odd_phase) begin
+                    out_a <= mid_a;
+                    out_b <= mid_b;
+                    late  <= !mid_ready;
+                end else begin
+                    out_a     <= hist_a[TAPS - 1];
+                    out_b     <= hist_b[TAPS - 1];
+                    in_req    <= 1'b1;
+                    mid_ready <= 1'b0;
+                end
+                odd_phase <= !odd_phase;
+            end
+        end
+    end
+
+endmodule
\ No newline at end of file
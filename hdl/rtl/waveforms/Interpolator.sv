@@ -0,0 +1,135 @@
+`timescale 1ns / 1ps
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: Interpolator
+//
+// Optional reconstruction stage between the WaveForms engine and the DAC
+// path. A cascade of STAGES x2 half-band FIR stages (HalfBandInterp) runs
+// in the lut_clk domain, so the engine produces one sample per 2^STAGES
+// DAC updates and the images of the engine rate are filtered out before
+// they reach the DAC.
+//
+// The cascade is pull-driven by the DAC-rate sample strobe: every rising
+// edge of sample_clk takes one output sample from the last stage, and
+// whenever the first stage needs new input it issues an engine_clk pulse
+// (ENGINE_HIGH lut_clk cycles wide) and captures the engine output
+// ENGINE_SETTLE cycles later. The engine therefore runs at
+// SAMPLING_FREQUENCY / 2^STAGES and must be parameterized accordingly.
+//
+// `underflow` pulses when a DAC strobe finds a stage output not yet
+// computed, `overrun` when a new engine sample is requested while the
+// previous one is still in flight.
+//
+// STAGES = 0 bypasses the filter: engine_clk is sample_clk and the engine
+// output is passed straight through.
+//////////////////////////////////////////////////////////////////////////////
+
+module Interpolator #(
+    parameter int STAGES = 0    // Number of x2 half-band stages (0 = bypass)
+)(
+    input  logic        clk,            // lut_clk
+    input  logic        rst,
+    input  logic        sample_clk,     // DAC-rate sample strobe
+    output logic        engine_clk,     // Engine (WaveForms) sample clock
+    input  logic signed [15:0] in_a,
+    input  logic signed [15:0] in_b,
+    output logic signed [15:0] out_a,
+    output logic signed [15:0] out_b,
+    output logic        underflow,
+    output logic        overrun
+);
+
+    generate
+        if (STAGES == 0) begin : g_bypass
+            assign engine_clk = sample_clk;
+            assign out_a = in_a;
+            assign out_b = in_b;
+            assign underflow = 1'b0;
+            assign overrun   = 1'b0;
+        end else begin : g_interp
+            localparam int ENGINE_HIGH   = 4;   // engine_clk high time
+            localparam int ENGINE_SETTLE = 8;   // capture delay after edge
+
+            // ============================================================
+            // DAC-rate strobe (synchronized rising edge of sample_clk)
+            // ============================================================
+            logic [2:0] strobe_sync = 3'b000;
+            always_ff @(posedge clk)
+                strobe_sync <= {strobe_sync[1:0], sample_clk};
+
+            // ============================================================
+            // Stage interconnect: index k is the input side of stage k,
+            // index STAGES is the DAC side
+            // ============================================================
+            wire                req   [0:STAGES];
+            wire                valid [0:STAGES];
+            wire signed [15:0]  data_a [0:STAGES];
+            wire signed [15:0]  data_b [0:STAGES];
+            wire [STAGES-1:0]   late;
+
+            assign req[STAGES] = strobe_sync[1] & ~strobe_sync[2];
+
+            genvar k;
+            for (k = 0; k < STAGES; k = k + 1) begin : g_stage
+                HalfBandInterp hb (
+                    .clk(clk),
+                    .rst(rst),
+                    .in_valid(valid[k]),
+                    .in_a(data_a[k]),
+                    .in_b(data_b[k]),
+                    .in_req(req[k]),
+                    .out_req(req[k+1]),
+                    .out_valid(valid[k+1]),
+                    .out_a(data_a[k+1]),
+                    .out_b(data_b[k+1]),
+                    .late(late[k])
+                );
+            end
+
+            // ============================================================
+            // Engine sample request: pulse engine_clk, then capture
+            // ============================================================
+            logic               engine_clk_r = 1'b0;
+            logic               engine_busy  = 1'b0;
+            logic [3:0]         engine_cnt   = 4'd0;
+            logic               engine_valid = 1'b0;
+            logic signed [15:0] engine_a = 16'sd0;
+            logic signed [15:0] engine_b = 16'sd0;
+            logic               overrun_r = 1'b0;
+
+            always_ff @(posedge clk) begin
+                engine_valid <= 1'b0;
+                overrun_r    <= req[0] && engine_busy;
+                if (rst) begin
+                    engine_clk_r <= 1'b0;
+                    engine_busy  <= 1'b0;
+                end else if (engine_busy) begin
+                    engine_cnt <= engine_cnt + 1;
+                    if (engine_cnt == 4'(ENGINE_HIGH - 1))
+                        engine_clk_r <= 1'b0;
+                    if (engine_cnt == 4'(ENGINE_SETTLE - 1)) begin
+                        engine_a     <= in_a;
+                        engine_b     <= in_b;
+                        engine_valid <= 1'b1;
+                        engine_busy  <= 1'b0;
+                    end
+                end else if (req[0]) begin
+                    engine_clk_r <= 1'b1;
+                    engine_busy  <= 1'b1;
+                    engine_cnt   <= 4'd0;
+                end
+            end
+
+            assign engine_clk = engine_clk_r;
+            assign valid[0]   = engine_valid;
+            assign data_a[0]  = engine_a;
+            assign data_b[0]  = engine_b;
+
+            assign out_a = data_a[STAGES];
+            assign out_b = data_b[STAGES];
+            assign underflow = |late;
+            assign overrun   = overrun_r;
+        end
+    endgenerate
+
+endmodule
\ No newline at end of file
@@ -0,0 +1,104 @@
+`timescale 1ns / 1ps
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: Modulator
+//
+// Per-channel AM/FM/PM modulation source for the WaveForms engine.
+//
+// The modulating signal m (signed Q1.15) is either a dedicated low-rate
+// oscillator or the other channel's raw waveform sample. The internal
+// oscillator is a 32-bit phase accumulator shaped into an approximate
+// sine with a single multiply (parabolic approximation):
+//   m = 4 * x * (1 - |x|),  x = phase as a signed fraction in [-1, 1)
+//
+// Outputs are combinational from registered state and are consumed by
+// the carrier in the same sample clock domain:
+//   AM: am_gain   = 1 - depth * (1 - m) / 2     (envelope 1-depth .. 1)
+//   FM: fm_delta  = deviation_increment * m      (added to phase step)
+//   PM: pm_offset = depth * m * 2                (32767 = +/-180 deg)
+//
+// cfg bits:
+//   [1:0] = TYPE   : 0 = off, 1 = AM, 2 = FM, 3 = PM
+//   [2]   = SOURCE : 0 = internal oscillator, 1 = other channel
+//////////////////////////////////////////////////////////////////////////////
+
+module Modulator #(
+    parameter int SAMPLING_FREQUENCY = 50000
+)(
+    input  logic        clk,
+    input  logic        rst,
+    input  logic [7:0]  cfg,
+    input  logic [15:0] depth,        // AM depth / PM deviation (Q0.15)
+    input  logic [31:0] lfo_freq,     // Internal oscillator (100uHz units)
+    input  logic [31:0] fm_dev,       // FM peak deviation (100uHz units)
+    input  logic signed [15:0] other_sample,
+    output logic        am_active,
+    output logic [15:0] am_gain,      // Q1.15, 32767 = unity
+    output logic signed [31:0] fm_delta,
+    output logic signed [31:0] pm_offset
+);
+
+    localparam logic [1:0] MOD_OFF = 2'd0;
+    localparam logic [1:0] MOD_AM  = 2'd1;
+    localparam logic [1:0] MOD_FM  = 2'd2;
+    localparam logic [1:0] MOD_PM  = 2'd3;
+
+    // Same frequency-to-phase scaling as the carrier accumulators
+    localparam longint unsigned PHASE_SCALE = 64'h1_0000_0000 / SAMPLING_FREQUENCY;
+
+    // ====================================================================
+    // Internal oscillator
+    // ====================================================================
+    logic [31:0] lfo_phase;
+    logic [63:0] lfo_delta_wide;
+
+    assign lfo_delta_wide = 64'(lfo_freq) * PHASE_SCALE;
+
+    always_ff @(posedge clk) begin
+        if (rst)
+            lfo_phase <= 32'b0;
+        else
+            lfo_phase <= lfo_phase + lfo_delta_wide[31:0];
+    end
+
+    // Parabolic sine: x in Q1.15, y = 4*x*(1-|x|) = (x*(1-|x|)) >>> 13
+    logic signed [15:0] lfo_x;
+    logic        [15:0] lfo_abs;
+    logic signed [33:0] lfo_prod;
+    logic signed [20:0] lfo_y;
+    logic signed [15:0] lfo_value;
+
+    assign lfo_x     = $signed(lfo_phase[31:16]);
+    assign lfo_abs   = lfo_x[15] ? -lfo_x : lfo_x;
+    assign lfo_prod  = 34'(lfo_x) * 34'($signed({1'b0, 17'h08000 - {1'b0, lfo_abs}}));
+    assign lfo_y     = lfo_prod[33:13];
+    assign lfo_value = (lfo_y > 21'sd32767)  ? 16'sd32767 :
+                       (lfo_y < -21'sd32767) ? -16'sd32767 : lfo_y[15:0];
+
+    // ====================================================================
+    // Modulating signal and per-type outputs
+    // ====================================================================
+    logic signed [15:0] m;
+    assign m = cfg[2] ? other_sample : lfo_value;
+
+    // AM: gain = 32767 - depth * (32767 - m) / 65536
+    logic        [16:0] am_span;
+    logic        [32:0] am_prod;
+    assign am_span   = 17'sd32767 - 17'(m);
+    assign am_prod   = 33'(depth[14:0]) * 33'(am_span);
+    assign am_active = (cfg[1:0] == MOD_AM);
+    assign am_gain   = am_active ? (16'd32767 - am_prod[31:16]) : 16'd32767;
+
+    // FM: deviation increment scaled by m (Q1.15)
+    logic [63:0]        dev_wide;
+    logic signed [48:0] fm_prod;
+    assign dev_wide = 64'(fm_dev) * PHASE_SCALE;
+    assign fm_prod  = 49'($signed({1'b0, dev_wide[31:0]})) * 49'(m);
+    assign fm_delta = (cfg[1:0] == MOD_FM) ? fm_prod[46:15] : 32'sd0;
+
+    // PM: phase offset, full-scale depth = +/-180 degrees
+    logic signed [31:0] pm_prod;
+    assign pm_prod   = 32'(m) * 32'($signed({1'b0, depth[14:0]}));
+    assign pm_offset = (cfg[1:0] == MOD_PM) ? (pm_prod <<< 1) : 32'sd0;
+
+endmodule
@@ -0,0 +1,61 @@
+`timescale 1ns / 1ps
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: NoiseGen
+//
+// Per-channel noise source for the WaveForms NOISE mode.
+//
+// A 64-bit xorshift generator (shifts 13, 7, 17; period 2^64 - 1) steps
+// once per engine sample, so the sequence does not repeat in practice and
+// the spectrum is white up to the sample rate. Output, signed Q1.15:
+//   uniform  : top 16 bits of the state (flat over full scale)
+//   gaussian : sum of the four 16-bit slices of the state, / 4
+//              (Irwin-Hall n=4: bell-shaped, sigma = FS / (2*sqrt(3))
+//              ~ 0.29 FS, bounded to full scale so it never clips)
+//
+// `load` holds the generator at its seed (channel idle, armed or being
+// restarted), so a given seed always produces the same sequence from the
+// first sample. The 32-bit seed is expanded to a 64-bit state by XOR
+// with two different constants, which can never give the all-zero state.
+// Channels get independent sequences by using different seeds.
+//////////////////////////////////////////////////////////////////////////////
+
+module NoiseGen (
+    input  logic        clk,            // Engine sample clock
+    input  logic        load,           // Hold at the seed
+    input  logic [31:0] seed,
+    input  logic        gaussian,       // 0 = uniform, 1 = approx. gaussian
+    output logic signed [15:0] sample
+);
+
+    function automatic logic [63:0] seed_state(input logic [31:0] s);
+        seed_state = {s ^ 32'h9E3779B9, s ^ 32'h7F4A7C15};
+    endfunction
+
+    function automatic logic [63:0] xorshift64(input logic [63:0] x);
+        logic [63:0] t;
+        t = x ^ (x << 13);
+        t = t ^ (t >> 7);
+        xorshift64 = t ^ (t << 17);
+    endfunction
+
+    logic [63:0] state = seed_state(32'd0);
+
+    always_ff @(posedge clk) begin
+        if (load)
+            state <= seed_state(seed);
+        else
+            state <= xorshift64(state);
+    end
+
+    // ====================================================================
+    // Output shaping
+    // ====================================================================
+    logic signed [17:0] gauss_sum;
+
+    assign gauss_sum = 18'($signed(state[15:0]))  + 18'($signed(state[31:16])) +
+                       18'($signed(state[47:32])) + 18'($signed(state[63:48]));
+
+    assign sample = gaussian ? gauss_sum[17:2] : $signed(state[63:48]);
+
+endmodule
\ No newline at end of file
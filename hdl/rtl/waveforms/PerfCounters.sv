@@ -0,0 +1,143 @@
+`timescale 1ns / 1ps
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: PerfCounters
+//
+// Free-running event counters for production monitoring of the delivered
+// sample rate, without a scope.
+//
+// All counters run in the lut_clk domain. Events from the sample clock
+// domain (engine samples, completed cycles, DAC frames) are brought over
+// with 2-FF synchronizers and counted on their edges; the sample clocks
+// are far slower than lut_clk, so no edge is lost.
+//
+// Writing `snapshot` copies every counter into a shadow bank in the same
+// cycle; reads return the shadow bank, so multi-word and cross-counter
+// reads are coherent. `clear` zeroes the live counters.
+//
+// Read index (rd_index, one 32-bit word each):
+//   0/1   clock count lo/hi            (lut_clk cycles)
+//   2/3   samples A lo/hi              (engine samples while A active)
+//   4/5   samples B lo/hi
+//   6/7   clocks since trigger A lo/hi (software or accepted ext trigger)
+//   8/9   clocks since trigger B lo/hi
+//   10    completed cycles A
+//   11    completed cycles B
+//   12    DAC frames                   (DAC-rate sample strobes)
+//   13    underflows                   (DAC strobe before data was ready)
+//   14    overruns                     (engine request while still busy)
+//   15    reconfig applies
+//////////////////////////////////////////////////////////////////////////////
+
+module PerfCounters (
+    input  logic        clk,            // lut_clk
+    input  logic        rst,
+    input  logic        snapshot,       // Latch all counters (pulse)
+    input  logic        clear,          // Zero all counters (pulse)
+    // Sample clock domain events
+    input  logic        engine_clk,
+    input  logic        sample_clk,
+    input  logic        active_a,
+    input  logic        active_b,
+    input  logic        cycle_tog_a,
+    input  logic        cycle_tog_b,
+    // lut_clk domain events (single-cycle pulses)
+    input  logic        trigger_a,
+    input  logic        trigger_b,
+    input  logic        underflow,
+    input  logic        overrun,
+    input  logic        reconfig,
+    // Snapshot read port
+    input  logic [3:0]  rd_index,
+    output logic [31:0] rd_data
+);
+
+    // ====================================================================
+    // Synchronizers and edge detection
+    // ====================================================================
+    logic [2:0] engine_sync = 3'b000;
+    logic [2:0] sample_sync = 3'b000;
+    logic [1:0] active_a_sync = 2'b00, active_b_sync = 2'b00;
+    logic [2:0] tog_a_sync = 3'b000, tog_b_sync = 3'b000;
+
+    always_ff @(posedge clk) begin
+        engine_sync   <= {engine_sync[1:0], engine_clk};
+        sample_sync   <= {sample_sync[1:0], sample_clk};
+        active_a_sync <= {active_a_sync[0], active_a};
+        active_b_sync <= {active_b_sync[0], active_b};
+        tog_a_sync    <= {tog_a_sync[1:0], cycle_tog_a};
+        tog_b_sync    <= {tog_b_sync[1:0], cycle_tog_b};
+    end
+
+    logic engine_edge, sample_edge, cycle_a_edge, cycle_b_edge;
+    assign engine_edge  = engine_sync[1] & ~engine_sync[2];
+    assign sample_edge  = sample_sync[1] & ~sample_sync[2];
+    assign cycle_a_edge = tog_a_sync[1] ^ tog_a_sync[2];
+    assign cycle_b_edge = tog_b_sync[1] ^ tog_b_sync[2];
+
+    // ====================================================================
+    // Live counters
+    // ====================================================================
+    logic [63:0] clk_count, samples_a, samples_b, since_trig_a, since_trig_b;
+    logic [31:0] cycles_a, cycles_b, dac_frames, underflows, overruns, reconfigs;
+
+    always_ff @(posedge clk) begin
+        if (rst || clear) begin
+            clk_count    <= 64'd0;
+            samples_a    <= 64'd0;
+            samples_b    <= 64'd0;
+            since_trig_a <= 64'd0;
+            since_trig_b <= 64'd0;
+            cycles_a     <= 32'd0;
+            cycles_b     <= 32'd0;
+            dac_frames   <= 32'd0;
+            underflows   <= 32'd0;
+            overruns     <= 32'd0;
+            reconfigs    <= 32'd0;
+        end else begin
+            clk_count    <= clk_count + 1;
+            since_trig_a <= trigger_a ? 64'd0 : since_trig_a + 1;
+            since_trig_b <= trigger_b ? 64'd0 : since_trig_b + 1;
+            if (engine_edge && active_a_sync[1]) samples_a <= samples_a + 1;
+            if (engine_edge && active_b_sync[1]) samples_b <= samples_b + 1;
+            if (cycle_a_edge) cycles_a   <= cycles_a + 1;
+            if (cycle_b_edge) cycles_b   <= cycles_b + 1;
+            if (sample_edge)  dac_frames <= dac_frames + 1;
+            if (underflow)    underflows <= underflows + 1;
+            if (overrun)      overruns   <= overruns + 1;
+            if (reconfig)     reconfigs  <= reconfigs + 1;
+        end
+    end
+
+    // ====================================================================
+    // Snapshot bank and read mux
+    // ====================================================================
+    logic [31:0] snap [16];
+
+    always_ff @(posedge clk) begin
+        if (rst) begin
+            for (int k = 0; k < 16; k++)
+                snap[k] <= 32'd0;
+        end else if (snapshot) begin
+            snap[0]  <= clk_count[31:0];
+            snap[1]  <= clk_count[63:32];
+            snap[2]  <= samples_a[31:0];
+            snap[3]  <= samples_a[63:32];
+            snap[4]  <= samples_b[31:0];
+            snap[5]  <= samples_b[63:32];
+            snap[6]  <= since_trig_a[31:0];
+            snap[7]  <= since_trig_a[63:32];
+            snap[8]  <= since_trig_b[31:0];
+            snap[9]  <= since_trig_b[63:32];
+            snap[10] <= cycles_a;
+            snap[11] <= cycles_b;
+            snap[12] <= dac_frames;
+            snap[13] <= underflows;
+            snap[14] <= overruns;
+            snap[15] <= reconfigs;
+        end
+    end
+
+    assign rd_data = snap[rd_index];
+
+endmodule
\ No newline at end of file
@@ -0,0 +1,226 @@
+`timescale 1ns / 1ps
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: SineCordic
+//
+// Sine and cosine synthesis with a pipelined CORDIC instead of a LUT, for
+// designs short of block RAM. Same ports, phase format and latency as
+// SineWaves, plus cos_a/cos_b; WaveForms selects it with SINE_CORDIC.
+//
+// The phase is folded to its quadrant (phase[31:30]) and an angle r in
+// [0, pi/2) (phase[29:0], kept to OUT_WIDTH + 6 bits). A rotation-mode
+// CORDIC with ITERATIONS stages turns the vector (K * A, 0) by r, where K
+// is the CORDIC gain correction, so it ends at (A cos r, A sin r) with no
+// output multiply; the quadrant then swaps and negates the pair. Each
+// iteration adds about one bit of accuracy: ITERATIONS = OUT_WIDTH gives
+// errors within 2 LSB at OUT_WIDTH bits. Narrower results are
+// extended to the 16-bit outputs like narrow SineWaves tables.
+//
+// Timing: like SineWaves, the phase is taken and the result is moved to
+// the outputs on the first lut_clk edge of each engine sample (clk
+// rising), in three steps, so the output lags the phase by the same
+// number of engine samples whatever the clk high time. The iterations run
+// ungated in between and need ITERATIONS + 2 lut_clk cycles from one
+// engine sample to the next: the engine sample period must be at least
+// that long (20 lut_clk cycles per sample in the testbench).
+//////////////////////////////////////////////////////////////////////////////
+
+module SineCordic #(
+    parameter int ITERATIONS = 16,      // CORDIC stages (1 to 30)
+    parameter int OUT_WIDTH  = 16       // Result bits before extension (<= 16)
+)(
+    input  logic        clk,
+    input  logic        lut_clk,
+    input  logic        en,
+    input  logic [31:0] phase_a,
+    input  logic [31:0] phase_b,
+    output logic signed [15:0] out_a,
+    output logic signed [15:0] out_b,
+    output logic signed [15:0] cos_a,
+    output logic signed [15:0] cos_b
+);
+
+    logic signed [15:0] sin_a_w, sin_b_w, cos_a_w, cos_b_w;
+
+    SineCordicChannel #(
+        .ITERATIONS(ITERATIONS),
+        .OUT_WIDTH(OUT_WIDTH)
+    ) channel_a (
+        .clk(clk),
+        .lut_clk(lut_clk),
+        .phase(phase_a),
+        .sin_out(sin_a_w),
+        .cos_out(cos_a_w)
+    );
+
+    SineCordicChannel #(
+        .ITERATIONS(ITERATIONS),
+        .OUT_WIDTH(OUT_WIDTH)
+    ) channel_b (
+        .clk(clk),
+        .lut_clk(lut_clk),
+        .phase(phase_b),
+        .sin_out(sin_b_w),
+        .cos_out(cos_b_w)
+    );
+
+    assign out_a = sin_a_w;
+    assign out_b = sin_b_w;
+    assign cos_a = cos_a_w;
+    assign cos_b = cos_b_w;
+
+endmodule
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: SineCordicChannel
+//
+// One CORDIC pipeline of SineCordic.
+//////////////////////////////////////////////////////////////////////////////
+
+module SineCordicChannel #(
+    parameter int ITERATIONS = 16,
+    parameter int OUT_WIDTH  = 16
+)(
+    input  logic        clk,
+    input  logic        lut_clk,
+    input  logic [31:0] phase,
+    output logic signed [15:0] sin_out,
+    output logic signed [15:0] cos_out
+);
+
+    localparam int N  = ITERATIONS;
+    localparam int G  = $clog2(ITERATIONS) + 1;     // Guard bits
+    localparam int W  = OUT_WIDTH + G + 2;          // x/y width
+    localparam int ZB = OUT_WIDTH + 6;              // Angle bits per turn
+    localparam longint AMPLITUDE = ((64'sd1 <<< (OUT_WIDTH - 1)) - 1) <<< G;
+    localparam longint MAX_OUT   = (64'sd1 <<< (OUT_WIDTH - 1)) - 1;
+
+    // atan(2^-i) in 2^-32 turn units, rounded to ZB bits per turn
+    function automatic logic signed [ZB-1:0] angle(input int i);
+        longint a;
+        case (i)
+            0:  a = 64'd536870912;   1:  a = 64'd316933406;
+            2:  a = 64'd167458907;   3:  a = 64'd85004756;
+            4:  a = 64'd42667331;    5:  a = 64'd21354465;
+            6:  a = 64'd10679838;    7:  a = 64'd5340245;
+            8:  a = 64'd2670163;     9:  a = 64'd1335087;
+            10: a = 64'd667544;      11: a = 64'd333772;
+            12: a = 64'd166886;      13: a = 64'd83443;
+            14: a = 64'd41722;       15: a = 64'd20861;
+            16: a = 64'd10430;       17: a = 64'd5215;
+            18: a = 64'd2608;        19: a = 64'd1304;
+            20: a = 64'd652;         21: a = 64'd326;
+            22: a = 64'd163;         23: a = 64'd81;
+            24: a = 64'd41;          25: a = 64'd20;
+            26: a = 64'd10;          27: a = 64'd5;
+            28: a = 64'd3;           29: a = 64'd1;
+            default: a = 64'd1;
+        endcase
+        angle = ZB'((a + (64'd1 << (31 - ZB))) >> (32 - ZB));
+    endfunction
+
+    // Start vector: amplitude times the gain correction prod 1/sqrt(1 + 4^-i)
+    function automatic longint start_x(input int n);
+        real k, p;
+        k = 1.0;
+        p = 1.0;
+        for (int i = 0; i < n; i++) begin
+            k = k / $sqrt(1.0 + p);
+            p = p / 4.0;
+        end
+        start_x = longint'($rtoi(k * AMPLITUDE + 0.5));
+    endfunction
+
+    localparam logic signed [W-1:0] X0 = W'(start_x(N));
+
+    // ====================================================================
+    // Gated input stage (as SineWaves stage 1)
+    // ====================================================================
+    logic [1:0]    quad_in;
+    logic [ZB-1:0] r_in;
+    logic          clk_d = 1'b0;
+    logic          step;                // First lut_clk edge of a sample
+
+    assign step = clk && !clk_d;
+
+    always_ff @(posedge lut_clk) begin
+        clk_d <= clk;
+        if (step) begin
+            quad_in <= phase[31:30];
+            r_in    <= {2'b00, phase[29 -: ZB-2]};
+        end
+    end
+
+    // ====================================================================
+    // CORDIC iterations (ungated, one per lut_clk)
+    // ====================================================================
+    logic signed [W-1:0]  x [0:N];
+    logic signed [W-1:0]  y [0:N];
+    logic signed [ZB-1:0] z [0:N];
+    logic [1:0]           q [0:N];
+
+    always_ff @(posedge lut_clk) begin
+        x[0] <= X0;
+        y[0] <= '0;
+        z[0] <= r_in;
+        q[0] <= quad_in;
+
+        for (int i = 0; i < N; i++) begin
+            if (!z[i][ZB-1]) begin
+                x[i+1] <= x[i] - (y[i] >>> i);
+                y[i+1] <= y[i] + (x[i] >>> i);
+                z[i+1] <= z[i] - angle(i);
+            end else begin
+                x[i+1] <= x[i] + (y[i] >>> i);
+                y[i+1] <= y[i] - (x[i] >>> i);
+                z[i+1] <= z[i] + angle(i);
+            end
+            q[i+1] <= q[i];
+        end
+    end
+
+    // ====================================================================
+    // Round, saturate, unfold the quadrant, extend to 16 bits
+    // ====================================================================
+    function automatic logic signed [15:0] finish(input logic signed [W-1:0] v);
+        logic signed [W:0] r;
+        logic signed [OUT_WIDTH-1:0] s;
+        r = ((W+1)'(v) + (W+1)'(1 <<< (G - 1))) >>> G;
+        if (r > (W+1)'(MAX_OUT))
+            s = OUT_WIDTH'(MAX_OUT);
+        else if (r < (W+1)'(-MAX_OUT))
+            s = OUT_WIDTH'(-MAX_OUT);
+        else
+            s = r[OUT_WIDTH-1:0];
+        finish = 16'(s) <<< (16 - OUT_WIDTH);
+    endfunction
+
+    logic signed [15:0] c_r, s_r, sin_n, cos_n;
+
+    assign c_r = finish(x[N]);
+    assign s_r = finish(y[N]);
+
+    always_comb begin
+        case (q[N])
+            2'd0:    begin sin_n = s_r;  cos_n = c_r;  end
+            2'd1:    begin sin_n = c_r;  cos_n = -s_r; end
+            2'd2:    begin sin_n = -s_r; cos_n = -c_r; end
+            default: begin sin_n = -c_r; cos_n = s_r;  end
+        endcase
+    end
+
+    // ====================================================================
+    // Gated output stages (as SineWaves stages 2 and 3)
+    // ====================================================================
+    logic signed [15:0] sin_d, cos_d;
+
+    always_ff @(posedge lut_clk) begin
+        if (step) begin
+            sin_d   <= sin_n;
+            cos_d   <= cos_n;
+            sin_out <= sin_d;
+            cos_out <= cos_d;
+        end
+    end
+
+endmodule
\ No newline at end of file
@@ -8,13 +8,25 @@
 // The 32-bit phase input is decomposed as:
 //   [31]    = sign     : if 1, negate the output (handles 3rd & 4th quadrants)
 //   [30]    = direction: if 1, mirror the LUT index (handles 2nd quadrant)
-//   [29:21] = 9-bit LUT address (512 entries for first quadrant)
+//   [29 -: LUT_ADDR_WIDTH] = LUT address (2^LUT_ADDR_WIDTH entries for the
+//                            first quadrant; 9 bits = 512 entries by default)
 //
 // This approach stores only one quarter of the sine wave (0 to pi/2),
-// reducing memory by 4x while maintaining full 16-bit precision.
+// reducing memory by 4x. LUT entries are LUT_DATA_WIDTH-bit unsigned
+// magnitudes (max 2^(LUT_DATA_WIDTH-1)-1); they are rounded or extended
+// to the 16-bit output. Each extra address bit buys ~6 dB of SFDR
+// (phase truncation spurs) for twice the BRAM; see coe.py --sfdr.
+//
+// Timing: the stages advance on the first lut_clk edge of each engine
+// sample (clk rising), so the output lags the phase by the same number
+// of engine samples however long clk stays high.
 //////////////////////////////////////////////////////////////////////////////
 
-module SineWaves (
+module SineWaves #(
+    parameter int LUT_ADDR_WIDTH = 9,
+    parameter int LUT_DATA_WIDTH = 16,
+    parameter     LUT_FILE       = "coe/sin_LUT.hex"
+)(
     input  logic        clk,
     input  logic        lut_clk,
     input  logic        en,
@@ -23,8 +35,6 @@ module SineWaves (
     output logic signed [15:0] out_a,
     output logic signed [15:0] out_b
 );
-    localparam LUT_ADDR_WIDTH = 9;
-    
     // Phase decomposition - registered for proper timing
     logic sign_a_r, dir_a_r;
     logic sign_b_r, dir_b_r;
@@ -33,14 +43,18 @@ module SineWaves (
     // LUT address and output
     logic [LUT_ADDR_WIDTH-1:0] lut_addr_a;
     logic [LUT_ADDR_WIDTH-1:0] lut_addr_b;
-    logic [15:0] lut_value_a, lut_value_b;
+    logic [LUT_DATA_WIDTH-1:0] lut_value_a, lut_value_b;
     
     // Pipeline stage: delayed sign for output negation
     // (accounts for 1-cycle LUT read latency)
     logic sign_a_d1, sign_b_d1;
 
     // Dual-port sine LUT
-    sin_LUT lut (
+    sin_LUT #(
+        .ADDR_WIDTH(LUT_ADDR_WIDTH),
+        .DATA_WIDTH(LUT_DATA_WIDTH),
+        .INIT_FILE(LUT_FILE)
+    ) lut (
         .clka(lut_clk),
         .addra(lut_addr_a),
         .douta(lut_value_a),
@@ -49,8 +63,36 @@ module SineWaves (
         .doutb(lut_value_b)
     );
 
+    // ====================================================================
+    // LUT magnitude to 15 bits (round wider tables, extend narrower ones)
+    // ====================================================================
+    logic [14:0] mag_a, mag_b;
+
+    generate
+        if (LUT_DATA_WIDTH > 16) begin : g_round
+            localparam int SHIFT = LUT_DATA_WIDTH - 16;
+            logic [LUT_DATA_WIDTH-1:0] rnd_a, rnd_b;
+            logic [15:0] top_a, top_b;
+            assign rnd_a = {1'b0, lut_value_a[LUT_DATA_WIDTH-2:0]} + LUT_DATA_WIDTH'(1 << (SHIFT - 1));
+            assign rnd_b = {1'b0, lut_value_b[LUT_DATA_WIDTH-2:0]} + LUT_DATA_WIDTH'(1 << (SHIFT - 1));
+            assign top_a = rnd_a[LUT_DATA_WIDTH-1:SHIFT];
+            assign top_b = rnd_b[LUT_DATA_WIDTH-1:SHIFT];
+            assign mag_a = top_a[15] ? 15'h7FFF : top_a[14:0];
+            assign mag_b = top_b[15] ? 15'h7FFF : top_b[14:0];
+        end else if (LUT_DATA_WIDTH == 16) begin : g_direct
+            assign mag_a = lut_value_a[14:0];
+            assign mag_b = lut_value_b[14:0];
+        end else begin : g_extend
+            assign mag_a = {lut_value_a[LUT_DATA_WIDTH-2:0], {(16 - LUT_DATA_WIDTH){1'b0}}};
+            assign mag_b = {lut_value_b[LUT_DATA_WIDTH-2:0], {(16 - LUT_DATA_WIDTH){1'b0}}};
+        end
+    endgenerate
+
+    logic clk_d = 1'b0;
+
     always_ff @(posedge lut_clk) begin
-        if (clk == 1'b1) begin
+        clk_d <= clk;
+        if (clk && !clk_d) begin
             // Stage 1: Decompose phase and compute LUT address
             sign_a_r  <= phase_a[31];
             dir_a_r   <= phase_a[30];
@@ -69,8 +111,8 @@ module SineWaves (
             sign_b_d1 <= sign_b_r;
 
             // Stage 2: Apply sign (negate for quadrants 3 & 4)
-            out_a <= sign_a_d1 ? -$signed({1'b0, lut_value_a[14:0]}) : $signed({1'b0, lut_value_a[14:0]});
-            out_b <= sign_b_d1 ? -$signed({1'b0, lut_value_b[14:0]}) : $signed({1'b0, lut_value_b[14:0]});
+            out_a <= sign_a_d1 ? -$signed({1'b0, mag_a}) : $signed({1'b0, mag_a});
+            out_b <= sign_b_d1 ? -$signed({1'b0, mag_b}) : $signed({1'b0, mag_b});
         end
     end
 
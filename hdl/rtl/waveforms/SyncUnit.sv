@@ -0,0 +1,71 @@
+`timescale 1ns / 1ps
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: SyncUnit
+//
+// Multi-board phase synchronization: sync pulse generator (master) and
+// sync input qualifier (every board).
+//
+// Runs in the fast (lut_clk) domain. Engine sample edges are detected with
+// a 2-FF synchronizer, and sync_out is only changed right after one, so
+// the pulse is aligned to the sample clock: it rises a few lut_clk cycles
+// after engine sample k and falls after sample k+1 (one sample period
+// wide). A pulse is emitted after a `fire` request or, when `period` is
+// non-zero, every `period` engine samples (PPS-style).
+//
+// The sync input is the sync_in pin ORed with the local sync_out when
+// `loopback` is set, so a master that does not wire its own sync_out back
+// sees its pulse through the same synchronizer as the boards it drives.
+// `sync_event` pulses for one cycle on each rising edge, well before the
+// next engine sample edge, where the channels act on it (see WaveForms).
+//////////////////////////////////////////////////////////////////////////////
+
+module SyncUnit (
+    input  logic        clk,            // lut_clk
+    input  logic        engine_clk,     // Engine sample clock
+    input  logic        sync_in,        // Sync input pin (asynchronous)
+    input  logic        fire,           // Single-cycle: emit one sync pulse
+    input  logic        loopback,       // Local sync_out also drives the input
+    input  logic [31:0] period,         // Engine samples between pulses (0 = off)
+    output logic        sync_out,
+    output logic        sync_event      // Single-cycle: sync input rising edge
+);
+
+    // ====================================================================
+    // Sync pulse generator (aligned to engine sample edges)
+    // ====================================================================
+    logic [2:0]  engine_sync = 3'b000;
+    logic        engine_edge;
+    logic        fire_pending = 1'b0;
+    logic [31:0] period_cnt = 32'd0;
+    logic        out_r = 1'b0;
+    logic        period_due;
+
+    assign engine_edge = engine_sync[1] & ~engine_sync[2];
+    assign period_due  = (period != 32'd0) && (period_cnt >= period - 1);
+
+    always_ff @(posedge clk) begin
+        engine_sync <= {engine_sync[1:0], engine_clk};
+
+        if (engine_edge) begin
+            out_r      <= fire_pending || fire || period_due;
+            period_cnt <= (period == 32'd0 || period_due) ? 32'd0 : period_cnt + 1;
+            fire_pending <= 1'b0;
+        end else if (fire) begin
+            fire_pending <= 1'b1;
+        end
+    end
+
+    assign sync_out = out_r;
+
+    // ====================================================================
+    // Sync input: 2-FF synchronizer and rising edge
+    // ====================================================================
+    logic [2:0] in_sync = 3'b000;
+
+    always_ff @(posedge clk)
+        in_sync <= {in_sync[1:0], sync_in | (loopback & out_r)};
+
+    assign sync_event = in_sync[1] & ~in_sync[2];
+
+endmodule
\ No newline at end of file
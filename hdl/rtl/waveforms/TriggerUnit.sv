@@ -0,0 +1,93 @@
+`timescale 1ns / 1ps
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: TriggerUnit
+//
+// Per-channel trigger qualifier for the WaveForms engine.
+//
+// Runs in the fast (lut_clk) domain. A trigger event is either the
+// single-cycle software trigger from the AXI slave or the selected edge of
+// the (already synchronized) external trigger input. While the channel is
+// armed, the first event raises `pending`, which is held as a level until
+// the sample-clock domain reports that the channel has started. Holding a
+// level (instead of forwarding the pulse) guarantees the slower sample
+// clock cannot miss the trigger.
+//
+// The latency counter measures lut_clk cycles from the trigger event to
+// the start acknowledge. The value includes the fixed 2-cycle synchronizer
+// delay on `started`; the variable part is the wait for the next sample
+// clock edge. `fired` pulses for one cycle when an armed trigger is
+// accepted.
+//
+// cfg bits:
+//   [0]   = ARM    : hold the channel at phase 0 until a trigger arrives
+//   [1]   = EXT_EN : accept the external trigger input
+//   [3:2] = EDGE   : 00 = rising, 01 = falling, 10/11 = both edges
+//////////////////////////////////////////////////////////////////////////////
+
+module TriggerUnit (
+    input  logic        clk,
+    input  logic        rst,         // Channel reset or disabled (level)
+    input  logic [7:0]  cfg,
+    input  logic        sw_trigger,  // Single-cycle software trigger
+    input  logic        ext_level,   // Synchronized external trigger level
+    input  logic        started,     // Channel has started (sample domain)
+    output logic        armed,
+    output logic        pending,
+    output logic        fired,
+    output logic [31:0] latency
+);
+
+    logic        ext_prev = 1'b0;
+    logic [1:0]  started_sync = 2'b00;
+    logic [31:0] count = 32'd0;
+    logic        pending_r = 1'b0;
+    logic        fired_r = 1'b0;
+    logic [31:0] latency_r = 32'd0;
+    logic        ext_edge;
+    logic        trig_event;
+
+    assign pending = pending_r;
+    assign fired   = fired_r;
+    assign latency = latency_r;
+
+    // ====================================================================
+    // External edge selection
+    // ====================================================================
+    always_comb begin
+        case (cfg[3:2])
+            2'b00:   ext_edge = ext_level & ~ext_prev;
+            2'b01:   ext_edge = ~ext_level & ext_prev;
+            default: ext_edge = ext_level ^ ext_prev;
+        endcase
+    end
+
+    assign trig_event = sw_trigger | (cfg[1] & ext_edge);
+    assign armed      = cfg[0] & ~rst & ~started_sync[1];
+
+    // ====================================================================
+    // Pending flag and trigger-to-start latency counter
+    // ====================================================================
+    always_ff @(posedge clk) begin
+        ext_prev     <= ext_level;
+        started_sync <= {started_sync[0], started};
+        fired_r      <= 1'b0;
+
+        if (rst || !cfg[0]) begin
+            pending_r <= 1'b0;
+            count     <= 32'd0;
+        end else if (pending_r) begin
+            if (started_sync[1]) begin
+                latency_r <= count;
+                pending_r <= 1'b0;
+            end else if (count != 32'hFFFF_FFFF) begin
+                count <= count + 1;
+            end
+        end else if (armed && trig_event) begin
+            pending_r <= 1'b1;
+            fired_r   <= 1'b1;
+            count     <= 32'd1;
+        end
+    end
+
+endmodule
\ No newline at end of file
@@ -4,7 +4,7 @@
 // Module: WaveForms
 //
 // Dual-channel waveform generator with support for DC, sine, sawtooth,
-// triangle, square, and arbitrary waveform modes.
+// triangle, square, arbitrary waveform, noise and quadrature modes.
 //
 // Uses fixed-point phase accumulator architecture. The frequency is set by
 // computing a phase increment (delta_phase) per sample clock cycle.
@@ -14,17 +14,59 @@
 // Phase accumulator: 32-bit unsigned
 //   [31]    = sign bit (for sine symmetry)
 //   [30]    = direction bit (for sine symmetry)
-//   [29:21] = LUT address (9-bit, 512 entries)
-//   [20:0]  = fractional phase (sub-sample precision)
+//   [29 -: SINE_LUT_ADDR_WIDTH] = sine LUT address (9-bit, 512 entries
+//             by default; SINE_LUT_DATA_WIDTH sets the table width)
+//   [remaining low bits] = fractional phase (sub-sample precision)
 //
 // ARB waveform memory is internal (BRAM-inferred) and loaded via a
 // simple write interface (arb_wr_en, arb_wr_addr, arb_wr_data) from
-// the AXI register slave.
+// the AXI register slave. One phase cycle plays exactly the first
+// arb_waveform_depth samples, for any depth, optionally with linear
+// interpolation between neighbouring samples (arb_interp_a/b). The
+// memory holds plain 16-bit samples or, selected by arb_format,
+// delta-coded blocks that are decoded in the playback path and hold
+// about 1.8x (8-bit deltas) or 3.6x (4-bit deltas) as many samples.
+//
+// Triggering: when a channel's trig_cfg ARM bit is set, the channel holds
+// at phase 0 with zero output after enable until a software trigger or
+// the selected edge of ext_trigger arrives (see TriggerUnit). All armed
+// channels released by the same event start on the same sample clock edge.
+//
+// Sine engine: SineWaves (quarter-wave LUT in block RAM) or, with
+// SINE_CORDIC = 1, SineCordic (pipelined CORDIC, no block RAM), which has
+// the same latency. Quadrature mode outputs the cosine of the other
+// channel's phase, so a channel pair in SINE + QUADRATURE is an I/Q
+// pair that follows one frequency, phase offset and modulation. The
+// CORDIC provides the cosine directly; the LUT engine reads it through
+// the quadrature channel's table port at the other phase + 90 degrees.
+//
+// Noise: each channel has a NoiseGen (64-bit xorshift, uniform or
+// approximately gaussian) that steps every sample and restarts from its
+// seed whenever the channel's phase is held or restarted.
+//
+// Modulation: each channel has a Modulator that can scale its output (AM),
+// add to its phase increment (FM) or add to its phase (PM) every sample,
+// driven by an internal low-rate oscillator or the other channel's raw
+// waveform sample.
+//
+// Multi-board sync: SyncUnit drives sync_out (a pulse on sync_fire or
+// every sync_period samples) and qualifies sync_in. A channel with
+// sync_cfg ARM or EVERY set acts on a sync edge at the next sample clock
+// edge: an armed (trig_cfg ARM) channel is released as by a trigger, a
+// running channel restarts from phase 0 with its cycle count and
+// modulator cleared. Boards sharing the sample clock and the sync line
+// therefore restart on the same sample.
 //////////////////////////////////////////////////////////////////////////////
 
 module WaveForms #(
     parameter int SAMPLING_FREQUENCY = 50000,
-    parameter int ARB_WAVEFORM_DEPTH = 1024
+    parameter int ARB_WAVEFORM_DEPTH = 1024,
+    parameter int SINE_LUT_ADDR_WIDTH = 9,
+    parameter int SINE_LUT_DATA_WIDTH = 16,
+    parameter     SINE_LUT_FILE = "coe/sin_LUT.hex",
+    parameter int SINE_CORDIC = 0,
+    parameter int CORDIC_ITERATIONS = 16,
+    parameter int CORDIC_WIDTH = 16
 )(
     input  logic        clk,
     input  logic        lut_clk,
@@ -34,6 +76,9 @@ module WaveForms #(
     input  logic        enb,
     input  logic        trigger_a,
     input  logic        trigger_b,
+    input  logic        ext_trigger,
+    input  logic [7:0]  trig_cfg_a,
+    input  logic [7:0]  trig_cfg_b,
     input  logic [3:0]  mode_a,
     input  logic [3:0]  mode_b,
     input  logic [31:0] freq_a,
@@ -45,13 +90,52 @@ module WaveForms #(
     input  logic [15:0] cycles_a,
     input  logic [15:0] cycles_b,
     input  logic [31:0] arb_waveform_depth,
+    input  logic        arb_interp_a,   // Linear interpolation in ARB mode
+    input  logic        arb_interp_b,
+    input  logic [1:0]  arb_format,     // ARB memory format, both channels
+    // Modulation configuration (see Modulator)
+    input  logic [7:0]  mod_cfg_a,
+    input  logic [7:0]  mod_cfg_b,
+    input  logic [15:0] mod_depth_a,
+    input  logic [15:0] mod_depth_b,
+    input  logic [31:0] mod_freq_a,
+    input  logic [31:0] mod_freq_b,
+    input  logic [31:0] mod_dev_a,
+    input  logic [31:0] mod_dev_b,
+    // Noise configuration (see NoiseGen)
+    input  logic        noise_gauss_a,
+    input  logic        noise_gauss_b,
+    input  logic [31:0] noise_seed_a,
+    input  logic [31:0] noise_seed_b,
+    // Multi-board sync (see SyncUnit)
+    input  logic        sync_in,
+    output logic        sync_out,
+    input  logic        sync_fire,      // Emit one sync pulse (lut_clk pulse)
+    input  logic        sync_loopback,
+    input  logic [31:0] sync_period,
+    input  logic [1:0]  sync_cfg_a,     // [0]=act on next sync, [1]=on every sync
+    input  logic [1:0]  sync_cfg_b,
+    output logic        sync_hit_a,     // Sync accepted by the channel (lut_clk)
+    output logic        sync_hit_b,
+    output logic        sync_event,
     // ARB waveform write interface (from AXI slave)
     input  logic        arb_wr_clk,
     input  logic        arb_wr_en,
     input  logic [$clog2(ARB_WAVEFORM_DEPTH)-1:0] arb_wr_addr,
     input  logic [15:0] arb_wr_data,
     output logic signed [15:0] wave_a,
-    output logic signed [15:0] wave_b
+    output logic signed [15:0] wave_b,
+    output logic        armed_a,
+    output logic        armed_b,
+    output logic [31:0] trig_latency_a,
+    output logic [31:0] trig_latency_b,
+    // Performance counter events
+    output logic        trig_fired_a,   // Armed trigger accepted (lut_clk)
+    output logic        trig_fired_b,
+    output logic        active_a,       // Producing samples (sample clock)
+    output logic        active_b,
+    output logic        cycle_tog_a,    // Toggles per completed cycle
+    output logic        cycle_tog_b
 );
 
     // ====================================================================
@@ -63,6 +147,8 @@ module WaveForms #(
     localparam logic [3:0] TRIANGLE = 4'd3;
     localparam logic [3:0] SQUARE   = 4'd4;
     localparam logic [3:0] ARB      = 4'd5;
+    localparam logic [3:0] NOISE    = 4'd6;
+    localparam logic [3:0] QUAD     = 4'd7;
 
     localparam signed [15:0] ONE_VOLT     = 16'sd32767;  // 2^15 - 1
     localparam signed [15:0] NEG_ONE_VOLT = -16'sd32767;
@@ -109,6 +195,16 @@ module WaveForms #(
         end
     end
 
+    // Read ports: one per channel, registered on lut_clk and addressed by
+    // the channel's ArbReader
+    logic [ARB_ADDR_BITS-1:0] arb_rd_addr_a, arb_rd_addr_b;
+    logic [15:0]              arb_rd_data_a, arb_rd_data_b;
+
+    always_ff @(posedge lut_clk) begin
+        arb_rd_data_a <= arb_waveform_data[arb_rd_addr_a];
+        arb_rd_data_b <= arb_waveform_data[arb_rd_addr_b];
+    end
+
     // ====================================================================
     // Channel A signals
     // ====================================================================
@@ -121,17 +217,22 @@ module WaveForms #(
     logic [15:0] n_cycles_a;
     logic        phase_a_msb_prev;
     logic        triggered_a;
+    logic signed [15:0] wave_a_raw;
+    logic        am_active_a;
+    logic [15:0] am_gain_a;
+    logic signed [31:0] fm_delta_a;
+    logic signed [31:0] pm_offset_a;
 
     // Compute phase delta: freq_a * PHASE_SCALE
-    assign delta_phase_a_wide = freq_a * PHASE_SCALE;
+    assign delta_phase_a_wide = 64'(freq_a) * PHASE_SCALE;
     assign delta_phase_a = delta_phase_a_wide[31:0];
 
     // Compute normalized phase offset
-    assign phase_offset_a_wide = $signed(phase_offs_a) * $signed(PHASE_OFFSET_SCALE[31:0]);
+    assign phase_offset_a_wide = 64'($signed(phase_offs_a)) * 64'($signed(PHASE_OFFSET_SCALE[31:0]));
     assign normalized_phase_offset_a = phase_offset_a_wide[31:0];
 
-    // Apply phase offset
-    assign real_phase_a = phase_a + normalized_phase_offset_a;
+    // Apply phase offset (plus phase modulation, zero unless PM is active)
+    assign real_phase_a = phase_a + normalized_phase_offset_a + pm_offset_a;
 
     // ====================================================================
     // Channel B signals
@@ -145,30 +246,216 @@ module WaveForms #(
     logic [15:0] n_cycles_b;
     logic        phase_b_msb_prev;
     logic        triggered_b;
+    logic signed [15:0] wave_b_raw;
+    logic        am_active_b;
+    logic [15:0] am_gain_b;
+    logic signed [31:0] fm_delta_b;
+    logic signed [31:0] pm_offset_b;
 
-    assign delta_phase_b_wide = freq_b * PHASE_SCALE;
+    assign delta_phase_b_wide = 64'(freq_b) * PHASE_SCALE;
     assign delta_phase_b = delta_phase_b_wide[31:0];
 
-    assign phase_offset_b_wide = $signed(phase_offs_b) * $signed(PHASE_OFFSET_SCALE[31:0]);
+    assign phase_offset_b_wide = 64'($signed(phase_offs_b)) * 64'($signed(PHASE_OFFSET_SCALE[31:0]));
     assign normalized_phase_offset_b = phase_offset_b_wide[31:0];
 
-    assign real_phase_b = phase_b + normalized_phase_offset_b;
+    assign real_phase_b = phase_b + normalized_phase_offset_b + pm_offset_b;
 
     // ====================================================================
-    // Sine wave generation (shared dual-port LUT)
+    // Trigger qualification (lut_clk domain)
+    //
+    // The external trigger is synchronized once and shared by both
+    // channels so that a single edge releases them in the same cycle.
     // ====================================================================
-    logic signed [15:0] sine_a, sine_b;
+    logic [1:0] ext_trigger_sync = 2'b00;
+    logic       trig_pending_a, trig_pending_b;
+
+    always_ff @(posedge lut_clk) begin
+        ext_trigger_sync <= {ext_trigger_sync[0], ext_trigger};
+    end
+
+    TriggerUnit trig_unit_a (
+        .clk(lut_clk),
+        .rst(rst_a || !ena),
+        .cfg(trig_cfg_a),
+        .sw_trigger(trigger_a),
+        .ext_level(ext_trigger_sync[1]),
+        .started(triggered_a),
+        .armed(armed_a),
+        .pending(trig_pending_a),
+        .fired(trig_fired_a),
+        .latency(trig_latency_a)
+    );
+
+    TriggerUnit trig_unit_b (
+        .clk(lut_clk),
+        .rst(rst_b || !enb),
+        .cfg(trig_cfg_b),
+        .sw_trigger(trigger_b),
+        .ext_level(ext_trigger_sync[1]),
+        .started(triggered_b),
+        .armed(armed_b),
+        .pending(trig_pending_b),
+        .fired(trig_fired_b),
+        .latency(trig_latency_b)
+    );
 
-    SineWaves sine_waves (
+    // ====================================================================
+    // Multi-board sync (lut_clk domain, handed to the sample clock domain
+    // as a toggle: the edge arrives mid-sample, so the toggle is stable
+    // at the next sample clock edge)
+    // ====================================================================
+    logic sync_req_a = 1'b0, sync_req_b = 1'b0;
+    logic sync_ack_a = 1'b0, sync_ack_b = 1'b0;
+    logic sync_now_a, sync_now_b;
+
+    SyncUnit sync_unit (
+        .clk(lut_clk),
+        .engine_clk(clk),
+        .sync_in(sync_in),
+        .fire(sync_fire),
+        .loopback(sync_loopback),
+        .period(sync_period),
+        .sync_out(sync_out),
+        .sync_event(sync_event)
+    );
+
+    always_ff @(posedge lut_clk) begin
+        sync_hit_a <= sync_event && sync_cfg_a != 2'b00;
+        sync_hit_b <= sync_event && sync_cfg_b != 2'b00;
+        if (sync_event && sync_cfg_a != 2'b00)
+            sync_req_a <= !sync_req_a;
+        if (sync_event && sync_cfg_b != 2'b00)
+            sync_req_b <= !sync_req_b;
+    end
+
+    always_ff @(posedge clk) begin
+        sync_ack_a <= sync_req_a;
+        sync_ack_b <= sync_req_b;
+    end
+
+    assign sync_now_a = sync_req_a ^ sync_ack_a;
+    assign sync_now_b = sync_req_b ^ sync_ack_b;
+
+    // ====================================================================
+    // Modulation and noise sources (sample clock domain)
+    //
+    // Held in reset while the channel is disabled or armed, and reset on
+    // a sync restart, so that they are aligned with the carrier start.
+    // ====================================================================
+    logic restart_a, restart_b;
+    assign restart_a = rst_a || !ena || (trig_cfg_a[0] && !triggered_a) || sync_now_a;
+    assign restart_b = rst_b || !enb || (trig_cfg_b[0] && !triggered_b) || sync_now_b;
+
+    Modulator #(
+        .SAMPLING_FREQUENCY(SAMPLING_FREQUENCY)
+    ) mod_a (
         .clk(clk),
-        .lut_clk(lut_clk),
-        .en(1'b1),
-        .phase_a(real_phase_a),
-        .phase_b(real_phase_b),
-        .out_a(sine_a),
-        .out_b(sine_b)
+        .rst(restart_a),
+        .cfg(mod_cfg_a),
+        .depth(mod_depth_a),
+        .lfo_freq(mod_freq_a),
+        .fm_dev(mod_dev_a),
+        .other_sample(wave_b_raw),
+        .am_active(am_active_a),
+        .am_gain(am_gain_a),
+        .fm_delta(fm_delta_a),
+        .pm_offset(pm_offset_a)
     );
 
+    Modulator #(
+        .SAMPLING_FREQUENCY(SAMPLING_FREQUENCY)
+    ) mod_b (
+        .clk(clk),
+        .rst(restart_b),
+        .cfg(mod_cfg_b),
+        .depth(mod_depth_b),
+        .lfo_freq(mod_freq_b),
+        .fm_dev(mod_dev_b),
+        .other_sample(wave_a_raw),
+        .am_active(am_active_b),
+        .am_gain(am_gain_b),
+        .fm_delta(fm_delta_b),
+        .pm_offset(pm_offset_b)
+    );
+
+    logic signed [15:0] noise_a, noise_b;
+
+    NoiseGen noise_gen_a (
+        .clk(clk),
+        .load(restart_a),
+        .seed(noise_seed_a),
+        .gaussian(noise_gauss_a),
+        .sample(noise_a)
+    );
+
+    NoiseGen noise_gen_b (
+        .clk(clk),
+        .load(restart_b),
+        .seed(noise_seed_b),
+        .gaussian(noise_gauss_b),
+        .sample(noise_b)
+    );
+
+    // Amplitude modulation is applied to the registered carrier sample
+    logic signed [31:0] am_prod_a, am_prod_b;
+    assign am_prod_a = 32'(wave_a_raw) * 32'($signed({1'b0, am_gain_a}));
+    assign am_prod_b = 32'(wave_b_raw) * 32'($signed({1'b0, am_gain_b}));
+    assign wave_a = am_active_a ? am_prod_a[30:15] : wave_a_raw;
+    assign wave_b = am_active_b ? am_prod_b[30:15] : wave_b_raw;
+
+    // ====================================================================
+    // Sine wave generation (shared dual-port LUT or CORDIC)
+    // ====================================================================
+    logic signed [15:0] sine_a, sine_b;
+    logic signed [15:0] quad_a, quad_b;     // Cosine of the other channel
+
+    generate
+        if (SINE_CORDIC) begin : g_cordic
+            logic signed [15:0] cos_a, cos_b;
+
+            SineCordic #(
+                .ITERATIONS(CORDIC_ITERATIONS),
+                .OUT_WIDTH(CORDIC_WIDTH)
+            ) sine_waves (
+                .clk(clk),
+                .lut_clk(lut_clk),
+                .en(1'b1),
+                .phase_a(real_phase_a),
+                .phase_b(real_phase_b),
+                .out_a(sine_a),
+                .out_b(sine_b),
+                .cos_a(cos_a),
+                .cos_b(cos_b)
+            );
+
+            assign quad_a = cos_b;
+            assign quad_b = cos_a;
+        end else begin : g_lut
+            // A quadrature channel's port reads the other phase + 90 deg
+            logic [31:0] lut_phase_a, lut_phase_b;
+
+            assign lut_phase_a = (mode_a == QUAD) ? real_phase_b + 32'h40000000 : real_phase_a;
+            assign lut_phase_b = (mode_b == QUAD) ? real_phase_a + 32'h40000000 : real_phase_b;
+
+            SineWaves #(
+                .LUT_ADDR_WIDTH(SINE_LUT_ADDR_WIDTH),
+                .LUT_DATA_WIDTH(SINE_LUT_DATA_WIDTH),
+                .LUT_FILE(SINE_LUT_FILE)
+            ) sine_waves (
+                .clk(clk),
+                .lut_clk(lut_clk),
+                .en(1'b1),
+                .phase_a(lut_phase_a),
+                .phase_b(lut_phase_b),
+                .out_a(sine_a),
+                .out_b(sine_b)
+            );
+
+            assign quad_a = sine_a;
+            assign quad_b = sine_b;
+        end
+    endgenerate
+
     // ====================================================================
     // Duty cycle thresholds (scaled to 32-bit phase range)
     // ====================================================================
@@ -179,10 +466,92 @@ module WaveForms #(
 
     // ====================================================================
     // ARB waveform index computation
+    //
+    // The table length L (arb_waveform_depth; 0 or more than the memory
+    // holds in the current format selects the most it holds) need not
+    // be a power of two. The play position is phase * L / 2^32, a
+    // multiply rather than a divider: the upper bits are the sample
+    // index (0 .. L-1 over one cycle) and the next 16 bits the fraction
+    // towards the following sample, which wraps to 0 at L. For L = 2^ARB_ADDR_BITS the index is the top of
+    // the phase accumulator, as in a plain power-of-two table. Each
+    // channel's ArbReader reads its samples through the registered port
+    // above, one word per lut_clk cycle of each sample.
+    //
+    // Delta formats: the memory is a row of 9-word blocks. Word 0 of a
+    // block is a key sample, words 1-8 are delta slots, low slot first
+    // within each word: 16 signed bytes (ARB_FMT_DELTA8) or 32 signed
+    // nibbles (ARB_FMT_DELTA4). Slot 0 is the block's shift (its low
+    // 4 bits), and sample j of the block (0 .. 15 or 0 .. 31) is
+    //   key + ((slot 1 + ... + slot j) <<< shift)
+    // saturated to 16 bits. Every sample decodes from the 9 words of
+    // its own block, read in turn and summed as they arrive, so the play
+    // position may jump as in the plain format. Words after the last
+    // whole block in the memory are unused.
     // ====================================================================
-    logic [ARB_ADDR_BITS-1:0] arb_index_a, arb_index_b;
-    assign arb_index_a = phase_a[31 -: ARB_ADDR_BITS];
-    assign arb_index_b = phase_b[31 -: ARB_ADDR_BITS];
+    localparam logic [1:0] ARB_FMT_RAW    = 2'd0;   // (3 reserved, plays as raw)
+    localparam logic [1:0] ARB_FMT_DELTA8 = 2'd1;
+    localparam logic [1:0] ARB_FMT_DELTA4 = 2'd2;
+    localparam integer ARB_BLOCK_WORDS = 9;
+    localparam integer ARB_BLOCKS      = ARB_WAVEFORM_DEPTH / ARB_BLOCK_WORDS;
+    localparam integer ARB_LEN_BITS    = ARB_ADDR_BITS + 2;
+
+    logic [ARB_LEN_BITS-1:0] arb_max_len;
+    logic [ARB_LEN_BITS-1:0] arb_len;
+
+    always_comb begin
+        case (arb_format)
+            ARB_FMT_DELTA8: arb_max_len = ARB_LEN_BITS'(ARB_BLOCKS * 16);
+            ARB_FMT_DELTA4: arb_max_len = ARB_LEN_BITS'(ARB_BLOCKS * 32);
+            default:        arb_max_len = ARB_LEN_BITS'(ARB_WAVEFORM_DEPTH);
+        endcase
+    end
+
+    assign arb_len = (arb_waveform_depth == 32'd0 || arb_waveform_depth > 32'(arb_max_len))
+                   ? arb_max_len
+                   : arb_waveform_depth[ARB_LEN_BITS-1:0];
+
+    logic signed [15:0] arb_sample_a, arb_sample_b;
+
+    ArbReader #(
+        .ADDR_BITS(ARB_ADDR_BITS),
+        .LEN_BITS(ARB_LEN_BITS)
+    ) arb_reader_a (
+        .clk(clk),
+        .lut_clk(lut_clk),
+        .phase(phase_a),
+        .len(arb_len),
+        .format(arb_format),
+        .interp(arb_interp_a),
+        .rd_addr(arb_rd_addr_a),
+        .rd_data(arb_rd_data_a),
+        .sample(arb_sample_a)
+    );
+
+    ArbReader #(
+        .ADDR_BITS(ARB_ADDR_BITS),
+        .LEN_BITS(ARB_LEN_BITS)
+    ) arb_reader_b (
+        .clk(clk),
+        .lut_clk(lut_clk),
+        .phase(phase_b),
+        .len(arb_len),
+        .format(arb_format),
+        .interp(arb_interp_b),
+        .rd_addr(arb_rd_addr_b),
+        .rd_data(arb_rd_data_b),
+        .sample(arb_sample_b)
+    );
+
+    // ====================================================================
+    // Performance counter events (sampled in the lut_clk domain)
+    // ====================================================================
+    logic active_a_r = 1'b0, active_b_r = 1'b0;
+    logic cycle_tog_a_r = 1'b0, cycle_tog_b_r = 1'b0;
+
+    assign active_a    = active_a_r;
+    assign active_b    = active_b_r;
+    assign cycle_tog_a = cycle_tog_a_r;
+    assign cycle_tog_b = cycle_tog_b_r;
 
     // ====================================================================
     // Channel A: Phase accumulator and waveform generation
@@ -190,52 +559,65 @@ module WaveForms #(
     always_ff @(posedge clk) begin
         if (rst_a || !ena) begin
             phase_a        <= 32'b0;
-            wave_a         <= 16'sb0;
+            wave_a_raw     <= 16'sb0;
             n_cycles_a     <= 16'b0;
             phase_a_msb_prev <= 1'b0;
             triggered_a    <= 1'b0;
-        end else begin
-            // Detect trigger
-            if (trigger_a)
+            active_a_r     <= 1'b0;
+        end else if (trig_cfg_a[0] && !triggered_a) begin
+            // Armed: hold at phase 0 until the trigger is released
+            phase_a <= 32'b0;
+            wave_a_raw <= 16'sb0;
+            active_a_r <= 1'b0;
+            if (trig_pending_a || sync_now_a)
                 triggered_a <= 1'b1;
-
+        end else begin
             // Cycle counting: detect negative edge of phase MSB (one full cycle)
             phase_a_msb_prev <= phase_a[31];
             if (phase_a_msb_prev && !phase_a[31]) begin
+                cycle_tog_a_r <= !cycle_tog_a_r;
                 if (cycles_a != 16'b0 && n_cycles_a < cycles_a)
                     n_cycles_a <= n_cycles_a + 1;
             end
 
             // Generate waveform if continuous (cycles=0) or cycle count not reached
+            active_a_r <= (cycles_a == 16'b0 || n_cycles_a < cycles_a);
             if (cycles_a == 16'b0 || n_cycles_a < cycles_a) begin
                 case (mode_a)
-                    DC: wave_a <= 16'sb0;
-                    SINE: wave_a <= sine_a;
+                    DC: wave_a_raw <= 16'sb0;
+                    SINE: wave_a_raw <= sine_a;
                     SAWTOOTH: begin
                         // Linear ramp from ~-16384 to ~+16383
-                        wave_a <= $signed({1'b0, real_phase_a[31:17]}) - 16'sd16384;
+                        wave_a_raw <= $signed({1'b0, real_phase_a[31:17]}) - 16'sd16384;
                     end
                     TRIANGLE: begin
                         if (!real_phase_a[31]) begin
-                            wave_a <= $signed({1'b0, real_phase_a[30:16]}) - 16'sd16384;
+                            wave_a_raw <= $signed({1'b0, real_phase_a[30:16]}) - 16'sd16384;
                         end else begin
-                            wave_a <= 16'sd16383 - $signed({1'b0, real_phase_a[30:16]});
+                            wave_a_raw <= 16'sd16383 - $signed({1'b0, real_phase_a[30:16]});
                         end
                     end
                     SQUARE: begin
                         if (real_phase_a < dtcyca)
-                            wave_a <= ONE_VOLT;
+                            wave_a_raw <= ONE_VOLT;
                         else
-                            wave_a <= NEG_ONE_VOLT;
-                    end
-                    ARB: begin
-                        wave_a <= $signed(arb_waveform_data[arb_index_a]);
+                            wave_a_raw <= NEG_ONE_VOLT;
                     end
-                    default: wave_a <= 16'sb0;
+                    ARB: wave_a_raw <= arb_sample_a;
+                    NOISE: wave_a_raw <= noise_a;
+                    QUAD: wave_a_raw <= quad_a;
+                    default: wave_a_raw <= 16'sb0;
                 endcase
-                phase_a <= phase_a + delta_phase_a;
+                phase_a <= phase_a + delta_phase_a + fm_delta_a;
             end else begin
-                wave_a <= 16'sb0;
+                wave_a_raw <= 16'sb0;
+            end
+
+            // Sync restart (overrides the phase advance above)
+            if (sync_now_a) begin
+                phase_a          <= 32'b0;
+                phase_a_msb_prev <= 1'b0;
+                n_cycles_a       <= 16'b0;
             end
         end
     end
@@ -246,50 +628,267 @@ module WaveForms #(
     always_ff @(posedge clk) begin
         if (rst_b || !enb) begin
             phase_b        <= 32'b0;
-            wave_b         <= 16'sb0;
+            wave_b_raw     <= 16'sb0;
             n_cycles_b     <= 16'b0;
             phase_b_msb_prev <= 1'b0;
             triggered_b    <= 1'b0;
-        end else begin
-            if (trigger_b)
+            active_b_r     <= 1'b0;
+        end else if (trig_cfg_b[0] && !triggered_b) begin
+            phase_b <= 32'b0;
+            wave_b_raw <= 16'sb0;
+            active_b_r <= 1'b0;
+            if (trig_pending_b || sync_now_b)
                 triggered_b <= 1'b1;
-
+        end else begin
             phase_b_msb_prev <= phase_b[31];
             if (phase_b_msb_prev && !phase_b[31]) begin
+                cycle_tog_b_r <= !cycle_tog_b_r;
                 if (cycles_b != 16'b0 && n_cycles_b < cycles_b)
                     n_cycles_b <= n_cycles_b + 1;
             end
 
+            active_b_r <= (cycles_b == 16'b0 || n_cycles_b < cycles_b);
             if (cycles_b == 16'b0 || n_cycles_b < cycles_b) begin
                 case (mode_b)
-                    DC: wave_b <= 16'sb0;
-                    SINE: wave_b <= sine_b;
+                    DC: wave_b_raw <= 16'sb0;
+                    SINE: wave_b_raw <= sine_b;
                     SAWTOOTH: begin
-                        wave_b <= $signed({1'b0, real_phase_b[31:17]}) - 16'sd16384;
+                        wave_b_raw <= $signed({1'b0, real_phase_b[31:17]}) - 16'sd16384;
                     end
                     TRIANGLE: begin
                         if (!real_phase_b[31]) begin
-                            wave_b <= $signed({1'b0, real_phase_b[30:16]}) - 16'sd16384;
+                            wave_b_raw <= $signed({1'b0, real_phase_b[30:16]}) - 16'sd16384;
                         end else begin
-                            wave_b <= 16'sd16383 - $signed({1'b0, real_phase_b[30:16]});
+                            wave_b_raw <= 16'sd16383 - $signed({1'b0, real_phase_b[30:16]});
                         end
                     end
                     SQUARE: begin
                         if (real_phase_b < dtcycb)
-                            wave_b <= ONE_VOLT;
+                            wave_b_raw <= ONE_VOLT;
                         else
-                            wave_b <= NEG_ONE_VOLT;
-                    end
-                    ARB: begin
-                        wave_b <= $signed(arb_waveform_data[arb_index_b]);
+                            wave_b_raw <= NEG_ONE_VOLT;
                     end
-                    default: wave_b <= 16'sb0;
+                    ARB: wave_b_raw <= arb_sample_b;
+                    NOISE: wave_b_raw <= noise_b;
+                    QUAD: wave_b_raw <= quad_b;
+                    default: wave_b_raw <= 16'sb0;
                 endcase
-                phase_b <= phase_b + delta_phase_b;
+                phase_b <= phase_b + delta_phase_b + fm_delta_b;
             end else begin
-                wave_b <= 16'sb0;
+                wave_b_raw <= 16'sb0;
+            end
+
+            if (sync_now_b) begin
+                phase_b          <= 32'b0;
+                phase_b_msb_prev <= 1'b0;
+                n_cycles_b       <= 16'b0;
             end
         end
     end
             
-endmodule
\ No newline at end of file
+endmodule
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: ArbReader
+//
+// ARB playback for one channel of WaveForms, through one registered read
+// port of the ARB memory (the word at rd_addr arrives on rd_data one
+// lut_clk later). On the first lut_clk edge of each engine sample (clk
+// high) it takes the phase and the format, then reads one word per
+// lut_clk edge:
+//   plain tables: the sample at the play position, and with
+//                 interpolation the next one (1 or 2 reads)
+//   delta blocks: the 9 words of the block holding the play position,
+//                 accumulating the deltas up to it and, with
+//                 interpolation, up to the next sample; a next sample
+//                 in another block is that block's key, one more read
+//                 (9 or 10 reads)
+// then interpolates. sample is updated at most N + 5 lut_clk edges after
+// the sample clock edge, N the number of reads, in time for the next one,
+// which plays it as a combinational read would: the sample period must
+// be at least 8 lut_clk cycles for plain tables and 16 for delta blocks
+// (20 in the testbench).
+//////////////////////////////////////////////////////////////////////////////
+
+module ArbReader #(
+    parameter int ADDR_BITS = 10,
+    parameter int LEN_BITS  = 12
+)(
+    input  logic                 clk,
+    input  logic                 lut_clk,
+    input  logic [31:0]          phase,
+    input  logic [LEN_BITS-1:0]  len,       // Table length in samples, >= 1
+    input  logic [1:0]           format,    // WaveForms ARB_FMT_*
+    input  logic                 interp,
+    output logic [ADDR_BITS-1:0] rd_addr,
+    input  logic [15:0]          rd_data,
+    output logic signed [15:0]   sample
+);
+
+    localparam logic [1:0] FMT_DELTA8  = 2'd1;
+    localparam logic [1:0] FMT_DELTA4  = 2'd2;
+    localparam integer     BLOCK_WORDS = 9;
+
+    function automatic logic signed [15:0] arb_lerp(
+        input logic signed [15:0] s0,
+        input logic signed [15:0] s1,
+        input logic [15:0]        frac
+    );
+        logic signed [16:0] diff;
+        logic signed [33:0] prod;
+        diff = 17'(s1) - 17'(s0);
+        prod = 34'(diff) * 34'($signed({1'b0, frac}));
+        // The result lies between s0 and s1, so it fits in 16 bits
+        arb_lerp = s0 + prod[31:16];
+    endfunction
+
+    // Deltas of block word w (1 .. 8) in slots 1 .. upto; slot 0 is the shift
+    function automatic logic signed [15:0] slot_sum(
+        input logic [15:0] word,
+        input logic        nib,
+        input logic [3:0]  w,
+        input logic [5:0]  upto
+    );
+        logic signed [15:0] sum;
+        int g;
+        sum = 16'sd0;
+        if (nib) begin
+            for (int n = 0; n < 4; n++) begin
+                g = (int'(w) - 1) * 4 + n;
+                if (g != 0 && g <= int'(upto))
+                    sum = sum + 16'($signed(word[n*4 +: 4]));
+            end
+        end else begin
+            for (int n = 0; n < 2; n++) begin
+                g = (int'(w) - 1) * 2 + n;
+                if (g != 0 && g <= int'(upto))
+                    sum = sum + 16'($signed(word[n*8 +: 8]));
+            end
+        end
+        slot_sum = sum;
+    endfunction
+
+    function automatic logic signed [15:0] delta_value(
+        input logic signed [15:0] key,
+        input logic signed [15:0] sum,
+        input logic [3:0]         shift
+    );
+        logic signed [31:0] value;
+        value = 32'(key) + ($signed(32'(sum)) <<< shift);
+        if (value > 32'sd32767)
+            delta_value = 16'sd32767;
+        else if (value < -32'sd32768)
+            delta_value = -16'sd32768;
+        else
+            delta_value = value[15:0];
+    endfunction
+
+    // Play position: index, the sample after it (0 after the last) and
+    // the fraction between them, as in WaveForms
+    logic [LEN_BITS+31:0] pos;
+    logic [LEN_BITS-1:0]  index, next;
+
+    assign pos   = (LEN_BITS+32)'(phase) * (LEN_BITS+32)'(len);
+    assign index = pos[LEN_BITS+31:32];
+    assign next  = (index == len - 1) ? '0 : index + 1'b1;
+
+    // Their blocks in the delta formats
+    logic                is_delta, is_nib, in_block;
+    logic [LEN_BITS-1:0] block_index, block_next;
+
+    assign is_delta    = (format == FMT_DELTA8 || format == FMT_DELTA4);
+    assign is_nib      = (format == FMT_DELTA4);
+    assign block_index = is_nib ? index >> 5 : index >> 4;
+    assign block_next  = is_nib ? next >> 5 : next >> 4;
+    assign in_block    = (next != '0) && (block_next == block_index);
+
+    // Taken at the start of the sample
+    logic                 clk_d = 1'b0;
+    logic                 delta, nib, same, lerp;
+    logic [5:0]           slot;
+    logic [15:0]          frac;
+    logic [ADDR_BITS-1:0] addr0, addr1;     // Index sample / block, next sample
+
+    // Read sequencer: words of addr0 first, then addr1 if needed
+    logic [3:0]           words;
+    logic [3:0]           count;
+    logic [4:0]           left = 5'd0;
+    logic                 tag_v1 = 1'b0, tag_v2 = 1'b0;   // Read in flight
+    logic [3:0]           tag_w1, tag_w2;   // ... its word of the block
+    logic                 tag_n1, tag_n2;   // ... of the next sample
+    logic                 tag_l1, tag_l2;   // ... the last one
+
+    // Decode
+    logic signed [15:0]   key, sum0, sum1, word1;
+    logic [3:0]           shift;
+    logic signed [15:0]   s0, s1;
+    logic                 fin = 1'b0, done = 1'b0;
+
+    always_ff @(posedge lut_clk) begin
+        clk_d  <= clk;
+        tag_v1 <= 1'b0;
+        if (clk && !clk_d) begin
+            delta <= is_delta;
+            nib   <= is_nib;
+            same  <= is_delta && in_block;
+            lerp  <= interp;
+            slot  <= is_nib ? {1'b0, index[4:0]} : {2'b0, index[3:0]};
+            frac  <= pos[31:16];
+            if (is_delta) begin
+                addr0 <= ADDR_BITS'(block_index * BLOCK_WORDS);
+                addr1 <= ADDR_BITS'(block_next * BLOCK_WORDS);
+            end else begin
+                addr0 <= index[ADDR_BITS-1:0];
+                addr1 <= next[ADDR_BITS-1:0];
+            end
+            words <= is_delta ? 4'(BLOCK_WORDS) : 4'd1;
+            count <= 4'd0;
+            left  <= (is_delta ? 5'(BLOCK_WORDS) : 5'd1) +
+                     ((interp && !(is_delta && in_block)) ? 5'd1 : 5'd0);
+        end else if (left != 5'd0) begin
+            if (count < words) begin
+                rd_addr <= addr0 + ADDR_BITS'(count);
+                tag_n1  <= 1'b0;
+            end else begin
+                rd_addr <= addr1;
+                tag_n1  <= 1'b1;
+            end
+            tag_v1 <= 1'b1;
+            tag_w1 <= count;
+            tag_l1 <= (left == 5'd1);
+            count  <= count + 1'b1;
+            left   <= left - 1'b1;
+        end
+
+        // rd_data now holds the word addressed two edges ago
+        tag_v2 <= tag_v1;
+        tag_w2 <= tag_w1;
+        tag_n2 <= tag_n1;
+        tag_l2 <= tag_l1;
+        if (tag_v2) begin
+            if (tag_n2) begin
+                word1 <= $signed(rd_data);
+            end else if (tag_w2 == 4'd0) begin
+                key  <= $signed(rd_data);
+                sum0 <= 16'sd0;
+                sum1 <= 16'sd0;
+            end else begin
+                if (tag_w2 == 4'd1)
+                    shift <= rd_data[3:0];
+                sum0 <= sum0 + slot_sum(rd_data, nib, tag_w2, slot);
+                sum1 <= sum1 + slot_sum(rd_data, nib, tag_w2, slot + 6'd1);
+            end
+        end
+
+        fin <= tag_v2 && tag_l2;
+        if (fin) begin
+            s0 <= delta ? delta_value(key, sum0, shift) : key;
+            s1 <= same ? delta_value(key, sum1, shift) : word1;
+        end
+
+        done <= fin;
+        if (done)
+            sample <= lerp ? arb_lerp(s0, s1, frac) : s0;
+    end
+
+endmodule
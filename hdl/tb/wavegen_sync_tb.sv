@@ -0,0 +1,367 @@
+`timescale 1ns / 1ps
+
+//////////////////////////////////////////////////////////////////////////////
+// Module: wavegen_sync_tb
+//
+// Multi-board sync testbench: two wavegen_v1_0 instances share the lut
+// clock and sample strobe (as boards sharing a reference would) and one
+// AXI bus, with `sel` choosing the board. The master's sync_out drives
+// the slave's sync_in; the master sees its own pulse through loopback.
+//
+// Tests:
+//   1. Boards started at different times run out of phase
+//   2. ARM on both + fire on the master: outputs match sample for sample,
+//      ARM is consumed, sample counters agree
+//   3. Armed (triggered) channels released together by a sync pulse
+//   4. Periodic sync pulses (SYNC_PERIOD)
+//
+// Self-checking.
+//////////////////////////////////////////////////////////////////////////////
+
+module wavegen_sync_tb;
+
+    // ====================================================================
+    // Clock, reset and sample strobe
+    // ====================================================================
+    reg clk = 0;
+    reg resetn = 0;
+
+    always #5 clk = ~clk;  // 100 MHz
+
+    localparam ADDR_WIDTH = 16;
+    localparam SAMPLE_DIV = 20;  // lut_clk cycles per sample strobe
+
+    reg en = 0;
+    integer strobe_cnt = 0;
+
+    always @(posedge clk) begin
+        strobe_cnt <= (strobe_cnt == SAMPLE_DIV - 1) ? 0 : strobe_cnt + 1;
+        en <= (strobe_cnt == 0);
+    end
+
+    // ====================================================================
+    // Shared AXI bus (valid gated by sel, ready/response muxed)
+    // ====================================================================
+    reg                   sel = 0;     // 0 = master, 1 = slave
+
+    reg  [ADDR_WIDTH-1:0] axi_awaddr;
+    reg                   axi_awvalid;
+    reg  [31:0]           axi_wdata;
+    reg  [3:0]            axi_wstrb;
+    reg                   axi_wvalid;
+    reg                   axi_bready;
+    reg  [ADDR_WIDTH-1:0] axi_araddr;
+    reg                   axi_arvalid;
+    reg                   axi_rready;
+
+    wire [1:0]  awready, wready, bvalid, arready, rvalid;
+    wire [31:0] rdata [0:1];
+
+    wire axi_awready = awready[sel];
+    wire axi_wready  = wready[sel];
+    wire axi_bvalid  = bvalid[sel];
+    wire axi_arready = arready[sel];
+    wire axi_rvalid  = rvalid[sel];
+    wire [31:0] axi_rdata = rdata[sel];
+
+    // ====================================================================
+    // Boards
+    // ====================================================================
+    wire signed [15:0] out_a [0:1];
+    wire signed [15:0] out_b [0:1];
+    wire [1:0] sync_out;
+    wire [1:0] sync_in = {sync_out[0], 1'b0};   // Master drives the slave
+
+    genvar g;
+    generate
+        for (g = 0; g < 2; g = g + 1) begin : board
+            wavegen_v1_0 #(
+                .C_S00_AXI_DATA_WIDTH(32),
+                .C_S00_AXI_ADDR_WIDTH(ADDR_WIDTH),
+                .SAMPLING_FREQUENCY(50000),
+                .ARB_WAVEFORM_DEPTH(1024)
+            ) dut (
+                .clk(clk),
+                .en(en),
+                .ext_trigger(1'b0),
+                .profile_sel(4'd0),
+                .sync_in(sync_in[g]),
+                .sync_out(sync_out[g]),
+                .out_a(out_a[g]),
+                .out_b(out_b[g]),
+                .s00_axi_aclk(clk),
+                .s00_axi_aresetn(resetn),
+                .s00_axi_awaddr(axi_awaddr),
+                .s00_axi_awprot(3'b0),
+                .s00_axi_awvalid(axi_awvalid && sel == g),
+                .s00_axi_awready(awready[g]),
+                .s00_axi_wdata(axi_wdata),
+                .s00_axi_wstrb(axi_wstrb),
+                .s00_axi_wvalid(axi_wvalid && sel == g),
+                .s00_axi_wready(wready[g]),
+                .s00_axi_bresp(),
+                .s00_axi_bvalid(bvalid[g]),
+                .s00_axi_bready(axi_bready && sel == g),
+                .s00_axi_araddr(axi_araddr),
+                .s00_axi_arprot(3'b0),
+                .s00_axi_arvalid(axi_arvalid && sel == g),
+                .s00_axi_arready(arready[g]),
+                .s00_axi_rdata(rdata[g]),
+                .s00_axi_rresp(),
+                .s00_axi_rvalid(rvalid[g]),
+                .s00_axi_rready(axi_rready && sel == g)
+            );
+        end
+    endgenerate
+
+    // ====================================================================
+    // Output comparison and sync pulse counting
+    // ====================================================================
+    reg     compare = 0;
+    integer mismatch_a = 0, mismatch_b = 0;
+    integer sync_pulses = 0;
+    reg     sync_out_d = 0;
+
+    always @(posedge clk) begin
+        if (compare && out_a[0] !== out_a[1]) mismatch_a <= mismatch_a + 1;
+        if (compare && out_b[0] !== out_b[1]) mismatch_b <= mismatch_b + 1;
+        sync_out_d <= sync_out[0];
+        if (sync_out[0] && !sync_out_d) sync_pulses <= sync_pulses + 1;
+    end
+
+    // ====================================================================
+    // Test counters
+    // ====================================================================
+    integer test_pass = 0;
+    integer test_fail = 0;
+    integer test_num  = 0;
+
+    // ====================================================================
+    // AXI tasks (board chosen by `board`)
+    // ====================================================================
+    task axi_write_word;
+        input                  board;
+        input [ADDR_WIDTH-1:0] addr;
+        input [31:0]           data;
+        begin
+            @(posedge clk);
+            sel         <= board;
+            axi_awaddr  <= addr;
+            axi_awvalid <= 1'b1;
+            axi_wdata   <= data;
+            axi_wstrb   <= 4'hF;
+            axi_wvalid  <= 1'b1;
+            axi_bready  <= 1'b1;
+
+            @(posedge clk);
+            while (!(axi_awready && axi_wready))
+                @(posedge clk);
+
+            axi_awvalid <= 1'b0;
+            axi_wvalid  <= 1'b0;
+
+            while (!axi_bvalid)
+                @(posedge clk);
+
+            axi_bready <= 1'b0;
+            @(posedge clk);
+        end
+    endtask
+
+    task axi_read;
+        input                   board;
+        input  [ADDR_WIDTH-1:0] addr;
+        output [31:0]           data;
+        begin
+            @(posedge clk);
+            sel         <= board;
+            axi_araddr  <= addr;
+            axi_arvalid <= 1'b1;
+            axi_rready  <= 1'b1;
+
+            @(posedge clk);
+            while (!axi_arready)
+                @(posedge clk);
+
+            axi_arvalid <= 1'b0;
+
+            while (!axi_rvalid)
+                @(posedge clk);
+
+            data = axi_rdata;
+            axi_rready <= 1'b0;
+            @(posedge clk);
+        end
+    endtask
+
+    task check;
+        input [31:0] expected;
+        input [31:0] actual;
+        input [255:0] msg;
+        begin
+            test_num = test_num + 1;
+            if (expected === actual) begin
+                test_pass = test_pass + 1;
+                $display("  [PASS] Test %0d: %0s (0x%08X)", test_num, msg, actual);
+            end else begin
+                test_fail = test_fail + 1;
+                $display("  [FAIL] Test %0d: %0s - Expected 0x%08X, Got 0x%08X",
+                         test_num, msg, expected, actual);
+            end
+        end
+    endtask
+
+    // Same configuration on one board: A = 1 kHz sine, B = 2 kHz sawtooth
+    task configure;
+        input board;
+        input [7:0] trig_cfg_b;
+        begin
+            axi_write_word(board, 16'h00, 32'h00000021);
+            axi_write_word(board, 16'h08, 32'h00989680);
+            axi_write_word(board, 16'h0C, 32'h01312D00);
+            axi_write_word(board, 16'h3C, {8'b0, trig_cfg_b, 16'b0});
+            axi_write_word(board, 16'h2C, 32'h00000001);
+        end
+    endtask
+
+    // ====================================================================
+    // Main test sequence
+    // ====================================================================
+    reg [31:0] read_data, cnt0, cnt1;
+
+    initial begin
+        $dumpfile("wavegen_sync_tb.vcd");
+        $dumpvars(0, wavegen_sync_tb);
+
+        axi_awaddr  = 0;
+        axi_awvalid = 0;
+        axi_wdata   = 0;
+        axi_wstrb   = 0;
+        axi_wvalid  = 0;
+        axi_bready  = 0;
+        axi_araddr  = 0;
+        axi_arvalid = 0;
+        axi_rready  = 0;
+
+        $display("\n========================================");
+        $display("Waveform Generator Multi-Board Sync Testbench");
+        $display("========================================\n");
+
+        resetn = 0;
+        repeat (10) @(posedge clk);
+        resetn = 1;
+        repeat (5) @(posedge clk);
+
+        // ============================================================
+        // Test 1: Boards started at different times
+        // ============================================================
+        $display("--- Test Group 1: Unsynchronized Start ---");
+        configure(0, 8'h00);
+        axi_write_word(0, 16'h04, 32'h00000001);
+        repeat (37 * SAMPLE_DIV) @(posedge clk);
+        configure(1, 8'h00);
+        axi_write_word(1, 16'h04, 32'h00000001);
+        repeat (5 * SAMPLE_DIV) @(posedge clk);
+
+        compare = 1;
+        repeat (50 * SAMPLE_DIV) @(posedge clk);
+        compare = 0;
+        check(32'h1, {31'b0, mismatch_a > 0}, "Outputs differ before sync");
+
+        // ============================================================
+        // Test 2: Arm both, fire from the master
+        // ============================================================
+        $display("\n--- Test Group 2: Sync Restart ---");
+        axi_write_word(0, 16'hC0, 32'h00000006);   // loopback, clear SAMPLE_CNT
+        axi_write_word(1, 16'hC0, 32'h00000004);   // clear SAMPLE_CNT
+        axi_read(0, 16'hC0, read_data);
+        check(32'h00000006, read_data, "Master SYNC_CTRL readback");
+        axi_write_word(0, 16'h7C, 32'h00000001);   // ARM channel A
+        axi_write_word(1, 16'h7C, 32'h00000001);
+        axi_read(1, 16'h7C, read_data);
+        check(32'h00000001, read_data, "Slave armed for sync");
+
+        axi_write_word(0, 16'hC0, 32'h00000007);   // Fire
+        repeat (3 * SAMPLE_DIV) @(posedge clk);
+        check(32'h1, {31'b0, sync_pulses == 1}, "One sync pulse emitted");
+        axi_read(0, 16'h7C, read_data);
+        check(32'h0, read_data, "Master ARM consumed");
+        axi_read(1, 16'h7C, read_data);
+        check(32'h0, read_data, "Slave ARM consumed");
+
+        mismatch_a = 0;
+        compare = 1;
+        repeat (200 * SAMPLE_DIV) @(posedge clk);
+        compare = 0;
+        check(32'h0, mismatch_a, "Channel A matches sample for sample");
+
+        axi_read(0, 16'h74, cnt0);
+        axi_read(1, 16'h74, cnt1);
+        check(32'h1, {31'b0, cnt1 - cnt0 <= 1}, "Sample counters agree");
+
+        // ============================================================
+        // Test 3: Armed channels released by the sync pulse
+        // ============================================================
+        $display("\n--- Test Group 3: Armed Start ---");
+        configure(0, 8'h01);
+        configure(1, 8'h01);
+        axi_write_word(0, 16'h04, 32'h00000003);
+        repeat (13 * SAMPLE_DIV) @(posedge clk);
+        axi_write_word(1, 16'h04, 32'h00000003);
+        axi_read(1, 16'h30, read_data);
+        check(32'h1, {31'b0, read_data[5]}, "Slave channel B armed");
+
+        axi_write_word(0, 16'h7C, 32'h00010000);   // ARM channel B
+        axi_write_word(1, 16'h7C, 32'h00010000);
+        axi_write_word(0, 16'hC0, 32'h00000003);   // Fire
+        repeat (3 * SAMPLE_DIV) @(posedge clk);
+        axi_read(0, 16'h30, read_data);
+        check(32'h0, {31'b0, read_data[5]}, "Master channel B released");
+        axi_read(1, 16'h30, read_data);
+        check(32'h0, {31'b0, read_data[5]}, "Slave channel B released");
+
+        mismatch_b = 0;
+        compare = 1;
+        repeat (200 * SAMPLE_DIV) @(posedge clk);
+        compare = 0;
+        check(32'h0, mismatch_b, "Channel B matches sample for sample");
+
+        // ============================================================
+        // Test 4: Periodic sync
+        // ============================================================
+        $display("\n--- Test Group 4: Periodic Sync ---");
+        axi_write_word(1, 16'h7C, 32'h00000002);   // Restart A on every sync
+        axi_write_word(0, 16'hC4, 32'd50);
+        sync_pulses = 0;
+        repeat (200 * SAMPLE_DIV) @(posedge clk);
+        axi_write_word(0, 16'hC4, 32'd0);
+        check(32'h1, {31'b0, sync_pulses >= 3 && sync_pulses <= 5}, "Pulse every 50 samples");
+        axi_read(1, 16'h7C, read_data);
+        check(32'h00000002, read_data, "EVERY is not consumed");
+
+        // ============================================================
+        // Summary
+        // ============================================================
+        $display("\n========================================");
+        $display("Test Summary: %0d passed, %0d failed out of %0d",
+                 test_pass, test_fail, test_num);
+        $display("========================================\n");
+
+        if (test_fail > 0)
+            $display("*** SOME TESTS FAILED ***");
+        else
+            $display("*** ALL TESTS PASSED ***");
+
+        $finish;
+    end
+
+    // ====================================================================
+    // Timeout watchdog
+    // ====================================================================
+    initial begin
+        #1000000;
+        $display("\n*** TIMEOUT: Simulation exceeded 1ms ***");
+        $finish;
+    end
+
+endmodule
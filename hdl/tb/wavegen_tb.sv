@@ -12,6 +12,8 @@
 //   4. Software trigger
 //   5. Soft reset
 //   6. Dual-channel operation
+//   7. Armed start with software/external trigger and latency counter
+//   8. CORDIC sine engine accuracy/latency and quadrature (I/Q) mode
 //
 // Self-checking: Verifies register readback matches written values.
 // Waveform output can be inspected visually in the waveform viewer.
@@ -30,7 +32,8 @@ module wavegen_tb;
     // ====================================================================
     // AXI signals
     // ====================================================================
-    localparam ADDR_WIDTH = 14;
+    localparam ADDR_WIDTH = 16;
+    localparam SAMPLE_DIV = 20;  // lut_clk cycles per sample strobe
 
     reg  [ADDR_WIDTH-1:0] axi_awaddr;
     reg  [2:0]            axi_awprot;
@@ -60,7 +63,25 @@ module wavegen_tb;
     // DUT outputs
     // ====================================================================
     wire signed [15:0] out_a, out_b;
-    reg en;
+    reg en = 0;
+    reg ext_trigger = 0;
+    reg [3:0] profile_sel = 4'd0;
+    reg sync_in = 0;    // Multi-board sync: see wavegen_sync_tb
+
+    // ====================================================================
+    // Sample strobe (stands in for the DAC controller's LDAC pulse)
+    // ====================================================================
+    reg sample_run = 0;
+    integer strobe_cnt = 0;
+
+    always @(posedge clk) begin
+        if (sample_run) begin
+            strobe_cnt <= (strobe_cnt == SAMPLE_DIV - 1) ? 0 : strobe_cnt + 1;
+            en <= (strobe_cnt == 0);
+        end else begin
+            en <= 1'b0;
+        end
+    end
 
     // ====================================================================
     // DUT instantiation
@@ -73,6 +94,10 @@ module wavegen_tb;
     ) dut (
         .clk(clk),
         .en(en),
+        .ext_trigger(ext_trigger),
+        .profile_sel(profile_sel),
+        .sync_in(sync_in),
+        .sync_out(),
         .out_a(out_a),
         .out_b(out_b),
         .s00_axi_aclk(clk),
@@ -98,6 +123,169 @@ module wavegen_tb;
         .s00_axi_rready(axi_rready)
     );
 
+    // ====================================================================
+    // Standalone interpolator (2 x half-band = x4) on the same strobe
+    // ====================================================================
+    reg  signed [15:0] interp_in = 16'sd0;
+    wire signed [15:0] interp_out_a, interp_out_b;
+    wire               interp_engine_clk;
+    integer            engine_edges = 0;
+
+    Interpolator #(
+        .STAGES(2)
+    ) interp (
+        .clk(clk),
+        .rst(~resetn),
+        .sample_clk(en),
+        .engine_clk(interp_engine_clk),
+        .in_a(interp_in),
+        .in_b(-interp_in),
+        .out_a(interp_out_a),
+        .out_b(interp_out_b),
+        .underflow(),
+        .overrun()
+    );
+
+    always @(posedge interp_engine_clk)
+        engine_edges <= engine_edges + 1;
+
+    // ====================================================================
+    // Parallel DAC paths on the DUT outputs: 14-bit CMOS offset binary
+    // and 12-bit DDR two's complement, both at one word pair per strobe
+    // ====================================================================
+    localparam CMOS_ZERO = 8192, CMOS_TWOPOINTFIVE = 16000;
+    localparam DDR_ZERO  = 2048, DDR_TWOPOINTFIVE  = 4000;
+
+    wire [13:0] cmos_code_a, cmos_code_b, cmos_data_a, cmos_data_b;
+    wire [11:0] ddr_code_a, ddr_code_b, ddr_data, ddr_data_b;
+    wire        cmos_clk, cmos_en, ddr_clk, ddr_en;
+
+    voltsToDACCodes #(.DAC_TWOPOINTFIVE(CMOS_TWOPOINTFIVE), .DAC_ZERO(CMOS_ZERO), .M(14))
+        cmos_cal_a (.clk(clk), .in(out_a), .calibrated(cmos_code_a));
+    voltsToDACCodes #(.DAC_TWOPOINTFIVE(CMOS_TWOPOINTFIVE), .DAC_ZERO(CMOS_ZERO), .M(14))
+        cmos_cal_b (.clk(clk), .in(out_b), .calibrated(cmos_code_b));
+
+    ParallelDAC #(
+        .WIDTH(14),
+        .CLK_DIV(SAMPLE_DIV),
+        .DDR(1'b0),
+        .TWOS_COMPLEMENT(1'b0)
+    ) cmos_dac (
+        .clk(clk),
+        .code_a(cmos_code_a),
+        .code_b(cmos_code_b),
+        .sample_en(cmos_en),
+        .dac_clk(cmos_clk),
+        .data_a(cmos_data_a),
+        .data_b(cmos_data_b)
+    );
+
+    voltsToDACCodes #(.DAC_TWOPOINTFIVE(DDR_TWOPOINTFIVE), .DAC_ZERO(DDR_ZERO), .M(12))
+        ddr_cal_a (.clk(clk), .in(out_a), .calibrated(ddr_code_a));
+    voltsToDACCodes #(.DAC_TWOPOINTFIVE(DDR_TWOPOINTFIVE), .DAC_ZERO(DDR_ZERO), .M(12))
+        ddr_cal_b (.clk(clk), .in(out_b), .calibrated(ddr_code_b));
+
+    ParallelDAC #(
+        .WIDTH(12),
+        .CLK_DIV(SAMPLE_DIV),
+        .DDR(1'b1),
+        .TWOS_COMPLEMENT(1'b1)
+    ) ddr_dac (
+        .clk(clk),
+        .code_a(ddr_code_a),
+        .code_b(ddr_code_b),
+        .sample_en(ddr_en),
+        .dac_clk(ddr_clk),
+        .data_a(ddr_data),
+        .data_b(ddr_data_b)
+    );
+
+    // ====================================================================
+    // Standalone CORDIC and LUT sine engines on the same strobe, for
+    // accuracy and latency matching
+    // ====================================================================
+    reg  [31:0] engine_phase = 32'd0;
+    reg  [31:0] engine_step  = 32'd0;
+    wire signed [15:0] cordic_sin_a, cordic_sin_b, cordic_cos_a, cordic_cos_b;
+    wire signed [15:0] lut_sin_a, lut_sin_b;
+
+    always @(posedge clk)
+        if (en) engine_phase <= engine_phase + engine_step;
+
+    SineCordic #(
+        .ITERATIONS(16),
+        .OUT_WIDTH(16)
+    ) cordic (
+        .clk(en),
+        .lut_clk(clk),
+        .en(1'b1),
+        .phase_a(engine_phase),
+        .phase_b(engine_phase + 32'h40000000),
+        .out_a(cordic_sin_a),
+        .out_b(cordic_sin_b),
+        .cos_a(cordic_cos_a),
+        .cos_b(cordic_cos_b)
+    );
+
+    SineWaves lut_sine (
+        .clk(en),
+        .lut_clk(clk),
+        .en(1'b1),
+        .phase_a(engine_phase),
+        .phase_b(engine_phase + 32'h40000000),
+        .out_a(lut_sin_a),
+        .out_b(lut_sin_b)
+    );
+
+    // The same pair on the interpolator's engine clock, which stays high
+    // for several clk cycles (INTERP_STAGES > 0 in the IP)
+    reg  [31:0] interp_phase = 32'd0;
+    wire signed [15:0] cordic_sin_i, lut_sin_i;
+
+    always @(posedge interp_engine_clk)
+        interp_phase <= interp_phase + engine_step;
+
+    SineCordic #(
+        .ITERATIONS(16),
+        .OUT_WIDTH(16)
+    ) cordic_interp (
+        .clk(interp_engine_clk),
+        .lut_clk(clk),
+        .en(1'b1),
+        .phase_a(interp_phase),
+        .phase_b(interp_phase),
+        .out_a(cordic_sin_i),
+        .out_b(),
+        .cos_a(),
+        .cos_b()
+    );
+
+    SineWaves lut_sine_interp (
+        .clk(interp_engine_clk),
+        .lut_clk(clk),
+        .en(1'b1),
+        .phase_a(interp_phase),
+        .phase_b(interp_phase),
+        .out_a(lut_sin_i),
+        .out_b()
+    );
+
+    // Reference model of the two-point calibration (offset binary)
+    function automatic integer dac_code;
+        input integer value, zero, twopointfive, bits;
+        longint scale, result;
+        begin
+            scale  = (longint'(twopointfive - zero) * 65536) / 25000;
+            result = ((scale * value) >>> 16) + zero;
+            if (result < 0)
+                dac_code = 0;
+            else if (result >= (64'sd1 <<< bits))
+                dac_code = (1 << bits) - 1;
+            else
+                dac_code = result;
+        end
+    endfunction
+
     // ====================================================================
     // Test counters
     // ====================================================================
@@ -222,7 +410,6 @@ module wavegen_tb;
         axi_arprot  = 0;
         axi_arvalid = 0;
         axi_rready  = 0;
-        en          = 0;
 
         // ============================================================
         // Reset sequence
@@ -243,38 +430,38 @@ module wavegen_tb;
         $display("--- Test Group 1: Register Access ---");
 
         // Write shadow registers
-        axi_write_word(14'h00, 32'h00000012);  // mode_a=2(SAW), mode_b=1(SINE)
-        axi_write_word(14'h08, 32'h00989680);  // freq_a = 1 kHz
-        axi_write_word(14'h0C, 32'h01312D00);  // freq_b = 2 kHz
-        axi_write_word(14'h14, 32'h7FFF7FFF);  // Both channels full amplitude
-        axi_write_word(14'h10, 32'h00000000);  // Both channels zero offset
-        axi_write_word(14'h18, 32'h80008000);  // 50% duty cycle both
+        axi_write_word(16'h00, 32'h00000012);  // mode_a=2(SAW), mode_b=1(SINE)
+        axi_write_word(16'h08, 32'h00989680);  // freq_a = 1 kHz
+        axi_write_word(16'h0C, 32'h01312D00);  // freq_b = 2 kHz
+        axi_write_word(16'h14, 32'h7FFF7FFF);  // Both channels full amplitude
+        axi_write_word(16'h10, 32'h00000000);  // Both channels zero offset
+        axi_write_word(16'h18, 32'h80008000);  // 50% duty cycle both
 
         // Apply shadows to active via RECONFIG
-        axi_write_word(14'h2C, 32'h00000001);
+        axi_write_word(16'h2C, 32'h00000001);
         repeat (5) @(posedge clk);
 
         // Now read back active registers
-        axi_read(14'h00, read_data);
+        axi_read(16'h00, read_data);
         check(32'h00000012, read_data, "MODE register (after reconfig)");
 
-        axi_read(14'h08, read_data);
+        axi_read(16'h08, read_data);
         check(32'h00989680, read_data, "FREQ_A register (after reconfig)");
 
-        axi_read(14'h0C, read_data);
+        axi_read(16'h0C, read_data);
         check(32'h01312D00, read_data, "FREQ_B register (after reconfig)");
 
-        axi_read(14'h14, read_data);
+        axi_read(16'h14, read_data);
         check(32'h7FFF7FFF, read_data, "AMPLTD register (packed)");
 
-        axi_read(14'h10, read_data);
+        axi_read(16'h10, read_data);
         check(32'h00000000, read_data, "OFFSET register (packed)");
 
-        axi_read(14'h18, read_data);
+        axi_read(16'h18, read_data);
         check(32'h80008000, read_data, "DTCYC register (packed)");
 
         // Read STATUS register
-        axi_read(14'h30, read_data);
+        axi_read(16'h30, read_data);
         $display("  [INFO] STATUS = 0x%08X (ready=%b)", read_data, read_data[0]);
 
         // ============================================================
@@ -283,17 +470,17 @@ module wavegen_tb;
         $display("\n--- Test Group 2: Dynamic Reconfiguration ---");
 
         // Configure for sine wave on channel A via shadow registers
-        axi_write_word(14'h00, 32'h00000001);  // mode_a=1(SINE)
-        axi_write_word(14'h08, 32'h00989680);  // freq_a = 1 kHz
-        axi_write_word(14'h14, 32'h7FFF7FFF);  // full amplitude both
+        axi_write_word(16'h00, 32'h00000001);  // mode_a=1(SINE)
+        axi_write_word(16'h08, 32'h00989680);  // freq_a = 1 kHz
+        axi_write_word(16'h14, 32'h7FFF7FFF);  // full amplitude both
 
         // Apply via RECONFIG
-        axi_write_word(14'h2C, 32'h00000001);  // Trigger reconfig
+        axi_write_word(16'h2C, 32'h00000001);  // Trigger reconfig
         repeat (5) @(posedge clk);
 
         // Enable and verify
-        axi_write_word(14'h04, 32'h00000003);  // Enable both channels
-        en = 1;
+        axi_write_word(16'h04, 32'h00000003);  // Enable both channels
+        sample_run = 1;
         $display("  [INFO] Reconfiguration applied, channels enabled");
 
         // ============================================================
@@ -308,8 +495,8 @@ module wavegen_tb;
         // Test 4: Mode change to square wave
         // ============================================================
         $display("\n--- Test Group 4: Square Wave ---");
-        axi_write_word(14'h00, 32'h00000044);  // mode_a=4(SQUARE), mode_b=4(SQUARE)
-        axi_write_word(14'h2C, 32'h00000001);  // Reconfig
+        axi_write_word(16'h00, 32'h00000044);  // mode_a=4(SQUARE), mode_b=4(SQUARE)
+        axi_write_word(16'h2C, 32'h00000001);  // Reconfig
         repeat (2000) @(posedge clk);
         $display("  [INFO] Square wave running, out_a = %0d", out_a);
 
@@ -317,8 +504,8 @@ module wavegen_tb;
         // Test 5: Triangle wave
         // ============================================================
         $display("\n--- Test Group 5: Triangle Wave ---");
-        axi_write_word(14'h00, 32'h00000033);  // mode=3(TRIANGLE) both
-        axi_write_word(14'h2C, 32'h00000001);
+        axi_write_word(16'h00, 32'h00000033);  // mode=3(TRIANGLE) both
+        axi_write_word(16'h2C, 32'h00000001);
         repeat (2000) @(posedge clk);
         $display("  [INFO] Triangle wave running, out_a = %0d", out_a);
 
@@ -326,8 +513,8 @@ module wavegen_tb;
         // Test 6: Sawtooth wave
         // ============================================================
         $display("\n--- Test Group 6: Sawtooth Wave ---");
-        axi_write_word(14'h00, 32'h00000022);  // mode=2(SAWTOOTH) both
-        axi_write_word(14'h2C, 32'h00000001);
+        axi_write_word(16'h00, 32'h00000022);  // mode=2(SAWTOOTH) both
+        axi_write_word(16'h2C, 32'h00000001);
         repeat (2000) @(posedge clk);
         $display("  [INFO] Sawtooth wave running, out_a = %0d", out_a);
 
@@ -335,7 +522,7 @@ module wavegen_tb;
         // Test 7: Software trigger
         // ============================================================
         $display("\n--- Test Group 7: Software Trigger ---");
-        axi_write_word(14'h34, 32'h00000003);  // Trigger both channels
+        axi_write_word(16'h34, 32'h00000003);  // Trigger both channels
         repeat (100) @(posedge clk);
         $display("  [INFO] Trigger sent, channels re-synced");
 
@@ -343,27 +530,27 @@ module wavegen_tb;
         // Test 8: Soft reset
         // ============================================================
         $display("\n--- Test Group 8: Soft Reset ---");
-        axi_write_word(14'h38, 32'h00000003);  // Reset both channels
+        axi_write_word(16'h38, 32'h00000003);  // Reset both channels
         repeat (10) @(posedge clk);
         $display("  [INFO] After soft reset: out_a = %0d, out_b = %0d", out_a, out_b);
 
         // Re-enable after reset
-        axi_write_word(14'h04, 32'h00000003);
+        axi_write_word(16'h04, 32'h00000003);
         repeat (500) @(posedge clk);
 
         // ============================================================
         // Test 9: Arbitrary waveform
         // ============================================================
         $display("\n--- Test Group 9: Arbitrary Waveform ---");
-        axi_write_word(14'h00, 32'h00000055);  // mode=5(ARB) both
-        axi_write_word(14'h24, 32'h00000010);  // depth=16 samples
-        axi_write_word(14'h2C, 32'h00000001);
+        axi_write_word(16'h00, 32'h00000055);  // mode=5(ARB) both
+        axi_write_word(16'h24, 32'h00000010);  // depth=16 samples
+        axi_write_word(16'h2C, 32'h00000001);
 
         // Load a simple ramp: 0, 2048, 4096, ..., 30720
         begin : arb_load
             integer i;
             for (i = 0; i < 16; i = i + 1) begin
-                axi_write_word(14'h28 + i * 4, i * 2048);
+                axi_write_word(16'h4000 + i * 4, i * 2048);
             end
         end
 
@@ -374,12 +561,696 @@ module wavegen_tb;
         // Test 10: Frequency change during operation
         // ============================================================
         $display("\n--- Test Group 10: Dynamic Frequency Change ---");
-        axi_write_word(14'h00, 32'h00000011);  // mode=1(SINE) both
-        axi_write_word(14'h08, 32'h02FAF080);  // 50,000,000 = 5 kHz
-        axi_write_word(14'h2C, 32'h00000001);  // Reconfig
+        axi_write_word(16'h00, 32'h00000011);  // mode=1(SINE) both
+        axi_write_word(16'h08, 32'h02FAF080);  // 50,000,000 = 5 kHz
+        axi_write_word(16'h2C, 32'h00000001);  // Reconfig
         repeat (2000) @(posedge clk);
         $display("  [INFO] 5 kHz sine wave, out_a = %0d", out_a);
 
+        // ============================================================
+        // Test 11: Armed start and trigger latency
+        // ============================================================
+        $display("\n--- Test Group 11: Armed Trigger ---");
+        // A: arm, software trigger only. B: arm, external rising edge.
+        axi_write_word(16'h3C, 32'h00030001);
+        axi_write_word(16'h2C, 32'h00000001);
+        axi_write_word(16'h04, 32'h00000000);  // Disable to re-arm
+        repeat (2 * SAMPLE_DIV) @(posedge clk);
+        axi_write_word(16'h04, 32'h00000003);
+        repeat (4 * SAMPLE_DIV) @(posedge clk);
+
+        axi_read(16'h3C, read_data);
+        check(32'h00030001, read_data, "TRIG_CFG register");
+
+        axi_read(16'h30, read_data);
+        check(32'h3, {30'b0, read_data[5:4]}, "STATUS armed bits set");
+        check(32'h0, {16'b0, out_a}, "Channel A held at zero while armed");
+
+        axi_write_word(16'h34, 32'h00000001);  // Software trigger A only
+        repeat (2 * SAMPLE_DIV) @(posedge clk);
+        axi_read(16'h30, read_data);
+        check(32'h2, {30'b0, read_data[5:4]}, "Only channel B still armed");
+
+        axi_read(16'h40, read_data);
+        check(32'h1, {31'b0, (read_data > 0 && read_data <= SAMPLE_DIV + 4)},
+              "TRIG_LAT_A within one sample period");
+
+        ext_trigger = 1;                       // External edge releases B
+        repeat (2 * SAMPLE_DIV) @(posedge clk);
+        ext_trigger = 0;
+        axi_read(16'h30, read_data);
+        check(32'h0, {30'b0, read_data[5:4]}, "External edge released B");
+
+        axi_read(16'h44, read_data);
+        check(32'h1, {31'b0, (read_data > 0 && read_data <= SAMPLE_DIV + 4)},
+              "TRIG_LAT_B within one sample period");
+
+        // Both channels on the external edge must start together
+        axi_write_word(16'h3C, 32'h00030003);
+        axi_write_word(16'h2C, 32'h00000001);
+        axi_write_word(16'h04, 32'h00000000);
+        repeat (2 * SAMPLE_DIV) @(posedge clk);
+        axi_write_word(16'h04, 32'h00000003);
+        repeat (2 * SAMPLE_DIV) @(posedge clk);
+        ext_trigger = 1;
+        repeat (2 * SAMPLE_DIV) @(posedge clk);
+        ext_trigger = 0;
+        begin : lat_compare
+            reg [31:0] lat_a;
+            axi_read(16'h40, lat_a);
+            axi_read(16'h44, read_data);
+            check(lat_a, read_data, "Both channels share trigger latency");
+        end
+
+        // Return to free-running operation
+        axi_write_word(16'h3C, 32'h00000000);
+        axi_write_word(16'h2C, 32'h00000001);
+
+        // ============================================================
+        // Test 12: Modulation
+        // ============================================================
+        $display("\n--- Test Group 12: Modulation ---");
+        axi_write_word(16'h48, 32'h00030001);  // A: AM internal, B: PM internal
+        axi_write_word(16'h4C, 32'h40007FFF);  // depth_b=0x4000, depth_a=full
+        axi_write_word(16'h50, 32'h00000000);  // LFO A at DC (m = 0)
+        axi_write_word(16'h54, 32'h00989680);  // LFO B = 1 kHz
+        axi_write_word(16'h58, 32'h00000000);
+        axi_write_word(16'h5C, 32'h000F4240);  // FM dev B (unused for PM)
+        axi_write_word(16'h00, 32'h00000044);  // SQUARE both
+        axi_write_word(16'h2C, 32'h00000001);
+        repeat (4 * SAMPLE_DIV) @(posedge clk);
+
+        axi_read(16'h48, read_data);
+        check(32'h00030001, read_data, "MOD_CFG register");
+        axi_read(16'h4C, read_data);
+        check(32'h40007FFF, read_data, "MOD_DEPTH register");
+        axi_read(16'h54, read_data);
+        check(32'h00989680, read_data, "MOD_FREQ_B register");
+        axi_read(16'h5C, read_data);
+        check(32'h000F4240, read_data, "MOD_DEV_B register");
+
+        // Full-depth AM at m = 0 halves the square wave amplitude
+        check(32'h1, {31'b0, ((out_a >= 16380 && out_a <= 16386) ||
+                              (out_a <= -16380 && out_a >= -16386))},
+              "AM full depth, m=0 halves amplitude");
+
+        // Modulation off restores the full-scale carrier
+        axi_write_word(16'h48, 32'h00000000);
+        axi_write_word(16'h2C, 32'h00000001);
+        repeat (4 * SAMPLE_DIV) @(posedge clk);
+        check(32'h1, {31'b0, (out_a >= 32760 || out_a <= -32760)},
+              "Modulation off restores full amplitude");
+
+        // ============================================================
+        // Test 13: Interpolator (standalone, x4)
+        // ============================================================
+        $display("\n--- Test Group 13: Interpolator ---");
+        interp_in = 16'sd10000;
+        repeat (128 * SAMPLE_DIV) @(posedge clk);
+        check(32'd10000, {{16{interp_out_a[15]}}, interp_out_a}, "Interpolator DC gain A");
+        check(-32'sd10000, {{16{interp_out_b[15]}}, interp_out_b}, "Interpolator DC gain B");
+
+        begin : engine_rate
+            integer edges_start;
+            edges_start = engine_edges;
+            repeat (64 * SAMPLE_DIV) @(posedge clk);
+            check(32'd16, engine_edges - edges_start, "Engine runs at 1/4 of DAC rate");
+        end
+
+        // ============================================================
+        // Test 14: Performance counters
+        // ============================================================
+        $display("\n--- Test Group 14: Performance Counters ---");
+        axi_write_word(16'h60, 32'h00000002);  // Clear
+        axi_write_word(16'h2C, 32'h00000001);  // One reconfig apply
+        repeat (100 * SAMPLE_DIV) @(posedge clk);
+        axi_write_word(16'h60, 32'h00000001);  // Snapshot
+
+        axi_read(16'h84, read_data);
+        check(32'h0, read_data, "Clock count high word");
+        axi_read(16'h80, read_data);
+        check(32'h1, {31'b0, (read_data >= 100 * SAMPLE_DIV && read_data <= 100 * SAMPLE_DIV + 100)},
+              "Clock count matches elapsed time");
+        axi_read(16'hB0, read_data);
+        check(32'h1, {31'b0, (read_data >= 100 && read_data <= 105)}, "DAC frame count");
+        axi_read(16'h88, read_data);
+        check(32'h1, {31'b0, (read_data >= 100 && read_data <= 105)}, "Channel A sample count");
+        axi_read(16'h90, read_data);
+        check(32'h1, {31'b0, (read_data >= 100 && read_data <= 105)}, "Channel B sample count");
+        axi_read(16'hB4, read_data);
+        check(32'h0, read_data, "No underflows");
+        axi_read(16'hBC, read_data);
+        check(32'h1, read_data, "Reconfig apply count");
+
+        // Snapshot is stable until the next snapshot request
+        begin : snap_hold
+            reg [31:0] snap_clk;
+            axi_read(16'h80, snap_clk);
+            repeat (10 * SAMPLE_DIV) @(posedge clk);
+            axi_read(16'h80, read_data);
+            check(snap_clk, read_data, "Snapshot holds between reads");
+        end
+
+        // ============================================================
+        // Test 15: Configuration profiles
+        // ============================================================
+        $display("\n--- Test Group 15: Profiles ---");
+        axi_read(16'h64, read_data);
+        check(32'h00080000, read_data, "PROFILE_SEL reports 8 profiles");
+
+        axi_write_word(16'hC040, 32'h00000021);  // Profile 1: mode_a=1, mode_b=2
+        axi_write_word(16'hC048, 32'h12345678);  // FREQ_A
+        axi_write_word(16'hC04C, 32'h0BADF00D);  // FREQ_B
+        axi_write_word(16'hC054, 32'h40003000);  // AMPLTD
+        axi_write_word(16'hC080, 32'h00000011);  // Profile 2: mode_a=mode_b=1
+        axi_write_word(16'hC088, 32'h00001000);
+        axi_read(16'hC048, read_data);
+        check(32'h12345678, read_data, "Profile bank readback");
+        axi_read(16'h08, read_data);
+        check(32'h1, {31'b0, read_data != 32'h12345678}, "Stored profile is not applied");
+
+        axi_write_word(16'h64, 32'h00000001);    // Select profile 1
+        axi_read(16'h00, read_data);
+        check(32'h21, read_data, "Profile 1 mode applied");
+        axi_read(16'h08, read_data);
+        check(32'h12345678, read_data, "Profile 1 FREQ_A applied");
+        axi_read(16'h0C, read_data);
+        check(32'h0BADF00D, read_data, "Profile 1 FREQ_B applied");
+        axi_read(16'h14, read_data);
+        check(32'h40003000, read_data, "Profile 1 amplitude applied");
+        axi_read(16'h64, read_data);
+        check(32'h00080001, read_data, "Active profile reads back");
+
+        // A later RECONFIG must not revert the profile (shadows loaded too)
+        axi_write_word(16'h2C, 32'h00000001);
+        axi_read(16'h08, read_data);
+        check(32'h12345678, read_data, "RECONFIG keeps applied profile");
+
+        axi_write_word(16'h64, 32'h0000000F);    // Out of range: ignored
+        axi_read(16'h64, read_data);
+        check(32'h00080001, read_data, "Out-of-range profile ignored");
+
+        // Pin select
+        profile_sel = 4'd2;
+        axi_write_word(16'h64, 32'h00000100);
+        repeat (10) @(posedge clk);
+        axi_read(16'h64, read_data);
+        check(32'h00080102, read_data, "Pins select profile 2");
+        axi_read(16'h08, read_data);
+        check(32'h00001000, read_data, "Profile 2 FREQ_A applied by pins");
+        profile_sel = 4'd1;
+        repeat (10) @(posedge clk);
+        axi_read(16'h00, read_data);
+        check(32'h21, read_data, "Pin change applies profile 1");
+        axi_write_word(16'h64, 32'h00000000);    // Back to register select
+        profile_sel = 4'd0;
+
+        // ============================================================
+        // Test 16: Timed commit
+        // ============================================================
+        $display("\n--- Test Group 16: Timed Commit ---");
+        begin : timed_commit
+            reg [31:0] cnt0, cnt1, t_commit;
+            axi_read(16'h74, cnt0);
+            repeat (10 * SAMPLE_DIV) @(posedge clk);
+            axi_read(16'h74, cnt1);
+            check(32'h1, {31'b0, (cnt1 - cnt0 >= 9 && cnt1 - cnt0 <= 11)},
+                  "Sample counter runs at the strobe rate");
+            axi_read(16'h78, read_data);
+            check(32'h0, read_data, "Sample counter high word");
+
+            // Commit 20 samples ahead
+            axi_write_word(16'h08, 32'h0000ABCD);
+            t_commit = cnt1 + 20;
+            axi_write_word(16'h6C, t_commit);
+            axi_write_word(16'h70, 32'h0);
+            axi_write_word(16'h68, 32'h00000001);
+            axi_read(16'h68, read_data);
+            check(32'h1, read_data, "Timed commit pending");
+            cnt1 = 0;
+            while (cnt1 != t_commit - 1)
+                axi_read(16'h74, cnt1);
+            axi_read(16'h08, read_data);
+            check(32'h1, {31'b0, read_data != 32'h0000ABCD}, "Not applied before timestamp");
+            while (cnt1 != t_commit)
+                axi_read(16'h74, cnt1);
+            axi_read(16'h08, read_data);
+            check(32'h0000ABCD, read_data, "Applied at timestamp");
+            axi_read(16'h68, read_data);
+            check(32'h0, read_data, "Commit done, not late");
+
+            // A timestamp in the past applies at once and reports late
+            axi_write_word(16'h08, 32'h00001234);
+            axi_write_word(16'h6C, 32'h0);
+            axi_write_word(16'h68, 32'h00000001);
+            repeat (4) @(posedge clk);
+            axi_read(16'h08, read_data);
+            check(32'h00001234, read_data, "Past timestamp applies at once");
+            axi_read(16'h68, read_data);
+            check(32'h10, read_data, "Late flag set");
+
+            // Commit at the next phase wrap of channel A
+            axi_write_word(16'h04, 32'h00000003);
+            axi_write_word(16'h08, 32'h02FAF080);  // 5 kHz: wraps every 10 samples
+            axi_write_word(16'h2C, 32'h00000001);
+            axi_write_word(16'h08, 32'h05F5E100);  // 10 kHz at the wrap
+            axi_write_word(16'h68, 32'h00000002);
+            axi_read(16'h68, read_data);
+            check(32'h2, read_data, "Wrap commit pending");
+            repeat (12 * SAMPLE_DIV) @(posedge clk);   // At least one wrap
+            axi_read(16'h68, read_data);
+            check(32'h0, read_data, "Wrap commit done");
+            axi_read(16'h08, read_data);
+            check(32'h05F5E100, read_data, "Applied at phase wrap");
+        end
+
+        // ============================================================
+        // Test 17: Noise mode
+        // ============================================================
+        $display("\n--- Test Group 17: Noise ---");
+        begin : noise
+            integer i, changes, big, sum;
+            reg signed [15:0] prev, first_run [0:7];
+            reg same;
+
+            axi_write_word(16'h00, 32'h00000066);  // NOISE both
+            axi_write_word(16'h10, 32'h00000000);
+            axi_write_word(16'h14, 32'h7FFF7FFF);
+            axi_write_word(16'h1C, 32'h00000000);
+            axi_write_word(16'h3C, 32'h00000000);
+            axi_write_word(16'h48, 32'h00000000);
+            axi_write_word(16'hC8, 32'h00000000);  // Uniform
+            axi_write_word(16'hCC, 32'h12345678);
+            axi_write_word(16'h2C, 32'h00000001);
+            axi_write_word(16'h04, 32'h00000003);
+            axi_read(16'hCC, read_data);
+            check(32'h12345678, read_data, "NOISE_SEED_A register");
+
+            // Uniform: new value every sample, about half beyond FS/2
+            changes = 0; big = 0; sum = 0; prev = out_a;
+            for (i = 0; i < 200; i = i + 1) begin
+                @(posedge en); repeat (2) @(posedge clk);
+                if (out_a != prev) changes = changes + 1;
+                if (out_a > 16384 || out_a < -16384) big = big + 1;
+                sum = sum + out_a;
+                prev = out_a;
+            end
+            check(32'h1, {31'b0, changes >= 198}, "Uniform noise changes every sample");
+            check(32'h1, {31'b0, big >= 70 && big <= 130}, "Uniform noise spread");
+            check(32'h1, {31'b0, sum / 200 < 6000 && sum / 200 > -6000}, "Uniform noise mean");
+            check(32'h1, {31'b0, out_a != out_b}, "Channels independent");
+
+            // Same seed, same sequence after a restart
+            axi_write_word(16'h04, 32'h00000000);
+            axi_write_word(16'h04, 32'h00000003);
+            for (i = 0; i < 8; i = i + 1) begin
+                @(posedge en); repeat (2) @(posedge clk);
+                first_run[i] = out_a;
+            end
+            axi_write_word(16'h04, 32'h00000000);
+            axi_write_word(16'h04, 32'h00000003);
+            same = 1;
+            for (i = 0; i < 8; i = i + 1) begin
+                @(posedge en); repeat (2) @(posedge clk);
+                if (out_a !== first_run[i]) same = 0;
+            end
+            check(32'h1, {31'b0, same}, "Seed reproduces the sequence");
+
+            // Gaussian: bell-shaped, rarely beyond FS/2 (~8%)
+            axi_write_word(16'hC8, 32'h00010001);
+            axi_write_word(16'h2C, 32'h00000001);
+            axi_read(16'hC8, read_data);
+            check(32'h00010001, read_data, "NOISE_CFG register");
+            big = 0;
+            for (i = 0; i < 200; i = i + 1) begin
+                @(posedge en); repeat (2) @(posedge clk);
+                if (out_a > 16384 || out_a < -16384) big = big + 1;
+            end
+            check(32'h1, {31'b0, big <= 40}, "Gaussian noise concentrated");
+        end
+
+        // ============================================================
+        // Test 18: ARB depth and interpolation
+        // ============================================================
+        $display("\n--- Test Group 18: ARB Depth and Interpolation ---");
+        begin : arb_depth
+            integer i, stale, lo, mid, hi, between, out_of_range;
+
+            // 3-sample table; entry 3 holds a value that must never play
+            axi_write_word(16'h4000, 32'd8000);
+            axi_write_word(16'h4004, 32'd16000);
+            axi_write_word(16'h4008, 32'd24000);
+            axi_write_word(16'h400C, 32'd30000);
+            axi_write_word(16'h00, 32'h00000055);
+            axi_write_word(16'h08, 32'd1667);      // ~10 samples per entry
+            axi_write_word(16'h24, 32'd3);
+            axi_write_word(16'hD4, 32'h00000000);
+            axi_write_word(16'h2C, 32'h00000001);
+            axi_write_word(16'h04, 32'h00000003);
+
+            stale = 0; lo = 0; mid = 0; hi = 0;
+            for (i = 0; i < 300; i = i + 1) begin
+                @(posedge en); repeat (2) @(posedge clk);
+                if (out_a > 26000) stale = stale + 1;
+                if (out_a >= 7998 && out_a <= 8000) lo = lo + 1;
+                if (out_a >= 15998 && out_a <= 16000) mid = mid + 1;
+                if (out_a >= 23998 && out_a <= 24000) hi = hi + 1;
+            end
+            check(32'h0, stale, "ARB wraps at depth 3");
+            check(32'h1, {31'b0, lo > 80 && mid > 80 && hi > 80}, "ARB plays each entry a third of the time");
+
+            // Interpolated: values between the entries, still within them
+            axi_write_word(16'hD4, 32'h00010001);
+            axi_write_word(16'h2C, 32'h00000001);
+            axi_read(16'hD4, read_data);
+            check(32'h00010001, read_data, "ARB_CFG register");
+            between = 0; out_of_range = 0;
+            for (i = 0; i < 300; i = i + 1) begin
+                @(posedge en); repeat (2) @(posedge clk);
+                if (out_a < 7998 || out_a > 24000) out_of_range = out_of_range + 1;
+                if ((out_a > 8100 && out_a < 15900) || (out_a > 16100 && out_a < 23900))
+                    between = between + 1;
+            end
+            check(32'h0, out_of_range, "Interpolated ARB stays within the table");
+            check(32'h1, {31'b0, between > 150}, "Interpolated ARB fills between entries");
+
+            axi_write_word(16'hD4, 32'h00000000);
+            axi_write_word(16'h24, 32'h00000010);
+            axi_write_word(16'h2C, 32'h00000001);
+        end
+
+        // ============================================================
+        // Test 19: Output capture
+        // ============================================================
+        $display("\n--- Test Group 19: Output Capture ---");
+        begin : capture
+            integer i, wait_cnt, pre_new, good, diff;
+            reg signed [15:0] prev, cur;
+
+            axi_read(16'hE0, read_data);
+            check(32'h04000000, read_data, "CAP_STATUS idle, depth 1024");
+
+            // DC levels: A = 1234 then 2000 around a software trigger
+            axi_write_word(16'h00, 32'h00000000);
+            axi_write_word(16'h10, 32'h0BB804D2);  // B = 3000, A = 1234
+            axi_write_word(16'h2C, 32'h00000001);
+            axi_write_word(16'h04, 32'h00000003);
+            axi_write_word(16'hDC, 32'h00000010);  // 16 pre-trigger samples
+            axi_read(16'hDC, read_data);
+            check(32'h00000010, read_data, "CAP_CFG register");
+            axi_write_word(16'hD8, 32'h00000005);  // Arm, output, software
+            repeat (24 * SAMPLE_DIV) @(posedge clk);
+            axi_read(16'hE0, read_data);
+            check(32'h1, read_data[2:0], "Capture waiting for trigger");
+            axi_write_word(16'h10, 32'h0BB807D0);  // A = 2000
+            axi_write_word(16'h2C, 32'h00000001);
+            axi_write_word(16'hD8, 32'h00000006);  // Trigger
+            wait_cnt = 0;
+            read_data = 0;
+            while (!read_data[2] && wait_cnt < 400) begin
+                repeat (4 * SAMPLE_DIV) @(posedge clk);
+                axi_read(16'hE0, read_data);
+                wait_cnt = wait_cnt + 1;
+            end
+            check(32'h4, read_data[2:0], "Capture done");
+
+            axi_read(16'h8000, read_data);
+            check(32'h0BB804D2, read_data, "Oldest sample before trigger");
+            axi_read(16'h8040, read_data);
+            check(32'h0BB807D0, read_data, "Sample 16 after trigger");
+            axi_read(16'h8FFC, read_data);
+            check(32'h0BB807D0, read_data, "Last sample");
+            pre_new = 0;
+            for (i = 0; i < 16; i = i + 1) begin
+                axi_read(16'h8000 + i * 4, read_data);
+                if (read_data != 32'h0BB804D2) pre_new = pre_new + 1;
+            end
+            check(32'h1, {31'b0, pre_new <= 1}, "Pre-trigger samples hold the old level");
+
+            // Decimation: sawtooth, every second sample
+            axi_write_word(16'h00, 32'h00000022);
+            axi_write_word(16'h08, 32'd781);       // ~512 per engine sample
+            axi_write_word(16'h10, 32'h00000000);
+            axi_write_word(16'h2C, 32'h00000001);
+            axi_write_word(16'hDC, 32'h00010000);  // Keep 1 of 2, no pre
+            axi_write_word(16'hD8, 32'h00000005);  // Arm
+            axi_write_word(16'hD8, 32'h00000006);  // Trigger
+            wait_cnt = 0;
+            read_data = 0;
+            while (!read_data[2] && wait_cnt < 800) begin
+                repeat (4 * SAMPLE_DIV) @(posedge clk);
+                axi_read(16'hE0, read_data);
+                wait_cnt = wait_cnt + 1;
+            end
+            // 2048 strobes; about 80 + 6 clocks per poll
+            check(32'h1, {31'b0, read_data[2] && wait_cnt > 400}, "Decimated capture takes 2x as long");
+            good = 0;
+            axi_read(16'h8000, read_data);
+            prev = read_data[15:0];
+            for (i = 1; i < 64; i = i + 1) begin
+                axi_read(16'h8000 + i * 4, read_data);
+                cur = read_data[15:0];
+                diff = cur - prev;
+                if (diff >= 1018 && diff <= 1028) good = good + 1;
+                prev = cur;
+            end
+            check(32'h1, {31'b0, good >= 56}, "Decimated samples two steps apart");
+        end
+
+        // ============================================================
+        // Test 20: Parallel DAC
+        // ============================================================
+        $display("\n--- Test Group 20: Parallel DAC ---");
+        begin : parallel_dac
+            integer i, t0, t1, changes;
+            reg [13:0] prev_code;
+
+            // Strobe and clock: one period per SAMPLE_DIV clocks
+            @(posedge cmos_en); t0 = $time;
+            @(posedge cmos_en); t1 = $time;
+            check(SAMPLE_DIV * 10, t1 - t0, "Sample strobe period (ns)");
+            @(posedge cmos_clk); t0 = $time;
+            @(posedge cmos_clk); t1 = $time;
+            check(SAMPLE_DIV * 10, t1 - t0, "CMOS DAC clock period (ns)");
+            @(posedge ddr_clk); t0 = $time;
+            @(negedge ddr_clk); t1 = $time;
+            check(SAMPLE_DIV * 5, t1 - t0, "DDR clock high half a period");
+
+            // DC levels: A = 1234, B = -3000
+            axi_write_word(16'h00, 32'h00000000);
+            axi_write_word(16'h10, 32'hF44804D2);
+            axi_write_word(16'h2C, 32'h00000001);
+            axi_write_word(16'h04, 32'h00000003);
+            repeat (4 * SAMPLE_DIV) @(posedge clk);
+
+            @(posedge cmos_clk);
+            check(dac_code(1234, CMOS_ZERO, CMOS_TWOPOINTFIVE, 14), cmos_data_a,
+                  "CMOS A code, offset binary");
+            check(dac_code(-3000, CMOS_ZERO, CMOS_TWOPOINTFIVE, 14), cmos_data_b,
+                  "CMOS B code, offset binary");
+            @(posedge ddr_clk);
+            check(dac_code(1234, DDR_ZERO, DDR_TWOPOINTFIVE, 12) ^ 32'h800, ddr_data,
+                  "DDR rise: A, two's complement");
+            @(negedge ddr_clk);
+            check(dac_code(-3000, DDR_ZERO, DDR_TWOPOINTFIVE, 12) ^ 32'h800, ddr_data,
+                  "DDR fall: B, two's complement");
+            check(32'h0, ddr_data_b, "DDR second bus unused");
+
+            // Zero and clamping
+            axi_write_word(16'h10, 32'h80017FFF);  // B = -32767, A = 32767
+            axi_write_word(16'h2C, 32'h00000001);
+            repeat (4 * SAMPLE_DIV) @(posedge clk);
+            @(posedge cmos_clk);
+            check(32'h3FFF, cmos_data_a, "CMOS code clamps at full scale");
+            check(32'h0000, cmos_data_b, "CMOS code clamps at zero");
+            axi_write_word(16'h10, 32'h00000000);
+            axi_write_word(16'h2C, 32'h00000001);
+            repeat (4 * SAMPLE_DIV) @(posedge clk);
+            @(posedge cmos_clk);
+            check(CMOS_ZERO, cmos_data_a, "0 V gives DAC_ZERO");
+
+            // Sine: a new word every sample
+            axi_write_word(16'h00, 32'h00000011);
+            axi_write_word(16'h08, 32'd20000000);  // 2 kHz at 50 kHz
+            axi_write_word(16'h14, 32'h7FFF7FFF);
+            axi_write_word(16'h2C, 32'h00000001);
+            repeat (4 * SAMPLE_DIV) @(posedge clk);
+            @(posedge cmos_clk);
+            prev_code = cmos_data_a;
+            changes = 0;
+            for (i = 0; i < 100; i = i + 1) begin
+                @(posedge cmos_clk);
+                if (cmos_data_a != prev_code) changes = changes + 1;
+                prev_code = cmos_data_a;
+            end
+            check(32'h1, {31'b0, changes >= 95}, "CMOS bus updates every sample");
+
+            axi_write_word(16'h04, 32'h00000000);
+            axi_write_word(16'h14, 32'h00000000);
+            axi_write_word(16'h2C, 32'h00000001);
+        end
+
+        // ============================================================
+        // Test 21: CORDIC sine engine and quadrature mode
+        // ============================================================
+        $display("\n--- Test Group 21: CORDIC and Quadrature ---");
+        begin : cordic_quad
+            integer i, good_sin, good_cos, good_b, matched, circle;
+            real    ideal, err;
+            longint mag2;
+
+            // Accuracy against $sin/$cos at fixed phases
+            engine_step = 32'd0;
+            good_sin = 0; good_cos = 0; good_b = 0;
+            for (i = 0; i < 64; i = i + 1) begin
+                engine_phase = i * 32'h0F0F0F0F + 32'h00123456;
+                repeat (4 * SAMPLE_DIV) @(posedge clk);
+                ideal = 32767.0 * $sin(6.283185307179586 * engine_phase / 4294967296.0);
+                err = cordic_sin_a - ideal;
+                if (err <= 2.5 && err >= -2.5) good_sin = good_sin + 1;
+                ideal = 32767.0 * $cos(6.283185307179586 * engine_phase / 4294967296.0);
+                err = cordic_cos_a - ideal;
+                if (err <= 2.5 && err >= -2.5) good_cos = good_cos + 1;
+                if (cordic_sin_b == cordic_cos_a)
+                    good_b = good_b + 1;
+            end
+            check(32'd64, good_sin, "CORDIC sine within 2.5 LSB");
+            check(32'd64, good_cos, "CORDIC cosine within 2.5 LSB");
+            check(32'd64, good_b, "sin(phase + 90) matches cos(phase)");
+
+            // Same latency as the LUT engine: with the phase moving
+            // 22.5 degrees per sample, a one-sample skew is ~12000 LSB
+            engine_step = 32'h10000000;
+            repeat (8 * SAMPLE_DIV) @(posedge clk);
+            matched = 0;
+            for (i = 0; i < 32; i = i + 1) begin
+                @(posedge en);
+                repeat (SAMPLE_DIV / 2) @(posedge clk);
+                if (cordic_sin_a - lut_sin_a <= 200 && cordic_sin_a - lut_sin_a >= -200)
+                    matched = matched + 1;
+            end
+            check(32'd32, matched, "CORDIC latency matches LUT engine");
+
+            // Also with an engine clock that stays high for several cycles
+            repeat (8 * 4 * SAMPLE_DIV) @(posedge clk);
+            matched = 0;
+            for (i = 0; i < 32; i = i + 1) begin
+                @(posedge interp_engine_clk);
+                repeat (2 * SAMPLE_DIV) @(posedge clk);
+                if (cordic_sin_i - lut_sin_i <= 200 && cordic_sin_i - lut_sin_i >= -200)
+                    matched = matched + 1;
+            end
+            check(32'd32, matched, "CORDIC latency matches LUT engine on a long engine clock");
+            engine_step = 32'd0;
+
+            // IP quadrature: A sine, B in mode 7 follows A 90 degrees ahead
+            axi_write_word(16'h00, 32'h00000071);
+            axi_write_word(16'h08, 32'd10000000);  // 1 kHz at 50 kHz
+            axi_write_word(16'h0C, 32'd37000000);  // B's own rate is unused
+            axi_write_word(16'h10, 32'h00000000);
+            axi_write_word(16'h14, 32'h7FFF7FFF);
+            axi_write_word(16'h2C, 32'h00000001);
+            axi_write_word(16'h04, 32'h00000003);
+            repeat (8 * SAMPLE_DIV) @(posedge clk);
+            circle = 0;
+            for (i = 0; i < 50; i = i + 1) begin
+                @(posedge en);
+                repeat (SAMPLE_DIV / 2) @(posedge clk);
+                mag2 = longint'(out_a) * out_a + longint'(out_b) * out_b;
+                if (mag2 >= 64'd1052000000 && mag2 <= 64'd1095000000)
+                    circle = circle + 1;
+            end
+            check(32'd50, circle, "A^2 + B^2 constant in quadrature");
+
+            axi_write_word(16'h04, 32'h00000000);
+            axi_write_word(16'h00, 32'h00000000);
+            axi_write_word(16'h14, 32'h00000000);
+            axi_write_word(16'h2C, 32'h00000001);
+        end
+
+        // ============================================================
+        // Test 22: Delta-coded ARB memory
+        // ============================================================
+        $display("\n--- Test Group 22: Compressed ARB ---");
+        begin : arb_delta
+            integer i, j, expect_v, matched, bad, seen_last, seen_b1, seen_sat, seen_near;
+
+            // 8-bit deltas, 20 samples over two blocks. Block 0: key 1000,
+            // shift 2, every delta +10, so sample j = 1000 + 40 * j.
+            // Block 1 (words 9-17): key -5000, shift 0, deltas -100.
+            axi_write_word(16'h4000, 32'd1000);
+            axi_write_word(16'h4004, 32'h00000A02);
+            for (i = 2; i <= 8; i = i + 1)
+                axi_write_word(16'h4000 + i * 4, 32'h00000A0A);
+            axi_write_word(16'h4024, 32'h0000EC78);
+            axi_write_word(16'h4028, 32'h00009C00);
+            axi_write_word(16'h402C, 32'h00009C9C);
+
+            axi_write_word(16'h00, 32'h00000055);
+            axi_write_word(16'h08, 32'd833);       // ~3 samples per entry
+            axi_write_word(16'h10, 32'h00000000);
+            axi_write_word(16'h14, 32'h7FFF7FFF);
+            axi_write_word(16'h24, 32'd20);
+            axi_write_word(16'hD4, 32'h00000100);
+            axi_write_word(16'h2C, 32'h00000001);
+            axi_write_word(16'h04, 32'h00000003);
+            axi_read(16'hD4, read_data);
+            check(32'h00000100, read_data, "ARB_CFG format field");
+            repeat (4) @(posedge en);
+
+            bad = 0; seen_last = 0; seen_b1 = 0;
+            for (i = 0; i < 300; i = i + 1) begin
+                @(posedge en); repeat (2) @(posedge clk);
+                matched = 0;
+                for (j = 0; j < 20; j = j + 1) begin
+                    expect_v = (j < 16) ? 1000 + 40 * j : -5000 - 100 * (j - 16);
+                    if (out_a >= expect_v - 2 && out_a <= expect_v + 2)
+                        matched = 1;
+                end
+                if (!matched) bad = bad + 1;
+                if (out_a >= 1598 && out_a <= 1602) seen_last = seen_last + 1;
+                if (out_a >= -5302 && out_a <= -5298) seen_b1 = seen_b1 + 1;
+            end
+            check(32'h0, bad, "8-bit delta ARB decodes every sample");
+            check(32'h1, {31'b0, seen_last > 0 && seen_b1 > 0},
+                  "8-bit delta ARB plays both blocks to the end");
+
+            // 4-bit deltas, one 32-sample block: key 0, shift 8, deltas
+            // +7, so sample j = 1792 * j, saturating from j = 19
+            axi_write_word(16'h4000, 32'd0);
+            axi_write_word(16'h4004, 32'h00007778);
+            for (i = 2; i <= 8; i = i + 1)
+                axi_write_word(16'h4000 + i * 4, 32'h00007777);
+            axi_write_word(16'h08, 32'd521);
+            axi_write_word(16'h24, 32'd32);
+            axi_write_word(16'hD4, 32'h00000200);
+            axi_write_word(16'h2C, 32'h00000001);
+            repeat (4) @(posedge en);
+
+            bad = 0; seen_sat = 0; seen_near = 0;
+            for (i = 0; i < 300; i = i + 1) begin
+                @(posedge en); repeat (2) @(posedge clk);
+                matched = 0;
+                for (j = 0; j < 32; j = j + 1) begin
+                    expect_v = (1792 * j > 32767) ? 32767 : 1792 * j;
+                    if (out_a >= expect_v - 2 && out_a <= expect_v + 2)
+                        matched = 1;
+                end
+                if (!matched) bad = bad + 1;
+                if (out_a >= 32765) seen_sat = seen_sat + 1;
+                if (out_a >= 32254 && out_a <= 32258) seen_near = seen_near + 1;
+            end
+            check(32'h0, bad, "4-bit delta ARB decodes every sample");
+            check(32'h1, {31'b0, seen_sat > 0 && seen_near > 0},
+                  "4-bit delta ARB saturates instead of wrapping");
+
+            axi_write_word(16'h04, 32'h00000000);
+            axi_write_word(16'h00, 32'h00000000);
+            axi_write_word(16'hD4, 32'h00000000);
+            axi_write_word(16'h24, 32'd1024);
+            axi_write_word(16'h2C, 32'h00000001);
+        end
+
         // ============================================================
         // Summary
         // ============================================================
@@ -400,8 +1271,8 @@ module wavegen_tb;
     // Timeout watchdog
     // ====================================================================
     initial begin
-        #500000;
-        $display("\n*** TIMEOUT: Simulation exceeded 500us ***");
+        #5000000;
+        $display("\n*** TIMEOUT: Simulation exceeded 5ms ***");
         $finish;
     end
 
@@ -43,6 +43,16 @@ module system_wrapper (
     // Waveform generator enable
     input  wire        EN_0,
 
+    // External trigger input
+    input  wire        EXT_TRIG_0,
+
+    // External profile select inputs
+    input  wire [3:0]  PROFILE_SEL_0,
+
+    // Multi-board sync
+    input  wire        SYNC_IN_0,
+    output wire        SYNC_OUT_0,
+
     // Waveform generator outputs
     output wire signed [15:0] OUT_A_0,
     output wire signed [15:0] OUT_B_0
@@ -68,20 +78,24 @@ module system_wrapper (
 
     wavegen_v1_0 #(
         .C_S00_AXI_DATA_WIDTH(32),
-        .C_S00_AXI_ADDR_WIDTH(14),
+        .C_S00_AXI_ADDR_WIDTH(16),
         .SAMPLING_FREQUENCY(50000),
         .ARB_WAVEFORM_DEPTH(1024)
     ) wavegen_inst (
         // User ports
         .clk(axi_clk),
         .en(EN_0),
+        .ext_trigger(EXT_TRIG_0),
+        .profile_sel(PROFILE_SEL_0),
+        .sync_in(SYNC_IN_0),
+        .sync_out(SYNC_OUT_0),
         .out_a(OUT_A_0),
         .out_b(OUT_B_0),
 
         // AXI ports - tied off in stub mode (no PS master)
         .s00_axi_aclk(axi_clk),
         .s00_axi_aresetn(axi_resetn),
-        .s00_axi_awaddr(14'b0),
+        .s00_axi_awaddr(16'b0),
         .s00_axi_awprot(3'b0),
         .s00_axi_awvalid(1'b0),
         .s00_axi_awready(),
@@ -92,7 +106,7 @@ module system_wrapper (
         .s00_axi_bresp(),
         .s00_axi_bvalid(),
         .s00_axi_bready(1'b0),
-        .s00_axi_araddr(14'b0),
+        .s00_axi_araddr(16'b0),
         .s00_axi_arprot(3'b0),
         .s00_axi_arvalid(1'b0),
         .s00_axi_arready(),
@@ -7,6 +7,16 @@
 #include <linux/uaccess.h>
 #include <linux/io.h>
 #include <linux/slab.h>
+#include <linux/mutex.h>
+#include <linux/rwsem.h>
+#include <linux/mm.h>
+#include <linux/vmalloc.h>
+#include <linux/wait.h>
+#include <linux/workqueue.h>
+#include <linux/poll.h>
+#include <linux/jiffies.h>
+#include <linux/uio.h>
+#include <linux/math64.h>
 #include "wavegen_ip.h"
 #include "wavegen_regs.h"
 
@@ -18,23 +28,963 @@ static struct cdev wavegen_cdev;
 static dev_t wavegen_dev;
 static void __iomem *wavegen_base;
 
+/*
+ * Serializes register updates: the packed registers hold both channels
+ * and are read-modify-written, so two files working on channel A and B
+ * must not interleave. Every SAMPLE_CNT read also runs under it, since
+ * the low-word read latches the high word for the next reader. Taken
+ * after wavegen_claim_sem and the stream lock, before wavegen_arb_lock.
+ */
+static DEFINE_MUTEX(wavegen_reg_lock);
+
+/*
+ * ARB content cache: the hash of each region loaded through
+ * WAVEGEN_IOCTL_LOAD_ARB_CACHED. A cached load whose region and hash
+ * match an entry returns without copying or writing the samples; any
+ * other ARB write invalidates the entries it overlaps.
+ */
+#define WAVEGEN_ARB_CACHE_ENTRIES 8
+
+struct wavegen_arb_region {
+    unsigned int start;
+    unsigned int count;
+    unsigned long long hash;
+    bool valid;
+};
+
+static DEFINE_MUTEX(wavegen_arb_lock);
+static struct wavegen_arb_region wavegen_arb_cache[WAVEGEN_ARB_CACHE_ENTRIES];
+static unsigned int wavegen_arb_victim;
+static struct wavegen_arb_cache_stats wavegen_arb_stats;
+
+/* Caller holds wavegen_arb_lock */
+static void wavegen_arb_invalidate(unsigned int start, unsigned int count)
+{
+    unsigned int i;
+
+    for (i = 0; i < WAVEGEN_ARB_CACHE_ENTRIES; i++) {
+        struct wavegen_arb_region *r = &wavegen_arb_cache[i];
+        if (r->valid && start < r->start + r->count && r->start < start + count)
+            r->valid = false;
+    }
+}
+
+/* Caller holds wavegen_arb_lock */
+static bool wavegen_arb_lookup(unsigned int start, unsigned int count,
+                               unsigned long long hash)
+{
+    unsigned int i;
+
+    for (i = 0; i < WAVEGEN_ARB_CACHE_ENTRIES; i++) {
+        struct wavegen_arb_region *r = &wavegen_arb_cache[i];
+        if (r->valid && r->start == start && r->count == count && r->hash == hash)
+            return true;
+    }
+    return false;
+}
+
+/* Caller holds wavegen_arb_lock; the region was invalidated first */
+static void wavegen_arb_insert(unsigned int start, unsigned int count,
+                               unsigned long long hash)
+{
+    struct wavegen_arb_region *r = NULL;
+    unsigned int i;
+
+    for (i = 0; i < WAVEGEN_ARB_CACHE_ENTRIES && !r; i++)
+        if (!wavegen_arb_cache[i].valid)
+            r = &wavegen_arb_cache[i];
+    if (!r) {
+        r = &wavegen_arb_cache[wavegen_arb_victim];
+        wavegen_arb_victim = (wavegen_arb_victim + 1) % WAVEGEN_ARB_CACHE_ENTRIES;
+    }
+    r->start = start;
+    r->count = count;
+    r->hash = hash;
+    r->valid = true;
+}
+
+static long wavegen_load_arb_cached(unsigned long arg)
+{
+    struct wavegen_arb_cached req;
+    struct wavegen_arb_waveform_data single;
+    struct wavegen_arb_waveform_depth depth;
+    unsigned short *kbuf = NULL;
+    unsigned int i;
+    long ret = 0;
+
+    if (copy_from_user(&req, (void __user *)arg, sizeof(req)))
+        return -EFAULT;
+    if (req.count == 0 || req.count > WAVEGEN_ARB_MAX_SAMPLES ||
+        req.start_offset > WAVEGEN_ARB_MAX_SAMPLES - req.count)
+        return -EINVAL;
+
+    mutex_lock(&wavegen_arb_lock);
+    req.hit = wavegen_arb_lookup(req.start_offset, req.count, req.hash);
+    if (req.hit) {
+        wavegen_arb_stats.hits++;
+        wavegen_arb_stats.samples_skipped += req.count;
+    } else {
+        kbuf = kmalloc_array(req.count, sizeof(*kbuf), GFP_KERNEL);
+        if (!kbuf) {
+            ret = -ENOMEM;
+            goto unlock;
+        }
+        if (copy_from_user(kbuf, (void __user *)req.data,
+                           req.count * sizeof(*kbuf))) {
+            ret = -EFAULT;
+            goto unlock;
+        }
+        /* Never cache a hash that does not describe the data */
+        if (wavegen_arb_hash(kbuf, req.count) != req.hash) {
+            ret = -EINVAL;
+            goto unlock;
+        }
+
+        for (i = 0; i < req.count; i++) {
+            single.offset = req.start_offset + i;
+            single.value = kbuf[i];
+            wavegen_ip_set_arb_data(wavegen_base, &single);
+        }
+        wavegen_arb_invalidate(req.start_offset, req.count);
+        wavegen_arb_insert(req.start_offset, req.count, req.hash);
+        wavegen_arb_stats.misses++;
+        wavegen_arb_stats.samples_written += req.count;
+    }
+
+    if (req.depth) {
+        depth.depth = req.depth;
+        wavegen_ip_set_arb_depth(wavegen_base, &depth);
+    }
+unlock:
+    mutex_unlock(&wavegen_arb_lock);
+    kfree(kbuf);
+
+    if (ret == 0 && copy_to_user((void __user *)arg, &req, sizeof(req)))
+        ret = -EFAULT;
+    return ret;
+}
+
+/*
+ * Per-open state. The command ring is allocated on the first mmap and
+ * shared with userspace; the driver keeps its own copies of the indices
+ * it produces so a corrupted header cannot make it skip or replay work.
+ */
+struct wavegen_file {
+    struct mutex lock;
+    struct wavegen_ring *ring;
+    unsigned int sq_head;
+    unsigned int cq_tail;
+    unsigned int claim_exclusive;   /* WAVEGEN_CLAIM_* held */
+    unsigned int claim_shared;
+};
+
+/*
+ * Claims (see wavegen_ip.h). Changing a claim takes wavegen_claim_sem
+ * for writing; every checked write holds it for reading, so a claim
+ * cannot be granted between the check and the register write.
+ */
+static DECLARE_RWSEM(wavegen_claim_sem);
+static unsigned int wavegen_claim_exclusive;
+static unsigned int wavegen_claim_shared[WAVEGEN_CLAIM_COUNT];
+
+/* Caller holds wavegen_claim_sem; the resources in mask wf may not write */
+static unsigned int wavegen_claim_denied(const struct wavegen_file *wf, unsigned int mask)
+{
+    unsigned int denied = 0;
+    unsigned int i;
+
+    for (i = 0; i < WAVEGEN_CLAIM_COUNT; i++) {
+        unsigned int bit = 1U << i;
+
+        if (!(mask & bit) || ((wf->claim_exclusive | wf->claim_shared) & bit))
+            continue;
+        if ((wavegen_claim_exclusive & bit) || wavegen_claim_shared[i])
+            denied |= bit;
+    }
+    return denied;
+}
+
+static unsigned int wavegen_channel_claim(unsigned int channel)
+{
+    if (channel == WAVEGEN_CHANNEL_A)
+        return WAVEGEN_CLAIM_A;
+    if (channel == WAVEGEN_CHANNEL_B)
+        return WAVEGEN_CLAIM_B;
+    return WAVEGEN_CLAIM_A | WAVEGEN_CLAIM_B;
+}
+
+/*
+ * RECONFIG on behalf of wf: it applies only what wf may write, the other
+ * owners' pending updates stay in the shadows (wavegen_ip_apply). At
+ * least one channel must be writable.
+ */
+static int wavegen_apply(const struct wavegen_file *wf)
+{
+    unsigned int both = WAVEGEN_CLAIM_A | WAVEGEN_CLAIM_B;
+    unsigned int keep = wavegen_claim_denied(wf, WAVEGEN_CLAIM_ALL);
+
+    if ((keep & both) == both)
+        return -EBUSY;
+    wavegen_ip_apply(wavegen_base, keep);
+    return 0;
+}
+
+/* Resources a raw register write of value at off changes */
+static unsigned int wavegen_reg_claims(unsigned int off, unsigned int value)
+{
+    switch (off) {
+        case WAVEGEN_FREQ_A_OFFSET:
+        case WAVEGEN_MOD_FREQ_A_OFFSET:
+        case WAVEGEN_MOD_DEV_A_OFFSET:
+        case WAVEGEN_NOISE_SEED_A_OFFSET:
+            return WAVEGEN_CLAIM_A;
+        case WAVEGEN_FREQ_B_OFFSET:
+        case WAVEGEN_MOD_FREQ_B_OFFSET:
+        case WAVEGEN_MOD_DEV_B_OFFSET:
+        case WAVEGEN_NOISE_SEED_B_OFFSET:
+            return WAVEGEN_CLAIM_B;
+        case WAVEGEN_TRIGGER_OFFSET:
+        case WAVEGEN_SOFT_RST_OFFSET:
+            /* [0] = channel A, [1] = channel B, as the claim bits */
+            return value & (WAVEGEN_CLAIM_A | WAVEGEN_CLAIM_B);
+        case WAVEGEN_MODE_OFFSET:
+        case WAVEGEN_RUN_OFFSET:
+        case WAVEGEN_OFFSET_OFFSET:
+        case WAVEGEN_AMPLTD_OFFSET:
+        case WAVEGEN_DTCYC_OFFSET:
+        case WAVEGEN_CYCLES_OFFSET:
+        case WAVEGEN_PHASE_OFFSET:
+        case WAVEGEN_TRIG_CFG_OFFSET:
+        case WAVEGEN_MOD_CFG_OFFSET:
+        case WAVEGEN_MOD_DEPTH_OFFSET:
+        case WAVEGEN_SYNC_CFG_OFFSET:
+        case WAVEGEN_NOISE_CFG_OFFSET:
+        case WAVEGEN_ARB_CFG_OFFSET:
+            return WAVEGEN_CLAIM_A | WAVEGEN_CLAIM_B;
+        case WAVEGEN_PROFILE_SEL_OFFSET:
+        case WAVEGEN_COMMIT_CTRL_OFFSET:
+            /* Load or apply both channels' settings unscoped */
+            return WAVEGEN_CLAIM_ALL;
+        default:
+            return WAVEGEN_CLAIM_DEVICE;
+    }
+}
+
+#define WAVEGEN_RING_SIZE PAGE_ALIGN(sizeof(struct wavegen_ring))
+
+/* Caller holds wavegen_claim_sem (read) and wavegen_reg_lock */
+static int wavegen_ring_exec(const struct wavegen_file *wf, const struct wavegen_sqe *sqe,
+                             unsigned int *value)
+{
+    unsigned int off = sqe->offset;
+    unsigned int arb_end = WAVEGEN_ARB_DATA_OFFSET + WAVEGEN_ARB_MAX_SAMPLES * 4;
+
+    *value = 0;
+    switch (sqe->opcode) {
+        case WAVEGEN_RING_OP_NOP:
+            return 0;
+        case WAVEGEN_RING_OP_WRITE:
+            if (off & 3)
+                return -EINVAL;
+            if (off == WAVEGEN_RECONFIG_OFFSET)
+                return wavegen_apply(wf);
+            if (wavegen_claim_denied(wf, wavegen_reg_claims(off, sqe->value)))
+                return -EBUSY;
+            if (off == WAVEGEN_PROFILE_SEL_OFFSET) {
+                struct wavegen_profile_select sel = {
+                    .index = sqe->value & WAVEGEN_PROFILE_INDEX_MASK,
+                    .pins = (sqe->value & WAVEGEN_PROFILE_PINS) ? 1 : 0,
+                };
+
+                wavegen_ip_select_profile(wavegen_base, &sel);
+            } else if (off < WAVEGEN_REG_SPAN) {
+                wavegen_ip_write_reg(wavegen_base, off, sqe->value);
+            } else if (off >= WAVEGEN_ARB_DATA_OFFSET && off < arb_end) {
+                mutex_lock(&wavegen_arb_lock);
+                iowrite32(sqe->value, wavegen_base + off);
+                wavegen_arb_invalidate((off - WAVEGEN_ARB_DATA_OFFSET) / 4, 1);
+                mutex_unlock(&wavegen_arb_lock);
+            } else {
+                return -EINVAL;
+            }
+            return 0;
+        case WAVEGEN_RING_OP_READ:
+            if ((off & 3) || off >= WAVEGEN_REG_SPAN)
+                return -EINVAL;
+            *value = ioread32(wavegen_base + off);
+            return 0;
+        case WAVEGEN_RING_OP_APPLY:
+            return wavegen_apply(wf);
+        default:
+            return -EINVAL;
+    }
+}
+
+/*
+ * Execute up to to_submit queued entries in order. Stops early when an
+ * entry needs a completion and the completion queue is full; the entry
+ * stays queued for the next submit.
+ */
+static long wavegen_ring_submit(struct wavegen_file *wf, unsigned long arg)
+{
+    struct wavegen_ring_submit req;
+    struct wavegen_ring *ring;
+    unsigned int tail, queued, done = 0;
+    long ret = 0;
+
+    if (copy_from_user(&req, (void __user *)arg, sizeof(req)))
+        return -EFAULT;
+
+    mutex_lock(&wf->lock);
+    ring = wf->ring;
+    if (!ring) {
+        ret = -ENXIO;
+        goto unlock;
+    }
+
+    tail = smp_load_acquire(&ring->sq_tail);
+    queued = tail - wf->sq_head;
+    if (queued > WAVEGEN_RING_SQ_ENTRIES) {
+        ret = -EINVAL;
+        goto unlock;
+    }
+    if (req.to_submit < queued)
+        queued = req.to_submit;
+
+    down_read(&wavegen_claim_sem);
+    mutex_lock(&wavegen_reg_lock);
+    while (done < queued) {
+        struct wavegen_sqe sqe = ring->sq[wf->sq_head & (WAVEGEN_RING_SQ_ENTRIES - 1)];
+        struct wavegen_cqe *cqe;
+        unsigned int value;
+        int result;
+        bool post = sqe.opcode == WAVEGEN_RING_OP_READ ||
+                    (sqe.flags & WAVEGEN_SQE_COMPLETE);
+
+        if (post && wf->cq_tail - READ_ONCE(ring->cq_head) >= WAVEGEN_RING_CQ_ENTRIES)
+            break;
+
+        result = wavegen_ring_exec(wf, &sqe, &value);
+        if (post || result < 0) {
+            if (wf->cq_tail - READ_ONCE(ring->cq_head) >= WAVEGEN_RING_CQ_ENTRIES) {
+                /* Error with no room to report it: consume, stop here */
+                wf->sq_head++;
+                done++;
+                ret = -EOVERFLOW;
+                break;
+            }
+            cqe = &ring->cq[wf->cq_tail & (WAVEGEN_RING_CQ_ENTRIES - 1)];
+            cqe->tag = sqe.tag;
+            cqe->result = result;
+            cqe->value = value;
+            cqe->reserved = 0;
+            wf->cq_tail++;
+        }
+        wf->sq_head++;
+        done++;
+    }
+    mutex_unlock(&wavegen_reg_lock);
+    up_read(&wavegen_claim_sem);
+
+    smp_store_release(&ring->cq_tail, wf->cq_tail);
+    smp_store_release(&ring->sq_head, wf->sq_head);
+
+    req.submitted = done;
+    if (copy_to_user((void __user *)arg, &req, sizeof(req)) && ret == 0)
+        ret = -EFAULT;
+unlock:
+    mutex_unlock(&wf->lock);
+    return ret;
+}
+
+static int wavegen_mmap(struct file *file, struct vm_area_struct *vma)
+{
+    struct wavegen_file *wf = file->private_data;
+    int ret;
+
+    if (vma->vm_pgoff != 0 || vma->vm_end - vma->vm_start != WAVEGEN_RING_SIZE)
+        return -EINVAL;
+
+    mutex_lock(&wf->lock);
+    if (!wf->ring) {
+        wf->ring = vmalloc_user(WAVEGEN_RING_SIZE);
+        if (!wf->ring) {
+            mutex_unlock(&wf->lock);
+            return -ENOMEM;
+        }
+        wf->sq_head = 0;
+        wf->cq_tail = 0;
+    }
+    ret = remap_vmalloc_range(vma, wf->ring, 0);
+    mutex_unlock(&wf->lock);
+    return ret;
+}
+
+/*
+ * Sample streaming. One stream at a time, owned by the file that started
+ * it. write() fills a kernel ring; a delayed work item moves the samples
+ * into the ARB table, which the channel plays as a circular buffer. The
+ * play position is followed from SAMPLE_CNT with the phase step the
+ * hardware uses (FREQ * (2^32 / SAMPLING_FREQUENCY)). The table is
+ * filled up to WAVEGEN_STREAM_GUARD entries behind that position, and
+ * padded with silence to WAVEGEN_STREAM_LEAD entries ahead of it when the
+ * ring runs dry, so stale samples are never replayed.
+ */
+#define WAVEGEN_STREAM_MIN_TABLE    64
+#define WAVEGEN_STREAM_GUARD(t)     ((t) / 16)
+#define WAVEGEN_STREAM_LEAD(t)      ((t) / 4)
+#define WAVEGEN_STREAM_PERIOD(t)    ((t) / 8)   /* Entries played between refills */
+
+struct wavegen_stream {
+    struct mutex lock;          /* Stream state and ARB refill */
+    struct mutex write_lock;    /* One writer copies at a time */
+    wait_queue_head_t wait;
+    struct delayed_work work;
+    struct file *owner;
+    bool running;
+
+    u16 *buf;                   /* Kernel ring */
+    unsigned int size;          /* Samples, power of two */
+    unsigned int head;          /* Free-running, advanced by write() */
+    unsigned int tail;          /* Free-running, advanced by the work */
+    unsigned int watermark;
+
+    unsigned int channel;
+    unsigned int table;
+    u32 step;                   /* Phase step per engine sample */
+    u32 phase;                  /* Channel phase, as the hardware has it */
+    u64 turns;                  /* Completed passes over the table */
+    u64 last_count;             /* SAMPLE_CNT at the last update */
+    u64 pos;                    /* Table entries played */
+    u64 fill;                   /* Table entries written */
+    unsigned int fill_index;    /* fill % table */
+    u64 data_end;               /* fill after the last stream sample */
+    bool dry;                   /* Padding with silence */
+
+    u64 pace_pos;
+    unsigned long pace_jiffies;
+    unsigned long delay;
+
+    u64 written;
+    u64 underruns;
+    u64 silence;
+};
+
+static struct wavegen_stream wavegen_stream;
+
+static unsigned int wavegen_stream_free(struct wavegen_stream *s)
+{
+    return s->size - (READ_ONCE(s->head) - smp_load_acquire(&s->tail));
+}
+
+/* Caller holds s->lock */
+static void wavegen_stream_track(struct wavegen_stream *s)
+{
+    struct wavegen_sample_count sc;
+    u64 dn, n, p;
+
+    mutex_lock(&wavegen_reg_lock);
+    wavegen_ip_get_sample_count(wavegen_base, &sc);
+    mutex_unlock(&wavegen_reg_lock);
+    /* A sync counter reset restarts SAMPLE_CNT from zero */
+    dn = sc.count >= s->last_count ? sc.count - s->last_count : sc.count;
+    s->last_count = sc.count;
+
+    while (dn) {
+        n = min_t(u64, dn, 0xFFFFFFFFULL);
+        p = s->phase + n * s->step;
+        s->turns += p >> 32;
+        s->phase = (u32)p;
+        dn -= n;
+    }
+    s->pos = s->turns * s->table + (((u64)s->phase * s->table) >> 32);
+}
+
+/* Caller holds s->lock */
+static void wavegen_stream_put(struct wavegen_stream *s, u16 sample)
+{
+    iowrite32(sample, wavegen_base + WAVEGEN_ARB_DATA_OFFSET + s->fill_index * 4);
+    s->fill++;
+    if (++s->fill_index == s->table)
+        s->fill_index = 0;
+}
+
+/*
+ * Caller holds s->lock. The table entries are written under
+ * wavegen_arb_lock and the cache entries they overlap are dropped, so a
+ * cached load never reports a hit on memory the stream has overwritten.
+ */
+static void wavegen_stream_refill(struct wavegen_stream *s)
+{
+    unsigned int head = smp_load_acquire(&s->head);
+    unsigned int tail = s->tail;
+    u64 limit = s->pos + s->table - WAVEGEN_STREAM_GUARD(s->table);
+    u64 lead = s->pos + WAVEGEN_STREAM_LEAD(s->table);
+    unsigned int first;
+    u64 start;
+
+    /* Playback caught up with the writes: skip ahead of it */
+    if (s->fill < s->pos + WAVEGEN_STREAM_GUARD(s->table)) {
+        if (!s->dry)
+            s->underruns++;
+        s->dry = true;
+        s->fill = s->pos + WAVEGEN_STREAM_GUARD(s->table);
+        div_u64_rem(s->fill, s->table, &s->fill_index);
+    }
+
+    mutex_lock(&wavegen_arb_lock);
+    start = s->fill;
+    first = s->fill_index;
+    if (head != tail) {
+        while (s->fill < limit && head != tail) {
+            wavegen_stream_put(s, s->buf[tail & (s->size - 1)]);
+            tail++;
+            s->written++;
+        }
+        s->data_end = s->fill;
+        s->dry = false;
+        smp_store_release(&s->tail, tail);
+    }
+
+    if (s->fill < lead) {
+        if (!s->dry)
+            s->underruns++;
+        s->dry = true;
+        while (s->fill < lead) {
+            wavegen_stream_put(s, 0);
+            s->silence++;
+        }
+    }
+
+    if (s->fill - start >= s->table) {
+        wavegen_arb_invalidate(0, s->table);
+    } else if (s->fill != start) {
+        unsigned int n = (unsigned int)(s->fill - start);
+
+        /* The written span may wrap past the end of the table */
+        wavegen_arb_invalidate(first, min(n, s->table - first));
+        if (n > s->table - first)
+            wavegen_arb_invalidate(0, n - (s->table - first));
+    }
+    mutex_unlock(&wavegen_arb_lock);
+}
+
+/* Caller holds s->lock; schedule the next refill a period ahead */
+static void wavegen_stream_pace(struct wavegen_stream *s)
+{
+    u64 played = s->pos - s->pace_pos;
+    unsigned long elapsed = jiffies - s->pace_jiffies;
+
+    if (played && elapsed) {
+        u64 d = div64_u64((u64)elapsed * WAVEGEN_STREAM_PERIOD(s->table), played);
+        s->delay = clamp_t(u64, d, 1, HZ / 10);
+    }
+    s->pace_pos = s->pos;
+    s->pace_jiffies += elapsed;
+}
+
+static void wavegen_stream_work(struct work_struct *work)
+{
+    struct wavegen_stream *s = container_of(to_delayed_work(work),
+                                            struct wavegen_stream, work);
+
+    mutex_lock(&s->lock);
+    if (!s->running) {
+        mutex_unlock(&s->lock);
+        return;
+    }
+    wavegen_stream_track(s);
+    wavegen_stream_refill(s);
+    wavegen_stream_pace(s);
+    schedule_delayed_work(&s->work, s->delay);
+    mutex_unlock(&s->lock);
+
+    if (wavegen_stream_free(s) >= s->watermark)
+        wake_up_interruptible(&s->wait);
+}
+
+static long wavegen_stream_start(struct file *file, unsigned long arg)
+{
+    struct wavegen_stream *s = &wavegen_stream;
+    struct wavegen_stream_config cfg;
+    struct wavegen_sample_count sc;
+    unsigned int i;
+    u32 step;
+    u16 *buf;
+
+    if (copy_from_user(&cfg, (void __user *)arg, sizeof(cfg)))
+        return -EFAULT;
+    if (!cfg.table)
+        cfg.table = WAVEGEN_STREAM_DEFAULT_TABLE;
+    if (!cfg.buffer)
+        cfg.buffer = WAVEGEN_STREAM_DEFAULT_BUFFER;
+    if (!cfg.watermark)
+        cfg.watermark = cfg.buffer / 2;
+    if (cfg.channel > WAVEGEN_CHANNEL_B || cfg.sampling_frequency == 0 ||
+        cfg.table < WAVEGEN_STREAM_MIN_TABLE || cfg.table > WAVEGEN_ARB_MAX_SAMPLES ||
+        !is_power_of_2(cfg.buffer) || cfg.buffer < cfg.table ||
+        cfg.buffer > WAVEGEN_STREAM_MAX_BUFFER || cfg.watermark > cfg.buffer)
+        return -EINVAL;
+    step = (u32)((u64)cfg.frequency * div_u64(1ULL << 32, cfg.sampling_frequency));
+    if (!step)
+        return -EINVAL;
+
+    buf = vmalloc(cfg.buffer * sizeof(*buf));
+    if (!buf)
+        return -ENOMEM;
+
+    /* The stream writes its channel and ARB memory */
+    down_read(&wavegen_claim_sem);
+    mutex_lock(&s->lock);
+    if (s->owner || wavegen_claim_denied(file->private_data,
+                                         wavegen_channel_claim(cfg.channel) |
+                                         WAVEGEN_CLAIM_DEVICE)) {
+        mutex_unlock(&s->lock);
+        up_read(&wavegen_claim_sem);
+        vfree(buf);
+        return -EBUSY;
+    }
+    s->owner = file;
+    s->buf = buf;
+    s->size = cfg.buffer;
+    s->head = 0;
+    s->tail = 0;
+    s->watermark = cfg.watermark;
+    s->channel = cfg.channel;
+    s->table = cfg.table;
+    s->step = step;
+    s->phase = 0;
+    s->turns = 0;
+    s->pos = 0;
+    s->fill = 0;
+    s->fill_index = 0;
+    s->data_end = 0;
+    s->dry = true;
+    s->written = 0;
+    s->underruns = 0;
+    s->silence = 0;
+
+    /* Start from a silent table; playback begins at entry 0 */
+    mutex_lock(&wavegen_reg_lock);
+    wavegen_ip_stream_setup(wavegen_base, cfg.channel, cfg.frequency, cfg.table,
+                            wavegen_claim_denied(file->private_data, WAVEGEN_CLAIM_ALL));
+    mutex_lock(&wavegen_arb_lock);
+    for (i = 0; i < cfg.table; i++)
+        iowrite32(0, wavegen_base + WAVEGEN_ARB_DATA_OFFSET + i * 4);
+    wavegen_arb_invalidate(0, cfg.table);
+    mutex_unlock(&wavegen_arb_lock);
+    s->fill = WAVEGEN_STREAM_LEAD(cfg.table);
+    s->fill_index = WAVEGEN_STREAM_LEAD(cfg.table);
+    s->silence = s->fill;
+
+    wavegen_ip_run_channel(wavegen_base, cfg.channel, true);
+    wavegen_ip_get_sample_count(wavegen_base, &sc);
+    mutex_unlock(&wavegen_reg_lock);
+    s->last_count = sc.count;
+    s->pace_pos = 0;
+    s->pace_jiffies = jiffies;
+    s->delay = 1;
+    s->running = true;
+    schedule_delayed_work(&s->work, s->delay);
+    mutex_unlock(&s->lock);
+    up_read(&wavegen_claim_sem);
+    return 0;
+}
+
+static long wavegen_stream_stop(struct file *file)
+{
+    struct wavegen_stream *s = &wavegen_stream;
+    u16 *buf;
+
+    mutex_lock(&s->lock);
+    if (s->owner != file || !s->running) {
+        mutex_unlock(&s->lock);
+        return -ENXIO;
+    }
+    s->running = false;
+    mutex_unlock(&s->lock);
+
+    cancel_delayed_work_sync(&s->work);
+    wake_up_interruptible(&s->wait);
+
+    /* Blocked writers see !running and leave before the ring goes */
+    mutex_lock(&s->write_lock);
+    mutex_lock(&s->lock);
+    mutex_lock(&wavegen_reg_lock);
+    wavegen_ip_run_channel(wavegen_base, s->channel, false);
+    mutex_unlock(&wavegen_reg_lock);
+    buf = s->buf;
+    s->buf = NULL;
+    s->owner = NULL;
+    mutex_unlock(&s->lock);
+    mutex_unlock(&s->write_lock);
+
+    vfree(buf);
+    return 0;
+}
+
+static long wavegen_stream_get_status(unsigned long arg)
+{
+    struct wavegen_stream *s = &wavegen_stream;
+    struct wavegen_stream_status st = { 0 };
+
+    mutex_lock(&s->lock);
+    if (s->running) {
+        wavegen_stream_track(s);
+        st.running = 1;
+        st.queued = s->head - s->tail;
+        st.ahead = s->data_end > s->pos ? (unsigned int)(s->data_end - s->pos) : 0;
+    }
+    st.written = s->written;
+    st.underruns = s->underruns;
+    st.silence = s->silence;
+    mutex_unlock(&s->lock);
+
+    if (copy_to_user((void __user *)arg, &st, sizeof(st)))
+        return -EFAULT;
+    return 0;
+}
+
+/*
+ * Queue 16-bit samples for the stream. Blocks while the ring is full
+ * (until watermark samples are free) unless O_NONBLOCK; returns what was
+ * queued when interrupted. splice() reaches this through
+ * iter_file_splice_write().
+ */
+static ssize_t wavegen_write_iter(struct kiocb *iocb, struct iov_iter *from)
+{
+    struct wavegen_stream *s = &wavegen_stream;
+    struct file *file = iocb->ki_filp;
+    size_t len = iov_iter_count(from);
+    ssize_t done = 0;
+    long ret = 0;
+
+    if (len & 1)
+        return -EINVAL;
+    if (mutex_lock_interruptible(&s->write_lock))
+        return -ERESTARTSYS;
+    if (READ_ONCE(s->owner) != file || !READ_ONCE(s->running)) {
+        ret = -ENXIO;
+        goto unlock;
+    }
+
+    while (len) {
+        unsigned int head = s->head;
+        unsigned int space = wavegen_stream_free(s);
+        unsigned int idx = head & (s->size - 1);
+        size_t n;
+
+        if (!space) {
+            if (file->f_flags & O_NONBLOCK) {
+                ret = -EAGAIN;
+                break;
+            }
+            ret = wait_event_interruptible(s->wait, !READ_ONCE(s->running) ||
+                                           wavegen_stream_free(s) >= s->watermark);
+            if (ret)
+                break;
+            if (!READ_ONCE(s->running)) {
+                ret = -ENXIO;
+                break;
+            }
+            continue;
+        }
+
+        n = min_t(size_t, min_t(size_t, space, s->size - idx), len / 2);
+        if (copy_from_iter(s->buf + idx, n * 2, from) != n * 2) {
+            ret = -EFAULT;
+            break;
+        }
+        smp_store_release(&s->head, head + n);
+        done += n * 2;
+        len -= n * 2;
+    }
+unlock:
+    mutex_unlock(&s->write_lock);
+    return done ? done : ret;
+}
+
+static __poll_t wavegen_poll(struct file *file, poll_table *wait)
+{
+    struct wavegen_stream *s = &wavegen_stream;
+
+    poll_wait(file, &s->wait, wait);
+    if (READ_ONCE(s->owner) != file || !READ_ONCE(s->running))
+        return EPOLLERR;
+    if (wavegen_stream_free(s) >= s->watermark)
+        return EPOLLOUT | EPOLLWRNORM;
+    return 0;
+}
+
+/*
+ * Grant all of req.resources or none. A claim is refused while another
+ * file holds the resource exclusively, or, for an exclusive claim, holds
+ * it at all, and while another file's stream uses it. Claiming what this
+ * file already holds changes it between shared and exclusive.
+ */
+static long wavegen_claim(struct file *file, unsigned long arg)
+{
+    struct wavegen_file *wf = file->private_data;
+    struct wavegen_stream *s = &wavegen_stream;
+    struct wavegen_claim req;
+    bool exclusive;
+    unsigned int i, in_use = 0;
+    long ret = 0;
+
+    if (copy_from_user(&req, (void __user *)arg, sizeof(req)))
+        return -EFAULT;
+    if (req.resources & ~WAVEGEN_CLAIM_ALL || req.flags & ~WAVEGEN_CLAIM_EXCLUSIVE)
+        return -EINVAL;
+    exclusive = req.flags & WAVEGEN_CLAIM_EXCLUSIVE;
+
+    down_write(&wavegen_claim_sem);
+    mutex_lock(&s->lock);
+    if (s->owner && s->owner != file) {
+        struct wavegen_file *owner = s->owner->private_data;
+        in_use = (wavegen_channel_claim(s->channel) | WAVEGEN_CLAIM_DEVICE) &
+                 ~(owner->claim_exclusive | owner->claim_shared);
+    }
+    mutex_unlock(&s->lock);
+
+    for (i = 0; i < WAVEGEN_CLAIM_COUNT; i++) {
+        unsigned int bit = 1U << i;
+        unsigned int others = wavegen_claim_shared[i] - !!(wf->claim_shared & bit);
+
+        if (!(req.resources & bit))
+            continue;
+        if (((wavegen_claim_exclusive & bit) && !(wf->claim_exclusive & bit)) ||
+            (exclusive && others) || (in_use & bit)) {
+            ret = -EBUSY;
+            goto unlock;
+        }
+    }
+
+    for (i = 0; i < WAVEGEN_CLAIM_COUNT; i++) {
+        unsigned int bit = 1U << i;
+
+        if (!(req.resources & bit))
+            continue;
+        if (exclusive) {
+            if (wf->claim_shared & bit)
+                wavegen_claim_shared[i]--;
+            wf->claim_shared &= ~bit;
+            wf->claim_exclusive |= bit;
+            wavegen_claim_exclusive |= bit;
+        } else if (!(wf->claim_shared & bit)) {
+            wf->claim_exclusive &= ~bit;
+            wavegen_claim_exclusive &= ~bit;
+            wf->claim_shared |= bit;
+            wavegen_claim_shared[i]++;
+        }
+    }
+unlock:
+    req.held_exclusive = wf->claim_exclusive;
+    req.held_shared = wf->claim_shared;
+    up_write(&wavegen_claim_sem);
+
+    if (copy_to_user((void __user *)arg, &req, sizeof(req)) && ret == 0)
+        ret = -EFAULT;
+    return ret;
+}
+
+/* Caller holds wavegen_claim_sem for writing */
+static void wavegen_unclaim_locked(struct wavegen_file *wf, unsigned int resources)
+{
+    unsigned int i;
+
+    for (i = 0; i < WAVEGEN_CLAIM_COUNT; i++) {
+        unsigned int bit = 1U << i;
+
+        if (!(resources & bit))
+            continue;
+        if (wf->claim_exclusive & bit)
+            wavegen_claim_exclusive &= ~bit;
+        if (wf->claim_shared & bit)
+            wavegen_claim_shared[i]--;
+    }
+    wf->claim_exclusive &= ~resources;
+    wf->claim_shared &= ~resources;
+}
+
+static long wavegen_unclaim(struct file *file, unsigned long arg)
+{
+    struct wavegen_file *wf = file->private_data;
+    struct wavegen_claim req;
+
+    if (copy_from_user(&req, (void __user *)arg, sizeof(req)))
+        return -EFAULT;
+    if (req.resources & ~WAVEGEN_CLAIM_ALL)
+        return -EINVAL;
+
+    down_write(&wavegen_claim_sem);
+    wavegen_unclaim_locked(wf, req.resources);
+    req.held_exclusive = wf->claim_exclusive;
+    req.held_shared = wf->claim_shared;
+    up_write(&wavegen_claim_sem);
+
+    if (copy_to_user((void __user *)arg, &req, sizeof(req)))
+        return -EFAULT;
+    return 0;
+}
+
+static long wavegen_get_claims(struct file *file, unsigned long arg)
+{
+    struct wavegen_file *wf = file->private_data;
+    struct wavegen_claim_status st;
+    unsigned int i;
+
+    down_read(&wavegen_claim_sem);
+    st.held_exclusive = wf->claim_exclusive;
+    st.held_shared = wf->claim_shared;
+    st.exclusive = wavegen_claim_exclusive;
+    for (i = 0; i < WAVEGEN_CLAIM_COUNT; i++)
+        st.shared[i] = wavegen_claim_shared[i];
+    up_read(&wavegen_claim_sem);
+
+    if (copy_to_user((void __user *)arg, &st, sizeof(st)))
+        return -EFAULT;
+    return 0;
+}
+
 static int wavegen_open(struct inode *inode, struct file *file)
 {
+    struct wavegen_file *wf;
+
+    wf = kzalloc(sizeof(*wf), GFP_KERNEL);
+    if (!wf)
+        return -ENOMEM;
+    mutex_init(&wf->lock);
+    file->private_data = wf;
     return 0;
 }
 
 static int wavegen_release(struct inode *inode, struct file *file)
 {
+    struct wavegen_file *wf = file->private_data;
+
+    if (READ_ONCE(wavegen_stream.owner) == file)
+        wavegen_stream_stop(file);
+
+    down_write(&wavegen_claim_sem);
+    wavegen_unclaim_locked(wf, WAVEGEN_CLAIM_ALL);
+    up_write(&wavegen_claim_sem);
+
+    vfree(wf->ring);
+    kfree(wf);
     return 0;
 }
 
 /*
  * IOCTL handler with proper copy_from_user/copy_to_user
  * for kernel safety. All userspace pointers are validated
- * before dereferencing.
+ * before dereferencing. Called with wavegen_claim_sem held for
+ * reading and wavegen_reg_lock held; a setter touching a resource
+ * another file has claimed fails with -EBUSY.
  */
-static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
+static long wavegen_ioctl_dev(struct file *file, unsigned int cmd, unsigned long arg)
 {
+    struct wavegen_file *wf = file->private_data;
+    unsigned int keep;
     int ret = 0;
 
     switch (cmd) {
@@ -42,6 +992,17 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_mode data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            keep = wavegen_claim_denied(wf, WAVEGEN_CLAIM_A | WAVEGEN_CLAIM_B);
+            if (keep == (WAVEGEN_CLAIM_A | WAVEGEN_CLAIM_B))
+                return -EBUSY;
+            if (keep) {
+                struct wavegen_mode cur;
+                wavegen_ip_get_mode(wavegen_base, &cur);
+                if (keep & WAVEGEN_CLAIM_A)
+                    data.channel_a = cur.channel_a;
+                else
+                    data.channel_b = cur.channel_b;
+            }
             wavegen_ip_set_mode(wavegen_base, &data);
             break;
         }
@@ -49,6 +1010,8 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_frequency data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            if (wavegen_claim_denied(wf, wavegen_channel_claim(data.channel)))
+                return -EBUSY;
             wavegen_ip_set_frequency(wavegen_base, &data);
             break;
         }
@@ -56,6 +1019,8 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_amplitude data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            if (wavegen_claim_denied(wf, wavegen_channel_claim(data.channel)))
+                return -EBUSY;
             wavegen_ip_set_amplitude(wavegen_base, &data);
             break;
         }
@@ -63,6 +1028,8 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_offset data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            if (wavegen_claim_denied(wf, wavegen_channel_claim(data.channel)))
+                return -EBUSY;
             wavegen_ip_set_offset(wavegen_base, &data);
             break;
         }
@@ -70,6 +1037,8 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_duty_cycle data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            if (wavegen_claim_denied(wf, wavegen_channel_claim(data.channel)))
+                return -EBUSY;
             wavegen_ip_set_duty_cycle(wavegen_base, &data);
             break;
         }
@@ -77,6 +1046,8 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_phase_offset data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            if (wavegen_claim_denied(wf, wavegen_channel_claim(data.channel)))
+                return -EBUSY;
             wavegen_ip_set_phase_offset(wavegen_base, &data);
             break;
         }
@@ -84,6 +1055,8 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_cycles data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            if (wavegen_claim_denied(wf, wavegen_channel_claim(data.channel)))
+                return -EBUSY;
             wavegen_ip_set_cycles(wavegen_base, &data);
             break;
         }
@@ -91,6 +1064,17 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_enable data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            keep = wavegen_claim_denied(wf, WAVEGEN_CLAIM_A | WAVEGEN_CLAIM_B);
+            if (keep == (WAVEGEN_CLAIM_A | WAVEGEN_CLAIM_B))
+                return -EBUSY;
+            if (keep) {
+                struct wavegen_enable cur;
+                wavegen_ip_get_enable(wavegen_base, &cur);
+                if (keep & WAVEGEN_CLAIM_A)
+                    data.channel_a = cur.channel_a;
+                else
+                    data.channel_b = cur.channel_b;
+            }
             wavegen_ip_enable(wavegen_base, &data);
             break;
         }
@@ -98,6 +1082,8 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_arb_waveform_depth data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_DEVICE))
+                return -EBUSY;
             wavegen_ip_set_arb_depth(wavegen_base, &data);
             break;
         }
@@ -105,7 +1091,15 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_arb_waveform_data data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            /* The ARB window ends where the capture window starts */
+            if (data.offset >= WAVEGEN_ARB_MAX_SAMPLES)
+                return -EINVAL;
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_DEVICE))
+                return -EBUSY;
+            mutex_lock(&wavegen_arb_lock);
             wavegen_ip_set_arb_data(wavegen_base, &data);
+            wavegen_arb_invalidate(data.offset, 1);
+            mutex_unlock(&wavegen_arb_lock);
             break;
         }
         case WAVEGEN_IOCTL_SET_ARB_BULK: {
@@ -117,8 +1111,11 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             if (copy_from_user(&bulk, (void __user *)arg, sizeof(bulk)))
                 return -EFAULT;
 
-            if (bulk.count == 0 || bulk.count > 4096)
+            if (bulk.count == 0 || bulk.count > WAVEGEN_ARB_MAX_SAMPLES ||
+                bulk.start_offset > WAVEGEN_ARB_MAX_SAMPLES - bulk.count)
                 return -EINVAL;
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_DEVICE))
+                return -EBUSY;
 
             kbuf = kmalloc_array(bulk.count, sizeof(unsigned int), GFP_KERNEL);
             if (!kbuf)
@@ -130,11 +1127,14 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
                 return -EFAULT;
             }
 
+            mutex_lock(&wavegen_arb_lock);
             for (i = 0; i < bulk.count; i++) {
                 single.offset = bulk.start_offset + i;
                 single.value = kbuf[i];
                 wavegen_ip_set_arb_data(wavegen_base, &single);
             }
+            wavegen_arb_invalidate(bulk.start_offset, bulk.count);
+            mutex_unlock(&wavegen_arb_lock);
 
             kfree(kbuf);
             break;
@@ -143,13 +1143,14 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_trigger data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            if (wavegen_claim_denied(wf, (data.channel_a ? WAVEGEN_CLAIM_A : 0) |
+                                         (data.channel_b ? WAVEGEN_CLAIM_B : 0)))
+                return -EBUSY;
             wavegen_ip_trigger(wavegen_base, &data);
             break;
         }
-        case WAVEGEN_IOCTL_RECONFIG: {
-            wavegen_ip_reconfig(wavegen_base);
-            break;
-        }
+        case WAVEGEN_IOCTL_RECONFIG:
+            return wavegen_apply(wf);
         case WAVEGEN_IOCTL_GET_STATUS: {
             struct wavegen_status data;
             wavegen_ip_get_status(wavegen_base, &data);
@@ -161,26 +1162,287 @@ static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg
             struct wavegen_trigger data;
             if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
                 return -EFAULT;
+            if (wavegen_claim_denied(wf, (data.channel_a ? WAVEGEN_CLAIM_A : 0) |
+                                         (data.channel_b ? WAVEGEN_CLAIM_B : 0)))
+                return -EBUSY;
             wavegen_ip_soft_reset(wavegen_base, &data);
             break;
         }
+        case WAVEGEN_IOCTL_SET_TRIGGER_CONFIG: {
+            struct wavegen_trigger_config data;
+            if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
+                return -EFAULT;
+            if (data.edge > WAVEGEN_TRIG_EDGE_BOTH)
+                return -EINVAL;
+            if (wavegen_claim_denied(wf, wavegen_channel_claim(data.channel)))
+                return -EBUSY;
+            wavegen_ip_set_trigger_config(wavegen_base, &data);
+            break;
+        }
+        case WAVEGEN_IOCTL_GET_TRIGGER_LATENCY: {
+            struct wavegen_trigger_latency data;
+            wavegen_ip_get_trigger_latency(wavegen_base, &data);
+            if (copy_to_user((void __user *)arg, &data, sizeof(data)))
+                return -EFAULT;
+            break;
+        }
+        case WAVEGEN_IOCTL_SET_MODULATION: {
+            struct wavegen_modulation data;
+            if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
+                return -EFAULT;
+            if (data.type > WAVEGEN_MOD_PM || data.depth > 0x7FFF)
+                return -EINVAL;
+            if (wavegen_claim_denied(wf, wavegen_channel_claim(data.channel)))
+                return -EBUSY;
+            wavegen_ip_set_modulation(wavegen_base, &data);
+            break;
+        }
+        case WAVEGEN_IOCTL_GET_COUNTERS: {
+            struct wavegen_counters data;
+            wavegen_ip_get_counters(wavegen_base, &data);
+            if (copy_to_user((void __user *)arg, &data, sizeof(data)))
+                return -EFAULT;
+            break;
+        }
+        case WAVEGEN_IOCTL_CLEAR_COUNTERS: {
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_DEVICE))
+                return -EBUSY;
+            wavegen_ip_clear_counters(wavegen_base);
+            break;
+        }
+        case WAVEGEN_IOCTL_LOAD_ARB_CACHED:
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_DEVICE))
+                return -EBUSY;
+            return wavegen_load_arb_cached(arg);
+        case WAVEGEN_IOCTL_GET_ARB_CACHE_STATS: {
+            struct wavegen_arb_cache_stats data;
+            mutex_lock(&wavegen_arb_lock);
+            data = wavegen_arb_stats;
+            mutex_unlock(&wavegen_arb_lock);
+            if (copy_to_user((void __user *)arg, &data, sizeof(data)))
+                return -EFAULT;
+            break;
+        }
+        case WAVEGEN_IOCTL_SET_PROFILE: {
+            struct wavegen_profile data;
+            if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
+                return -EFAULT;
+            if (data.index >= wavegen_ip_profile_count(wavegen_base))
+                return -EINVAL;
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_DEVICE))
+                return -EBUSY;
+            wavegen_ip_set_profile(wavegen_base, &data);
+            break;
+        }
+        case WAVEGEN_IOCTL_GET_PROFILE: {
+            struct wavegen_profile data;
+            if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
+                return -EFAULT;
+            if (data.index >= wavegen_ip_profile_count(wavegen_base))
+                return -EINVAL;
+            wavegen_ip_get_profile(wavegen_base, &data);
+            if (copy_to_user((void __user *)arg, &data, sizeof(data)))
+                return -EFAULT;
+            break;
+        }
+        case WAVEGEN_IOCTL_SELECT_PROFILE: {
+            struct wavegen_profile_select data;
+            if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
+                return -EFAULT;
+            if (!data.pins && data.index >= wavegen_ip_profile_count(wavegen_base))
+                return -EINVAL;
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_ALL))
+                return -EBUSY;
+            wavegen_ip_select_profile(wavegen_base, &data);
+            wavegen_ip_get_profile_select(wavegen_base, &data);
+            if (copy_to_user((void __user *)arg, &data, sizeof(data)))
+                return -EFAULT;
+            break;
+        }
+        case WAVEGEN_IOCTL_GET_PROFILE_SELECT: {
+            struct wavegen_profile_select data;
+            wavegen_ip_get_profile_select(wavegen_base, &data);
+            if (copy_to_user((void __user *)arg, &data, sizeof(data)))
+                return -EFAULT;
+            break;
+        }
+        case WAVEGEN_IOCTL_COMMIT: {
+            struct wavegen_commit data;
+            if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
+                return -EFAULT;
+            if (data.mode > WAVEGEN_COMMIT_WRAP_B)
+                return -EINVAL;
+            /* The IP applies every shadow at the commit time, not just ours */
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_ALL))
+                return -EBUSY;
+            wavegen_ip_commit(wavegen_base, &data);
+            break;
+        }
+        case WAVEGEN_IOCTL_GET_SAMPLE_COUNT: {
+            struct wavegen_sample_count data;
+            wavegen_ip_get_sample_count(wavegen_base, &data);
+            if (copy_to_user((void __user *)arg, &data, sizeof(data)))
+                return -EFAULT;
+            break;
+        }
+        case WAVEGEN_IOCTL_SET_SYNC: {
+            struct wavegen_sync data;
+            if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
+                return -EFAULT;
+            if ((data.cfg_a | data.cfg_b) & ~WAVEGEN_SYNC_CFG_MASK)
+                return -EINVAL;
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_ALL))
+                return -EBUSY;
+            wavegen_ip_set_sync(wavegen_base, &data);
+            break;
+        }
+        case WAVEGEN_IOCTL_GET_SYNC: {
+            struct wavegen_sync data;
+            wavegen_ip_get_sync(wavegen_base, &data);
+            if (copy_to_user((void __user *)arg, &data, sizeof(data)))
+                return -EFAULT;
+            break;
+        }
+        case WAVEGEN_IOCTL_SYNC_FIRE:
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_DEVICE))
+                return -EBUSY;
+            wavegen_ip_sync_fire(wavegen_base);
+            break;
+        case WAVEGEN_IOCTL_SET_NOISE: {
+            struct wavegen_noise data;
+            if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
+                return -EFAULT;
+            if (data.channel > WAVEGEN_CHANNEL_B)
+                return -EINVAL;
+            if (wavegen_claim_denied(wf, wavegen_channel_claim(data.channel)))
+                return -EBUSY;
+            wavegen_ip_set_noise(wavegen_base, &data);
+            break;
+        }
+        case WAVEGEN_IOCTL_SET_ARB_INTERP: {
+            struct wavegen_arb_interp data;
+            if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
+                return -EFAULT;
+            if (data.channel > WAVEGEN_CHANNEL_B)
+                return -EINVAL;
+            if (wavegen_claim_denied(wf, wavegen_channel_claim(data.channel)))
+                return -EBUSY;
+            wavegen_ip_set_arb_interp(wavegen_base, &data);
+            break;
+        }
+        case WAVEGEN_IOCTL_SET_ARB_FORMAT: {
+            struct wavegen_arb_format data, pending;
+            if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
+                return -EFAULT;
+            if (data.format > WAVEGEN_ARB_FMT_DELTA4)
+                return -EINVAL;
+            /* Changing the format changes both channels; keeping it is a table load */
+            wavegen_ip_get_arb_format(wavegen_base, &pending);
+            if (wavegen_claim_denied(wf, data.format == pending.format ?
+                                     WAVEGEN_CLAIM_DEVICE : WAVEGEN_CLAIM_ALL))
+                return -EBUSY;
+            wavegen_ip_set_arb_format(wavegen_base, &data);
+            break;
+        }
+        case WAVEGEN_IOCTL_CAPTURE_ARM: {
+            struct wavegen_capture_config data;
+            if (copy_from_user(&data, (void __user *)arg, sizeof(data)))
+                return -EFAULT;
+            if (data.trigger > WAVEGEN_CAP_TRIG_SYNC || data.pre_trigger > 0xFFFF ||
+                data.decimation > 0xFFFF)
+                return -EINVAL;
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_DEVICE))
+                return -EBUSY;
+            wavegen_ip_capture_arm(wavegen_base, &data);
+            break;
+        }
+        case WAVEGEN_IOCTL_CAPTURE_TRIGGER:
+            if (wavegen_claim_denied(wf, WAVEGEN_CLAIM_DEVICE))
+                return -EBUSY;
+            wavegen_ip_capture_trigger(wavegen_base);
+            break;
+        case WAVEGEN_IOCTL_GET_CAPTURE_STATUS: {
+            struct wavegen_capture_status data;
+            wavegen_ip_get_capture_status(wavegen_base, &data);
+            if (copy_to_user((void __user *)arg, &data, sizeof(data)))
+                return -EFAULT;
+            break;
+        }
+        case WAVEGEN_IOCTL_READ_CAPTURE: {
+            struct wavegen_capture_read rd;
+            struct wavegen_capture_status st;
+            u32 *kbuf;
+
+            if (copy_from_user(&rd, (void __user *)arg, sizeof(rd)))
+                return -EFAULT;
+            wavegen_ip_get_capture_status(wavegen_base, &st);
+            if (rd.count == 0 || rd.start >= st.depth || rd.count > st.depth - rd.start)
+                return -EINVAL;
+
+            kbuf = kmalloc_array(rd.count, sizeof(u32), GFP_KERNEL);
+            if (!kbuf)
+                return -ENOMEM;
+            wavegen_ip_read_capture(wavegen_base, rd.start, rd.count, kbuf);
+            if (copy_to_user((void __user *)rd.data, kbuf, rd.count * sizeof(u32)))
+                ret = -EFAULT;
+            kfree(kbuf);
+            break;
+        }
         default:
             return -EINVAL;
     }
     return ret;
 }
 
+static long wavegen_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
+{
+    long ret;
+
+    switch (cmd) {
+        case WAVEGEN_IOCTL_STREAM_START:
+            return wavegen_stream_start(file, arg);
+        case WAVEGEN_IOCTL_STREAM_STOP:
+            return wavegen_stream_stop(file);
+        case WAVEGEN_IOCTL_GET_STREAM_STATUS:
+            return wavegen_stream_get_status(arg);
+        case WAVEGEN_IOCTL_RING_SUBMIT:
+            return wavegen_ring_submit(file->private_data, arg);
+        case WAVEGEN_IOCTL_CLAIM:
+            return wavegen_claim(file, arg);
+        case WAVEGEN_IOCTL_UNCLAIM:
+            return wavegen_unclaim(file, arg);
+        case WAVEGEN_IOCTL_GET_CLAIMS:
+            return wavegen_get_claims(file, arg);
+    }
+
+    down_read(&wavegen_claim_sem);
+    mutex_lock(&wavegen_reg_lock);
+    ret = wavegen_ioctl_dev(file, cmd, arg);
+    mutex_unlock(&wavegen_reg_lock);
+    up_read(&wavegen_claim_sem);
+    return ret;
+}
+
 static struct file_operations wavegen_fops = {
     .owner          = THIS_MODULE,
     .open           = wavegen_open,
     .release        = wavegen_release,
     .unlocked_ioctl = wavegen_ioctl,
+    .mmap           = wavegen_mmap,
+    .write_iter     = wavegen_write_iter,
+    .splice_write   = iter_file_splice_write,
+    .poll           = wavegen_poll,
 };
 
 static int __init wavegen_init(void)
 {
     int ret;
 
+    mutex_init(&wavegen_stream.lock);
+    mutex_init(&wavegen_stream.write_lock);
+    init_waitqueue_head(&wavegen_stream.wait);
+    INIT_DELAYED_WORK(&wavegen_stream.work, wavegen_stream_work);
+
     ret = alloc_chrdev_region(&wavegen_dev, 0, 1, DEVICE_NAME);
     if (ret < 0) {
         pr_err("wavegen: Failed to allocate character device region\n");
@@ -213,6 +1475,7 @@ static int __init wavegen_init(void)
         ret = -ENOMEM;
         goto remove_cdev;
     }
+    wavegen_ip_image_init(wavegen_base);
 
     pr_info("wavegen: Driver initialized (base=0x%08X)\n", WAVEGEN_BASE_ADDR);
     return 0;
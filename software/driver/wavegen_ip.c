@@ -9,88 +9,221 @@
  * channel A occupies bits [15:0] and channel B occupies bits [31:16]
  * for parameters like offset, amplitude, duty cycle, etc.
  *
- * Read-modify-write pattern is used for packed registers to avoid
- * inadvertently clobbering the other channel's settings.
+ * Packed registers are built from a driver-side image of every shadowed
+ * word (and RUN) as last written, never from a readback: the IP reads
+ * back the active copy, so a read-modify-write would drop the other
+ * channel's update still waiting in the shadow. The image serves the
+ * single IP the driver maps; callers serialize as for the registers.
  */
 
+#define WAVEGEN_IMAGE_WORDS (WAVEGEN_ARB_CFG_OFFSET / 4 + 1)
+
+static u32 wavegen_image[WAVEGEN_IMAGE_WORDS];
+
+/* Shadowed words and the bits of each that belong to channel A and B */
+struct wavegen_shadow_word {
+    unsigned int offset;
+    u32 mask_a;
+    u32 mask_b;                 /* Other bits belong to the device */
+};
+
+static const struct wavegen_shadow_word wavegen_shadow_words[] = {
+    { WAVEGEN_MODE_OFFSET,          0x0000000F, 0x000000F0 },
+    { WAVEGEN_FREQ_A_OFFSET,        0xFFFFFFFF, 0x00000000 },
+    { WAVEGEN_FREQ_B_OFFSET,        0x00000000, 0xFFFFFFFF },
+    { WAVEGEN_OFFSET_OFFSET,        0x0000FFFF, 0xFFFF0000 },
+    { WAVEGEN_AMPLTD_OFFSET,        0x0000FFFF, 0xFFFF0000 },
+    { WAVEGEN_DTCYC_OFFSET,         0x0000FFFF, 0xFFFF0000 },
+    { WAVEGEN_CYCLES_OFFSET,        0x0000FFFF, 0xFFFF0000 },
+    { WAVEGEN_PHASE_OFFSET,         0x0000FFFF, 0xFFFF0000 },
+    { WAVEGEN_ARB_DEPTH_OFFSET,     0x00000000, 0x00000000 },
+    { WAVEGEN_TRIG_CFG_OFFSET,      0x0000FFFF, 0xFFFF0000 },
+    { WAVEGEN_MOD_CFG_OFFSET,       0x0000FFFF, 0xFFFF0000 },
+    { WAVEGEN_MOD_DEPTH_OFFSET,     0x0000FFFF, 0xFFFF0000 },
+    { WAVEGEN_MOD_FREQ_A_OFFSET,    0xFFFFFFFF, 0x00000000 },
+    { WAVEGEN_MOD_FREQ_B_OFFSET,    0x00000000, 0xFFFFFFFF },
+    { WAVEGEN_MOD_DEV_A_OFFSET,     0xFFFFFFFF, 0x00000000 },
+    { WAVEGEN_MOD_DEV_B_OFFSET,     0x00000000, 0xFFFFFFFF },
+    { WAVEGEN_NOISE_CFG_OFFSET,     0x0000FFFF, 0xFFFF0000 },
+    { WAVEGEN_NOISE_SEED_A_OFFSET,  0xFFFFFFFF, 0x00000000 },
+    { WAVEGEN_NOISE_SEED_B_OFFSET,  0x00000000, 0xFFFFFFFF },
+    { WAVEGEN_ARB_CFG_OFFSET,       0x000000FF, 0xFFFF0000 },
+};
+
+/* Words a profile loads into the shadow and active registers */
+static const unsigned int wavegen_profile_words[] = {
+    WAVEGEN_MODE_OFFSET, WAVEGEN_FREQ_A_OFFSET, WAVEGEN_FREQ_B_OFFSET,
+    WAVEGEN_OFFSET_OFFSET, WAVEGEN_AMPLTD_OFFSET, WAVEGEN_DTCYC_OFFSET,
+    WAVEGEN_CYCLES_OFFSET, WAVEGEN_PHASE_OFFSET,
+};
+
+/* Pins select the profile; the image holds profile wavegen_profile_seen */
+static bool wavegen_profile_pins;
+static unsigned int wavegen_profile_seen;
+
+static bool wavegen_ip_in_image(unsigned int off)
+{
+    return off / 4 < WAVEGEN_IMAGE_WORDS;
+}
+
+/* Take the profile words of the image from the active registers */
+static void wavegen_ip_profile_load(void __iomem *base)
+{
+    unsigned int i;
+
+    for (i = 0; i < ARRAY_SIZE(wavegen_profile_words); i++) {
+        unsigned int off = wavegen_profile_words[i];
+
+        wavegen_image[off / 4] = ioread32(base + off);
+    }
+}
+
+/*
+ * A profile the pins apply overwrites the shadows behind the driver's
+ * back; writing the image over it would undo it at the next RECONFIG.
+ * While the pins choose, pick up each newly applied profile first.
+ */
+static void wavegen_ip_profile_sync(void __iomem *base)
+{
+    unsigned int active;
+
+    if (!wavegen_profile_pins)
+        return;
+    active = ioread32(base + WAVEGEN_PROFILE_SEL_OFFSET) & WAVEGEN_PROFILE_INDEX_MASK;
+    if (active == wavegen_profile_seen)
+        return;
+    wavegen_ip_profile_load(base);
+    wavegen_profile_seen = active;
+}
+
+static void wavegen_ip_store(void __iomem *base, unsigned int off, u32 value)
+{
+    wavegen_image[off / 4] = value;
+    iowrite32(value, base + off);
+}
+
+/* Any register write; shadowed words (and RUN) also update the image */
+void wavegen_ip_write_reg(void __iomem *base, unsigned int off, u32 value)
+{
+    if (!wavegen_ip_in_image(off)) {
+        iowrite32(value, base + off);
+        return;
+    }
+    wavegen_ip_profile_sync(base);
+    wavegen_ip_store(base, off, value);
+}
+
+/* Replace the bits in mask of an imaged word */
+static void wavegen_ip_update(void __iomem *base, unsigned int off, u32 mask, u32 bits)
+{
+    wavegen_ip_profile_sync(base);
+    wavegen_ip_store(base, off, (wavegen_image[off / 4] & ~mask) | (bits & mask));
+}
+
+/* Half of a packed word that belongs to channel (none if invalid) */
+static u32 wavegen_ip_half(unsigned int channel)
+{
+    if (channel == WAVEGEN_CHANNEL_A)
+        return 0x0000FFFF;
+    if (channel == WAVEGEN_CHANNEL_B)
+        return 0xFFFF0000;
+    return 0;
+}
+
+static void wavegen_ip_set_half(void __iomem *base, unsigned int off,
+                                unsigned int channel, u32 value)
+{
+    u32 half = value & 0xFFFF;
+
+    wavegen_ip_update(base, off, wavegen_ip_half(channel), half | (half << 16));
+}
+
+/*
+ * Start the image from the active registers and write them back to the
+ * shadows, so the two agree. Updates left pending in the shadows before
+ * the driver was loaded are dropped.
+ */
+void wavegen_ip_image_init(void __iomem *base)
+{
+    u32 sel = ioread32(base + WAVEGEN_PROFILE_SEL_OFFSET);
+    unsigned int i;
+
+    wavegen_profile_pins = (sel & WAVEGEN_PROFILE_PINS) != 0;
+    wavegen_profile_seen = sel & WAVEGEN_PROFILE_INDEX_MASK;
+    wavegen_image[WAVEGEN_RUN_OFFSET / 4] = ioread32(base + WAVEGEN_RUN_OFFSET);
+    for (i = 0; i < ARRAY_SIZE(wavegen_shadow_words); i++) {
+        unsigned int off = wavegen_shadow_words[i].offset;
+
+        wavegen_ip_write_reg(base, off, ioread32(base + off));
+    }
+}
+
 void wavegen_ip_set_mode(void __iomem *base, struct wavegen_mode *mode)
 {
     u32 val = ((mode->channel_b & 0xF) << 4) | (mode->channel_a & 0xF);
-    iowrite32(val, base + WAVEGEN_MODE_OFFSET);
+    wavegen_ip_write_reg(base, WAVEGEN_MODE_OFFSET, val);
+}
+
+/* Modes as last written, including a change not yet applied */
+void wavegen_ip_get_mode(void __iomem *base, struct wavegen_mode *mode)
+{
+    u32 val;
+
+    wavegen_ip_profile_sync(base);
+    val = wavegen_image[WAVEGEN_MODE_OFFSET / 4];
+    mode->channel_a = val & 0xF;
+    mode->channel_b = (val >> 4) & 0xF;
 }
 
 void wavegen_ip_set_frequency(void __iomem *base, struct wavegen_frequency *freq)
 {
     if (freq->channel == WAVEGEN_CHANNEL_A)
-        iowrite32(freq->value, base + WAVEGEN_FREQ_A_OFFSET);
+        wavegen_ip_write_reg(base, WAVEGEN_FREQ_A_OFFSET, freq->value);
     else if (freq->channel == WAVEGEN_CHANNEL_B)
-        iowrite32(freq->value, base + WAVEGEN_FREQ_B_OFFSET);
+        wavegen_ip_write_reg(base, WAVEGEN_FREQ_B_OFFSET, freq->value);
 }
 
 void wavegen_ip_set_amplitude(void __iomem *base, struct wavegen_amplitude *amp)
 {
-    u32 reg = ioread32(base + WAVEGEN_AMPLTD_OFFSET);
-    if (amp->channel == WAVEGEN_CHANNEL_A) {
-        reg = (reg & 0xFFFF0000) | (amp->value & 0xFFFF);
-    } else if (amp->channel == WAVEGEN_CHANNEL_B) {
-        reg = (reg & 0x0000FFFF) | ((amp->value & 0xFFFF) << 16);
-    }
-    iowrite32(reg, base + WAVEGEN_AMPLTD_OFFSET);
+    wavegen_ip_set_half(base, WAVEGEN_AMPLTD_OFFSET, amp->channel, amp->value);
 }
 
 void wavegen_ip_set_offset(void __iomem *base, struct wavegen_offset *offset)
 {
-    u32 reg = ioread32(base + WAVEGEN_OFFSET_OFFSET);
-    if (offset->channel == WAVEGEN_CHANNEL_A) {
-        reg = (reg & 0xFFFF0000) | (offset->value & 0xFFFF);
-    } else if (offset->channel == WAVEGEN_CHANNEL_B) {
-        reg = (reg & 0x0000FFFF) | ((offset->value & 0xFFFF) << 16);
-    }
-    iowrite32(reg, base + WAVEGEN_OFFSET_OFFSET);
+    wavegen_ip_set_half(base, WAVEGEN_OFFSET_OFFSET, offset->channel, offset->value);
 }
 
 void wavegen_ip_set_duty_cycle(void __iomem *base, struct wavegen_duty_cycle *dc)
 {
-    u32 reg = ioread32(base + WAVEGEN_DTCYC_OFFSET);
-    if (dc->channel == WAVEGEN_CHANNEL_A) {
-        reg = (reg & 0xFFFF0000) | (dc->value & 0xFFFF);
-    } else if (dc->channel == WAVEGEN_CHANNEL_B) {
-        reg = (reg & 0x0000FFFF) | ((dc->value & 0xFFFF) << 16);
-    }
-    iowrite32(reg, base + WAVEGEN_DTCYC_OFFSET);
+    wavegen_ip_set_half(base, WAVEGEN_DTCYC_OFFSET, dc->channel, dc->value);
 }
 
 void wavegen_ip_set_phase_offset(void __iomem *base, struct wavegen_phase_offset *po)
 {
-    u32 reg = ioread32(base + WAVEGEN_PHASE_OFFSET);
-    if (po->channel == WAVEGEN_CHANNEL_A) {
-        reg = (reg & 0xFFFF0000) | (po->value & 0xFFFF);
-    } else if (po->channel == WAVEGEN_CHANNEL_B) {
-        reg = (reg & 0x0000FFFF) | ((po->value & 0xFFFF) << 16);
-    }
-    iowrite32(reg, base + WAVEGEN_PHASE_OFFSET);
+    wavegen_ip_set_half(base, WAVEGEN_PHASE_OFFSET, po->channel, po->value);
 }
 
 void wavegen_ip_set_cycles(void __iomem *base, struct wavegen_cycles *cyc)
 {
-    u32 reg = ioread32(base + WAVEGEN_CYCLES_OFFSET);
-    if (cyc->channel == WAVEGEN_CHANNEL_A) {
-        reg = (reg & 0xFFFF0000) | (cyc->value & 0xFFFF);
-    } else if (cyc->channel == WAVEGEN_CHANNEL_B) {
-        reg = (reg & 0x0000FFFF) | ((cyc->value & 0xFFFF) << 16);
-    }
-    iowrite32(reg, base + WAVEGEN_CYCLES_OFFSET);
+    wavegen_ip_set_half(base, WAVEGEN_CYCLES_OFFSET, cyc->channel, cyc->value);
 }
 
 void wavegen_ip_enable(void __iomem *base, struct wavegen_enable *en)
 {
     u32 val = ((en->channel_b & 0x1) << 1) | (en->channel_a & 0x1);
-    iowrite32(val, base + WAVEGEN_RUN_OFFSET);
+    wavegen_ip_write_reg(base, WAVEGEN_RUN_OFFSET, val);
+}
+
+void wavegen_ip_get_enable(void __iomem *base, struct wavegen_enable *en)
+{
+    u32 val = wavegen_image[WAVEGEN_RUN_OFFSET / 4];
+    en->channel_a = val & 0x1;
+    en->channel_b = (val >> 1) & 0x1;
 }
 
 void wavegen_ip_set_arb_depth(void __iomem *base, struct wavegen_arb_waveform_depth *d)
 {
-    iowrite32(d->depth, base + WAVEGEN_ARB_DEPTH_OFFSET);
+    wavegen_ip_write_reg(base, WAVEGEN_ARB_DEPTH_OFFSET, d->depth);
 }
 
 void wavegen_ip_set_arb_data(void __iomem *base, struct wavegen_arb_waveform_data *d)
@@ -109,6 +242,45 @@ void wavegen_ip_reconfig(void __iomem *base)
     iowrite32(1, base + WAVEGEN_RECONFIG_OFFSET);
 }
 
+/*
+ * RECONFIG on behalf of a caller that may not write the resources in
+ * keep (WAVEGEN_CLAIM_* bits). The IP applies every shadow at once, so
+ * the kept bits of each shadow are set to their active values for the
+ * apply and the image is written back afterwards: those updates stay
+ * pending for their owner's own apply.
+ */
+void wavegen_ip_apply(void __iomem *base, unsigned int keep)
+{
+    unsigned int i;
+
+    wavegen_ip_profile_sync(base);
+    if (!keep) {
+        wavegen_ip_reconfig(base);
+        return;
+    }
+
+    for (i = 0; i < ARRAY_SIZE(wavegen_shadow_words); i++) {
+        const struct wavegen_shadow_word *w = &wavegen_shadow_words[i];
+        u32 mask = ((keep & WAVEGEN_CLAIM_A) ? w->mask_a : 0) |
+                   ((keep & WAVEGEN_CLAIM_B) ? w->mask_b : 0) |
+                   ((keep & WAVEGEN_CLAIM_DEVICE) ? ~(w->mask_a | w->mask_b) : 0);
+        u32 pending = wavegen_image[w->offset / 4];
+
+        if (mask)
+            iowrite32((pending & ~mask) | (ioread32(base + w->offset) & mask),
+                      base + w->offset);
+    }
+    wavegen_ip_reconfig(base);
+    /* The copy happens the cycle after the write; this read completes later */
+    ioread32(base + WAVEGEN_STATUS_OFFSET);
+
+    for (i = 0; i < ARRAY_SIZE(wavegen_shadow_words); i++) {
+        unsigned int off = wavegen_shadow_words[i].offset;
+
+        iowrite32(wavegen_image[off / 4], base + off);
+    }
+}
+
 void wavegen_ip_get_status(void __iomem *base, struct wavegen_status *st)
 {
     u32 raw = ioread32(base + WAVEGEN_STATUS_OFFSET);
@@ -117,10 +289,299 @@ void wavegen_ip_get_status(void __iomem *base, struct wavegen_status *st)
     st->reconfig_busy = (raw >> 1) & 1;
     st->channel_a_running = (raw >> 2) & 1;
     st->channel_b_running = (raw >> 3) & 1;
+    st->channel_a_armed = (raw >> 4) & 1;
+    st->channel_b_armed = (raw >> 5) & 1;
 }
 
 void wavegen_ip_soft_reset(void __iomem *base, struct wavegen_trigger *rst)
 {
     u32 val = ((rst->channel_b & 0x1) << 1) | (rst->channel_a & 0x1);
     iowrite32(val, base + WAVEGEN_SOFT_RST_OFFSET);
+}
+
+void wavegen_ip_set_trigger_config(void __iomem *base, struct wavegen_trigger_config *tc)
+{
+    u32 cfg = (tc->arm ? WAVEGEN_TRIG_ARM : 0) |
+              (tc->external ? WAVEGEN_TRIG_EXT_EN : 0) |
+              ((tc->edge & 0x3) << WAVEGEN_TRIG_EDGE_SHIFT);
+
+    wavegen_ip_set_half(base, WAVEGEN_TRIG_CFG_OFFSET, tc->channel, cfg);
+}
+
+void wavegen_ip_get_trigger_latency(void __iomem *base, struct wavegen_trigger_latency *lat)
+{
+    lat->channel_a = ioread32(base + WAVEGEN_TRIG_LAT_A_OFFSET);
+    lat->channel_b = ioread32(base + WAVEGEN_TRIG_LAT_B_OFFSET);
+}
+
+void wavegen_ip_set_modulation(void __iomem *base, struct wavegen_modulation *mod)
+{
+    u32 cfg = (mod->type & WAVEGEN_MOD_TYPE_MASK) |
+              (mod->source ? WAVEGEN_MOD_SRC_OTHER : 0);
+    u32 depth = mod->depth & 0x7FFF;
+    if (mod->channel == WAVEGEN_CHANNEL_A) {
+        wavegen_ip_write_reg(base, WAVEGEN_MOD_FREQ_A_OFFSET, mod->frequency);
+        wavegen_ip_write_reg(base, WAVEGEN_MOD_DEV_A_OFFSET, mod->deviation);
+    } else if (mod->channel == WAVEGEN_CHANNEL_B) {
+        wavegen_ip_write_reg(base, WAVEGEN_MOD_FREQ_B_OFFSET, mod->frequency);
+        wavegen_ip_write_reg(base, WAVEGEN_MOD_DEV_B_OFFSET, mod->deviation);
+    }
+    wavegen_ip_set_half(base, WAVEGEN_MOD_CFG_OFFSET, mod->channel, cfg);
+    wavegen_ip_set_half(base, WAVEGEN_MOD_DEPTH_OFFSET, mod->channel, depth);
+}
+
+static u64 wavegen_ip_read64(void __iomem *base, u32 offset)
+{
+    u64 lo = ioread32(base + offset);
+    u64 hi = ioread32(base + offset + 4);
+    return (hi << 32) | lo;
+}
+
+void wavegen_ip_get_counters(void __iomem *base, struct wavegen_counters *cnt)
+{
+    /* Latch all counters so the reads below are coherent */
+    iowrite32(WAVEGEN_CNT_SNAPSHOT, base + WAVEGEN_CNT_CTRL_OFFSET);
+
+    cnt->clk_count       = wavegen_ip_read64(base, WAVEGEN_CNT_CLK_OFFSET);
+    cnt->samples_a       = wavegen_ip_read64(base, WAVEGEN_CNT_SAMPLES_A_OFFSET);
+    cnt->samples_b       = wavegen_ip_read64(base, WAVEGEN_CNT_SAMPLES_B_OFFSET);
+    cnt->since_trigger_a = wavegen_ip_read64(base, WAVEGEN_CNT_SINCE_TRIG_A_OFFSET);
+    cnt->since_trigger_b = wavegen_ip_read64(base, WAVEGEN_CNT_SINCE_TRIG_B_OFFSET);
+    cnt->cycles_a   = ioread32(base + WAVEGEN_CNT_CYCLES_A_OFFSET);
+    cnt->cycles_b   = ioread32(base + WAVEGEN_CNT_CYCLES_B_OFFSET);
+    cnt->dac_frames = ioread32(base + WAVEGEN_CNT_DAC_FRAMES_OFFSET);
+    cnt->underflows = ioread32(base + WAVEGEN_CNT_UNDERFLOW_OFFSET);
+    cnt->overruns   = ioread32(base + WAVEGEN_CNT_OVERRUN_OFFSET);
+    cnt->reconfigs  = ioread32(base + WAVEGEN_CNT_RECONFIG_OFFSET);
+}
+
+void wavegen_ip_clear_counters(void __iomem *base)
+{
+    iowrite32(WAVEGEN_CNT_CLEAR, base + WAVEGEN_CNT_CTRL_OFFSET);
+}
+
+unsigned int wavegen_ip_profile_count(void __iomem *base)
+{
+    return (ioread32(base + WAVEGEN_PROFILE_SEL_OFFSET) >>
+            WAVEGEN_PROFILE_COUNT_SHIFT) & 0xFF;
+}
+
+void wavegen_ip_set_profile(void __iomem *base, struct wavegen_profile *p)
+{
+    void __iomem *bank = base + WAVEGEN_PROFILE_OFFSET +
+                         p->index * WAVEGEN_PROFILE_STRIDE;
+
+    iowrite32(p->mode & 0xFF, bank + WAVEGEN_MODE_OFFSET);
+    iowrite32(p->freq_a, bank + WAVEGEN_FREQ_A_OFFSET);
+    iowrite32(p->freq_b, bank + WAVEGEN_FREQ_B_OFFSET);
+    iowrite32(p->offset, bank + WAVEGEN_OFFSET_OFFSET);
+    iowrite32(p->amplitude, bank + WAVEGEN_AMPLTD_OFFSET);
+    iowrite32(p->duty_cycle, bank + WAVEGEN_DTCYC_OFFSET);
+    iowrite32(p->cycles, bank + WAVEGEN_CYCLES_OFFSET);
+    iowrite32(p->phase, bank + WAVEGEN_PHASE_OFFSET);
+}
+
+void wavegen_ip_get_profile(void __iomem *base, struct wavegen_profile *p)
+{
+    void __iomem *bank = base + WAVEGEN_PROFILE_OFFSET +
+                         p->index * WAVEGEN_PROFILE_STRIDE;
+
+    p->mode       = ioread32(bank + WAVEGEN_MODE_OFFSET);
+    p->freq_a     = ioread32(bank + WAVEGEN_FREQ_A_OFFSET);
+    p->freq_b     = ioread32(bank + WAVEGEN_FREQ_B_OFFSET);
+    p->offset     = ioread32(bank + WAVEGEN_OFFSET_OFFSET);
+    p->amplitude  = ioread32(bank + WAVEGEN_AMPLTD_OFFSET);
+    p->duty_cycle = ioread32(bank + WAVEGEN_DTCYC_OFFSET);
+    p->cycles     = ioread32(bank + WAVEGEN_CYCLES_OFFSET);
+    p->phase      = ioread32(bank + WAVEGEN_PHASE_OFFSET);
+}
+
+/*
+ * A profile loads its words into the shadow and active registers, so the
+ * image takes them from the readback. Once the pins choose, the first
+ * pin profile is applied within a few cycles of the write; later ones
+ * are picked up by wavegen_ip_profile_sync().
+ */
+void wavegen_ip_select_profile(void __iomem *base, struct wavegen_profile_select *sel)
+{
+    /* One write applies the whole profile to both channels in the IP */
+    iowrite32(sel->pins ? WAVEGEN_PROFILE_PINS
+                        : (sel->index & WAVEGEN_PROFILE_INDEX_MASK),
+              base + WAVEGEN_PROFILE_SEL_OFFSET);
+    ioread32(base + WAVEGEN_STATUS_OFFSET);     /* Profile applied by now */
+    wavegen_ip_profile_load(base);
+    wavegen_profile_pins = sel->pins != 0;
+    wavegen_profile_seen = ioread32(base + WAVEGEN_PROFILE_SEL_OFFSET) &
+                           WAVEGEN_PROFILE_INDEX_MASK;
+}
+
+void wavegen_ip_get_profile_select(void __iomem *base, struct wavegen_profile_select *sel)
+{
+    u32 reg = ioread32(base + WAVEGEN_PROFILE_SEL_OFFSET);
+
+    sel->index = reg & WAVEGEN_PROFILE_INDEX_MASK;
+    sel->pins  = (reg & WAVEGEN_PROFILE_PINS) ? 1 : 0;
+    sel->count = (reg >> WAVEGEN_PROFILE_COUNT_SHIFT) & 0xFF;
+}
+
+void wavegen_ip_commit(void __iomem *base, struct wavegen_commit *c)
+{
+    if (c->mode == WAVEGEN_COMMIT_AT) {
+        /*
+         * Disarm first: a commit still pending from an earlier call would
+         * otherwise compare against a half-written time between the two
+         * word writes and could fire early.
+         */
+        iowrite32(WAVEGEN_COMMIT_NONE, base + WAVEGEN_COMMIT_CTRL_OFFSET);
+        iowrite32((u32)c->sample, base + WAVEGEN_COMMIT_TIME_LO_OFFSET);
+        iowrite32((u32)(c->sample >> 32), base + WAVEGEN_COMMIT_TIME_HI_OFFSET);
+    }
+    /* Arming last: the timestamp is complete before it is compared */
+    iowrite32(c->mode & WAVEGEN_COMMIT_MODE_MASK, base + WAVEGEN_COMMIT_CTRL_OFFSET);
+}
+
+/* Callers serialize: a read between our lo and hi reads re-latches hi */
+void wavegen_ip_get_sample_count(void __iomem *base, struct wavegen_sample_count *sc)
+{
+    u64 lo = ioread32(base + WAVEGEN_SAMPLE_CNT_LO_OFFSET);    /* latches hi */
+    u64 hi = ioread32(base + WAVEGEN_SAMPLE_CNT_HI_OFFSET);
+    u32 ctrl = ioread32(base + WAVEGEN_COMMIT_CTRL_OFFSET);
+
+    sc->count = (hi << 32) | lo;
+    sc->commit_pending = ctrl & WAVEGEN_COMMIT_MODE_MASK;
+    sc->commit_late = (ctrl & WAVEGEN_COMMIT_LATE) ? 1 : 0;
+}
+
+void wavegen_ip_set_sync(void __iomem *base, struct wavegen_sync *s)
+{
+    u32 ctrl = (s->loopback ? WAVEGEN_SYNC_CTRL_LOOPBACK : 0) |
+               (s->reset_count ? WAVEGEN_SYNC_CTRL_CNT_RESET : 0);
+
+    /* Role and period first, so an armed channel only sees the new setup */
+    iowrite32(ctrl, base + WAVEGEN_SYNC_CTRL_OFFSET);
+    iowrite32(s->period, base + WAVEGEN_SYNC_PERIOD_OFFSET);
+    iowrite32((s->cfg_a & WAVEGEN_SYNC_CFG_MASK) |
+              ((s->cfg_b & WAVEGEN_SYNC_CFG_MASK) << WAVEGEN_SYNC_CFG_B_SHIFT),
+              base + WAVEGEN_SYNC_CFG_OFFSET);
+}
+
+void wavegen_ip_get_sync(void __iomem *base, struct wavegen_sync *s)
+{
+    u32 cfg = ioread32(base + WAVEGEN_SYNC_CFG_OFFSET);
+    u32 ctrl = ioread32(base + WAVEGEN_SYNC_CTRL_OFFSET);
+
+    s->cfg_a = cfg & WAVEGEN_SYNC_CFG_MASK;
+    s->cfg_b = (cfg >> WAVEGEN_SYNC_CFG_B_SHIFT) & WAVEGEN_SYNC_CFG_MASK;
+    s->loopback = (ctrl & WAVEGEN_SYNC_CTRL_LOOPBACK) ? 1 : 0;
+    s->reset_count = (ctrl & WAVEGEN_SYNC_CTRL_CNT_RESET) ? 1 : 0;
+    s->period = ioread32(base + WAVEGEN_SYNC_PERIOD_OFFSET);
+}
+
+void wavegen_ip_sync_fire(void __iomem *base)
+{
+    /* FIRE reads back as 0; keep the role bits */
+    u32 ctrl = ioread32(base + WAVEGEN_SYNC_CTRL_OFFSET);
+
+    iowrite32(ctrl | WAVEGEN_SYNC_CTRL_FIRE, base + WAVEGEN_SYNC_CTRL_OFFSET);
+}
+
+void wavegen_ip_set_noise(void __iomem *base, struct wavegen_noise *n)
+{
+    u32 gauss = n->gaussian ? WAVEGEN_NOISE_GAUSS : 0;
+
+    if (n->channel == WAVEGEN_CHANNEL_A) {
+        wavegen_ip_update(base, WAVEGEN_NOISE_CFG_OFFSET, WAVEGEN_NOISE_GAUSS, gauss);
+        wavegen_ip_write_reg(base, WAVEGEN_NOISE_SEED_A_OFFSET, n->seed);
+    } else if (n->channel == WAVEGEN_CHANNEL_B) {
+        wavegen_ip_update(base, WAVEGEN_NOISE_CFG_OFFSET,
+                          WAVEGEN_NOISE_GAUSS << WAVEGEN_NOISE_CFG_B_SHIFT,
+                          gauss << WAVEGEN_NOISE_CFG_B_SHIFT);
+        wavegen_ip_write_reg(base, WAVEGEN_NOISE_SEED_B_OFFSET, n->seed);
+    }
+}
+
+void wavegen_ip_set_arb_interp(void __iomem *base, struct wavegen_arb_interp *ai)
+{
+    u32 bit = (ai->channel == WAVEGEN_CHANNEL_A) ? WAVEGEN_ARB_CFG_INTERP :
+              (WAVEGEN_ARB_CFG_INTERP << WAVEGEN_ARB_CFG_B_SHIFT);
+
+    wavegen_ip_update(base, WAVEGEN_ARB_CFG_OFFSET, bit, ai->enable ? bit : 0);
+}
+
+void wavegen_ip_set_arb_format(void __iomem *base, struct wavegen_arb_format *af)
+{
+    wavegen_ip_update(base, WAVEGEN_ARB_CFG_OFFSET, WAVEGEN_ARB_CFG_FORMAT_MASK,
+                      af->format << WAVEGEN_ARB_CFG_FORMAT_SHIFT);
+}
+
+void wavegen_ip_get_arb_format(void __iomem *base, struct wavegen_arb_format *af)
+{
+    u32 val = wavegen_image[WAVEGEN_ARB_CFG_OFFSET / 4];
+    af->format = (val & WAVEGEN_ARB_CFG_FORMAT_MASK) >> WAVEGEN_ARB_CFG_FORMAT_SHIFT;
+}
+
+void wavegen_ip_capture_arm(void __iomem *base, struct wavegen_capture_config *cfg)
+{
+    u32 ctrl = (cfg->source ? WAVEGEN_CAP_CTRL_OUTPUT : 0) |
+               ((cfg->trigger & 0x3) << WAVEGEN_CAP_CTRL_TRIG_SHIFT);
+
+    iowrite32((cfg->pre_trigger & 0xFFFF) |
+              ((cfg->decimation & 0xFFFF) << WAVEGEN_CAP_CFG_DECIM_SHIFT),
+              base + WAVEGEN_CAP_CFG_OFFSET);
+    iowrite32(ctrl | WAVEGEN_CAP_CTRL_ARM, base + WAVEGEN_CAP_CTRL_OFFSET);
+}
+
+void wavegen_ip_capture_trigger(void __iomem *base)
+{
+    /* ARM and TRIGGER read back as 0; keep source and trigger select */
+    u32 ctrl = ioread32(base + WAVEGEN_CAP_CTRL_OFFSET);
+
+    iowrite32(ctrl | WAVEGEN_CAP_CTRL_TRIGGER, base + WAVEGEN_CAP_CTRL_OFFSET);
+}
+
+void wavegen_ip_get_capture_status(void __iomem *base, struct wavegen_capture_status *st)
+{
+    u32 raw = ioread32(base + WAVEGEN_CAP_STATUS_OFFSET);
+
+    st->waiting = (raw & WAVEGEN_CAP_STATUS_WAITING) ? 1 : 0;
+    st->triggered = (raw & WAVEGEN_CAP_STATUS_TRIGGERED) ? 1 : 0;
+    st->done = (raw & WAVEGEN_CAP_STATUS_DONE) ? 1 : 0;
+    st->depth = raw >> WAVEGEN_CAP_STATUS_DEPTH_SHIFT;
+}
+
+void wavegen_ip_read_capture(void __iomem *base, unsigned int start, unsigned int count, u32 *buf)
+{
+    unsigned int i;
+
+    for (i = 0; i < count; i++)
+        buf[i] = ioread32(base + WAVEGEN_CAP_DATA_OFFSET + (start + i) * 4);
+}
+
+/* Start or stop one channel, leaving the other as it is */
+void wavegen_ip_run_channel(void __iomem *base, unsigned int channel, bool run)
+{
+    u32 bit = (channel == WAVEGEN_CHANNEL_B) ? 0x2 : 0x1;
+
+    wavegen_ip_update(base, WAVEGEN_RUN_OFFSET, bit, run ? bit : 0);
+}
+
+/*
+ * Stop the channel and set it up to play the first `table` ARB entries
+ * in a loop at `frequency`. ARB_DEPTH and the memory format (set back
+ * to plain samples) are shared by both channels. The apply keeps the
+ * resources in keep, as wavegen_ip_apply().
+ */
+void wavegen_ip_stream_setup(void __iomem *base, unsigned int channel,
+                             unsigned int frequency, unsigned int table,
+                             unsigned int keep)
+{
+    unsigned int shift = (channel == WAVEGEN_CHANNEL_B) ? 4 : 0;
+
+    wavegen_ip_run_channel(base, channel, false);
+    wavegen_ip_update(base, WAVEGEN_MODE_OFFSET, 0xF << shift, WAVEGEN_MODE_ARB << shift);
+    wavegen_ip_write_reg(base, WAVEGEN_ARB_DEPTH_OFFSET, table);
+    wavegen_ip_update(base, WAVEGEN_ARB_CFG_OFFSET, WAVEGEN_ARB_CFG_FORMAT_MASK, 0);
+    wavegen_ip_write_reg(base, channel == WAVEGEN_CHANNEL_B ?
+                         WAVEGEN_FREQ_B_OFFSET : WAVEGEN_FREQ_A_OFFSET, frequency);
+    wavegen_ip_apply(base, keep);
 }
\ No newline at end of file
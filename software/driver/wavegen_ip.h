@@ -10,8 +10,8 @@
  * ============================================================ */
 
 struct wavegen_mode {
-    unsigned int channel_a;     /* Mode for channel A (0-5) */
-    unsigned int channel_b;     /* Mode for channel B (0-5) */
+    unsigned int channel_a;     /* Mode for channel A (0-7) */
+    unsigned int channel_b;     /* Mode for channel B (0-7) */
 };
 
 struct wavegen_frequency {
@@ -74,9 +74,276 @@ struct wavegen_status {
     unsigned int reconfig_busy;
     unsigned int channel_a_running;
     unsigned int channel_b_running;
+    unsigned int channel_a_armed;   /* Waiting for trigger */
+    unsigned int channel_b_armed;
     unsigned int raw;           /* Raw status register value */
 };
 
+struct wavegen_trigger_config {
+    unsigned int channel;
+    unsigned int arm;           /* 1 = hold at phase 0 until triggered */
+    unsigned int external;      /* 1 = accept external trigger input */
+    unsigned int edge;          /* WAVEGEN_TRIG_EDGE_* */
+};
+
+struct wavegen_trigger_latency {
+    unsigned int channel_a;     /* Trigger-to-start latency (IP clock cycles) */
+    unsigned int channel_b;
+};
+
+struct wavegen_modulation {
+    unsigned int channel;
+    unsigned int type;          /* WAVEGEN_MOD_OFF/AM/FM/PM */
+    unsigned int source;        /* 0 = internal oscillator, 1 = other channel */
+    unsigned int depth;         /* AM depth / PM deviation, 0-32767 */
+    unsigned int frequency;     /* Internal oscillator, 100uHz units */
+    unsigned int deviation;     /* FM peak deviation, 100uHz units */
+};
+
+struct wavegen_counters {
+    unsigned long long clk_count;       /* IP clock cycles since clear */
+    unsigned long long samples_a;       /* Samples generated, channel A */
+    unsigned long long samples_b;
+    unsigned long long since_trigger_a; /* IP clocks since last trigger A */
+    unsigned long long since_trigger_b;
+    unsigned int cycles_a;              /* Completed waveform cycles A */
+    unsigned int cycles_b;
+    unsigned int dac_frames;            /* DAC update strobes */
+    unsigned int underflows;
+    unsigned int overruns;
+    unsigned int reconfigs;             /* Shadow register applies */
+};
+
+struct wavegen_arb_cached {
+    unsigned int start_offset;  /* Starting sample index */
+    unsigned int count;         /* Number of samples */
+    unsigned int depth;         /* ARB_DEPTH to set afterwards (0 = leave) */
+    unsigned int hit;           /* Out: 1 = region already held this data */
+    unsigned long long hash;    /* wavegen_arb_hash(data, count) */
+    unsigned short *data;       /* Samples (userspace), read only on a miss */
+};
+
+struct wavegen_arb_cache_stats {
+    unsigned long long hits;            /* Uploads skipped */
+    unsigned long long misses;          /* Uploads written to ARB memory */
+    unsigned long long samples_skipped; /* Samples not re-sent on hits */
+    unsigned long long samples_written; /* Samples written on misses */
+};
+
+/*
+ * Profile bank contents, in register format: mode is the MODE register,
+ * offset/amplitude/duty_cycle/cycles/phase pack channel B in [31:16] and
+ * channel A in [15:0] as in the OFFSET..PHASE registers.
+ */
+struct wavegen_profile {
+    unsigned int index;         /* Profile bank (0 .. count-1) */
+    unsigned int mode;          /* [7:4]=mode_b, [3:0]=mode_a */
+    unsigned int freq_a;        /* 100uHz units */
+    unsigned int freq_b;
+    unsigned int offset;
+    unsigned int amplitude;
+    unsigned int duty_cycle;
+    unsigned int cycles;
+    unsigned int phase;
+};
+
+struct wavegen_profile_select {
+    unsigned int index;         /* Profile to apply / out: active profile */
+    unsigned int pins;          /* 1 = profile_sel pins choose the profile */
+    unsigned int count;         /* Out: profile banks in the IP */
+};
+
+struct wavegen_commit {
+    unsigned int mode;              /* WAVEGEN_COMMIT_* */
+    unsigned int reserved;
+    unsigned long long sample;      /* Timestamp for WAVEGEN_COMMIT_AT */
+};
+
+struct wavegen_sample_count {
+    unsigned long long count;       /* Engine samples since IP reset */
+    unsigned int commit_pending;    /* Out: WAVEGEN_COMMIT_* still armed */
+    unsigned int commit_late;       /* Out: last timed commit was late */
+};
+
+struct wavegen_sync {
+    unsigned int cfg_a;         /* WAVEGEN_SYNC_CFG_ARM / _EVERY */
+    unsigned int cfg_b;
+    unsigned int loopback;      /* 1 = sync master (sees its own pulse) */
+    unsigned int reset_count;   /* 1 = clear the sample counter on sync */
+    unsigned int period;        /* Samples between sync_out pulses, 0 = off */
+};
+
+struct wavegen_noise {
+    unsigned int channel;
+    unsigned int gaussian;      /* 0 = uniform, 1 = gaussian */
+    unsigned int seed;          /* Loaded each time the channel starts */
+};
+
+struct wavegen_arb_interp {
+    unsigned int channel;
+    unsigned int enable;        /* 1 = interpolate between ARB samples */
+};
+
+struct wavegen_arb_format {
+    unsigned int format;        /* WAVEGEN_ARB_FMT_*, both channels */
+};
+
+struct wavegen_capture_config {
+    unsigned int source;        /* 0 = engine waveform, 1 = scaled output */
+    unsigned int trigger;       /* WAVEGEN_CAP_TRIG_* */
+    unsigned int pre_trigger;   /* Samples kept before the trigger */
+    unsigned int decimation;    /* Keep 1 of decimation + 1 samples */
+};
+
+struct wavegen_capture_status {
+    unsigned int waiting;       /* Armed, trigger not seen yet */
+    unsigned int triggered;     /* Storing post-trigger samples */
+    unsigned int done;
+    unsigned int depth;         /* CAPTURE_DEPTH */
+};
+
+struct wavegen_capture_read {
+    unsigned int start;         /* First sample (0 = oldest) */
+    unsigned int count;         /* Number of samples */
+    unsigned int *data;         /* Out: [31:16]=B, [15:0]=A (userspace) */
+};
+
+/*
+ * Command ring: one per open file, mapped with mmap(offset 0, length
+ * PAGE_ALIGN(sizeof(struct wavegen_ring))). Userspace fills sq[] and
+ * advances sq_tail; WAVEGEN_IOCTL_RING_SUBMIT executes the queued
+ * entries in order and advances sq_head. Reads, failed entries and
+ * entries flagged WAVEGEN_SQE_COMPLETE post a completion to cq[],
+ * which userspace consumes by advancing cq_head. Indices are
+ * free-running; entry = index & (ENTRIES - 1).
+ */
+#define WAVEGEN_RING_SQ_ENTRIES     512
+#define WAVEGEN_RING_CQ_ENTRIES     256
+
+#define WAVEGEN_RING_OP_NOP         0
+#define WAVEGEN_RING_OP_WRITE       1   /* Write value to register offset */
+#define WAVEGEN_RING_OP_READ        2   /* Read register offset into cqe */
+#define WAVEGEN_RING_OP_APPLY       3   /* Apply shadow registers */
+
+#define WAVEGEN_SQE_COMPLETE        (1 << 0)    /* Post a cqe on success too */
+
+struct wavegen_sqe {
+    unsigned char opcode;       /* WAVEGEN_RING_OP_* */
+    unsigned char flags;        /* WAVEGEN_SQE_* */
+    unsigned short reserved;
+    unsigned int offset;        /* Register byte offset (wavegen_regs.h) */
+    unsigned int value;         /* Value to write */
+    unsigned int tag;           /* Returned in the cqe */
+};
+
+struct wavegen_cqe {
+    unsigned int tag;
+    int result;                 /* 0 or -errno */
+    unsigned int value;         /* Register value for reads */
+    unsigned int reserved;
+};
+
+struct wavegen_ring {
+    unsigned int sq_head;       /* Advanced by the driver */
+    unsigned int sq_tail;       /* Advanced by userspace */
+    unsigned int cq_head;       /* Advanced by userspace */
+    unsigned int cq_tail;       /* Advanced by the driver */
+    unsigned int reserved[12];  /* Header padded to 64 bytes */
+    struct wavegen_sqe sq[WAVEGEN_RING_SQ_ENTRIES];
+    struct wavegen_cqe cq[WAVEGEN_RING_CQ_ENTRIES];
+};
+
+struct wavegen_ring_submit {
+    unsigned int to_submit;     /* Entries to execute (at most queued) */
+    unsigned int submitted;     /* Out: entries executed */
+};
+
+/*
+ * Sample streaming: after WAVEGEN_IOCTL_STREAM_START, write() (or
+ * splice()) 16-bit ARB samples to the device. They queue in a kernel
+ * ring of `buffer` samples and a workqueue copies them into the first
+ * `table` ARB entries, which the channel plays as a circular buffer in
+ * ARB mode. The playback position is followed with the sample counter
+ * and the channel's phase step, which needs `sampling_frequency` (the
+ * engine rate the IP was built with, SAMPLING_FREQUENCY >> INTERP_STAGES)
+ * and an unmodulated channel. The stream rate is frequency * table in
+ * the units of `frequency`. write() blocks while the ring is full and
+ * poll() reports writable once `watermark` samples are free.
+ */
+#define WAVEGEN_STREAM_DEFAULT_TABLE    1024    /* Default ARB_WAVEFORM_DEPTH */
+#define WAVEGEN_STREAM_DEFAULT_BUFFER   65536
+#define WAVEGEN_STREAM_MAX_BUFFER       (1 << 22)
+
+struct wavegen_stream_config {
+    unsigned int channel;       /* WAVEGEN_CHANNEL_A or _B */
+    unsigned int frequency;     /* FREQ register value: table passes per unit */
+    unsigned int sampling_frequency; /* Engine rate (SAMPLING_FREQUENCY parameter) */
+    unsigned int table;         /* ARB entries used (64 .. ARB_WAVEFORM_DEPTH, 0 = 1024) */
+    unsigned int buffer;        /* Kernel ring, samples (power of two, 0 = default) */
+    unsigned int watermark;     /* Free samples for writable (0 = buffer / 2) */
+};
+
+struct wavegen_stream_status {
+    unsigned int running;
+    unsigned int queued;        /* Samples in the kernel ring */
+    unsigned int ahead;         /* Stream samples in ARB memory not played yet */
+    unsigned int reserved;
+    unsigned long long written; /* Stream samples sent to ARB memory */
+    unsigned long long underruns; /* Times the ring ran dry while playing */
+    unsigned long long silence; /* Zero samples queued for lack of data */
+};
+
+/*
+ * Claims: an open file can claim channel A, channel B and the device-wide
+ * resources (ARB memory and depth, profile banks, timed commit, sync
+ * control, counters, capture), each shared or exclusive. An unclaimed
+ * resource is writable through every open file. A claimed one only
+ * through the files holding it, and an exclusive claim has one holder.
+ * Writes to a resource the file may not use fail with EBUSY, except that
+ * WAVEGEN_IOCTL_SET_MODE and WAVEGEN_IOCTL_ENABLE leave such a channel
+ * as it is. RECONFIG needs one writable channel. Reads are never
+ * restricted, and claims are dropped when the file is closed.
+ */
+#define WAVEGEN_CLAIM_A             (1 << 0)
+#define WAVEGEN_CLAIM_B             (1 << 1)
+#define WAVEGEN_CLAIM_DEVICE        (1 << 2)
+#define WAVEGEN_CLAIM_ALL           0x7
+#define WAVEGEN_CLAIM_COUNT         3
+
+#define WAVEGEN_CLAIM_EXCLUSIVE     (1 << 0)    /* flags: else shared */
+
+struct wavegen_claim {
+    unsigned int resources;     /* WAVEGEN_CLAIM_* to claim or release */
+    unsigned int flags;         /* WAVEGEN_CLAIM_EXCLUSIVE */
+    unsigned int held_exclusive; /* Out: this file's exclusive claims */
+    unsigned int held_shared;   /* Out: this file's shared claims */
+};
+
+struct wavegen_claim_status {
+    unsigned int held_exclusive; /* This file's claims */
+    unsigned int held_shared;
+    unsigned int exclusive;     /* Resources claimed exclusively by any file */
+    unsigned int shared[WAVEGEN_CLAIM_COUNT]; /* Shared holders per resource */
+};
+
+/*
+ * ARB content hash: 64-bit FNV-1a over the 16-bit samples. Shared by the
+ * driver and the library so a cached upload can be matched without
+ * copying the data.
+ */
+static inline unsigned long long wavegen_arb_hash(const unsigned short *data,
+                                                  unsigned int count)
+{
+    unsigned long long h = 0xCBF29CE484222325ULL;
+    unsigned int i;
+
+    for (i = 0; i < count; i++) {
+        h ^= data[i];
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
 /* ============================================================
  * IOCTL command definitions
  * ============================================================ */
@@ -96,12 +363,47 @@ struct wavegen_status {
 #define WAVEGEN_IOCTL_RECONFIG              _IO(WAVEGEN_IOC_MAGIC, 13)
 #define WAVEGEN_IOCTL_GET_STATUS            _IOR(WAVEGEN_IOC_MAGIC, 14, struct wavegen_status)
 #define WAVEGEN_IOCTL_SOFT_RESET            _IOW(WAVEGEN_IOC_MAGIC, 15, struct wavegen_trigger)
+#define WAVEGEN_IOCTL_SET_TRIGGER_CONFIG    _IOW(WAVEGEN_IOC_MAGIC, 16, struct wavegen_trigger_config)
+#define WAVEGEN_IOCTL_GET_TRIGGER_LATENCY   _IOR(WAVEGEN_IOC_MAGIC, 17, struct wavegen_trigger_latency)
+#define WAVEGEN_IOCTL_SET_MODULATION        _IOW(WAVEGEN_IOC_MAGIC, 18, struct wavegen_modulation)
+#define WAVEGEN_IOCTL_GET_COUNTERS          _IOR(WAVEGEN_IOC_MAGIC, 19, struct wavegen_counters)
+#define WAVEGEN_IOCTL_CLEAR_COUNTERS        _IO(WAVEGEN_IOC_MAGIC, 20)
+#define WAVEGEN_IOCTL_LOAD_ARB_CACHED       _IOWR(WAVEGEN_IOC_MAGIC, 21, struct wavegen_arb_cached)
+#define WAVEGEN_IOCTL_GET_ARB_CACHE_STATS   _IOR(WAVEGEN_IOC_MAGIC, 22, struct wavegen_arb_cache_stats)
+#define WAVEGEN_IOCTL_RING_SUBMIT           _IOWR(WAVEGEN_IOC_MAGIC, 23, struct wavegen_ring_submit)
+#define WAVEGEN_IOCTL_SET_PROFILE           _IOW(WAVEGEN_IOC_MAGIC, 24, struct wavegen_profile)
+#define WAVEGEN_IOCTL_GET_PROFILE           _IOWR(WAVEGEN_IOC_MAGIC, 25, struct wavegen_profile)
+#define WAVEGEN_IOCTL_SELECT_PROFILE        _IOWR(WAVEGEN_IOC_MAGIC, 26, struct wavegen_profile_select)
+#define WAVEGEN_IOCTL_GET_PROFILE_SELECT    _IOR(WAVEGEN_IOC_MAGIC, 27, struct wavegen_profile_select)
+#define WAVEGEN_IOCTL_COMMIT                _IOW(WAVEGEN_IOC_MAGIC, 28, struct wavegen_commit)
+#define WAVEGEN_IOCTL_GET_SAMPLE_COUNT      _IOR(WAVEGEN_IOC_MAGIC, 29, struct wavegen_sample_count)
+#define WAVEGEN_IOCTL_SET_SYNC              _IOW(WAVEGEN_IOC_MAGIC, 30, struct wavegen_sync)
+#define WAVEGEN_IOCTL_GET_SYNC              _IOR(WAVEGEN_IOC_MAGIC, 31, struct wavegen_sync)
+#define WAVEGEN_IOCTL_SYNC_FIRE             _IO(WAVEGEN_IOC_MAGIC, 32)
+#define WAVEGEN_IOCTL_SET_NOISE             _IOW(WAVEGEN_IOC_MAGIC, 33, struct wavegen_noise)
+#define WAVEGEN_IOCTL_SET_ARB_INTERP        _IOW(WAVEGEN_IOC_MAGIC, 34, struct wavegen_arb_interp)
+#define WAVEGEN_IOCTL_CAPTURE_ARM           _IOW(WAVEGEN_IOC_MAGIC, 35, struct wavegen_capture_config)
+#define WAVEGEN_IOCTL_CAPTURE_TRIGGER       _IO(WAVEGEN_IOC_MAGIC, 36)
+#define WAVEGEN_IOCTL_GET_CAPTURE_STATUS    _IOR(WAVEGEN_IOC_MAGIC, 37, struct wavegen_capture_status)
+#define WAVEGEN_IOCTL_READ_CAPTURE          _IOW(WAVEGEN_IOC_MAGIC, 38, struct wavegen_capture_read)
+#define WAVEGEN_IOCTL_STREAM_START          _IOW(WAVEGEN_IOC_MAGIC, 39, struct wavegen_stream_config)
+#define WAVEGEN_IOCTL_STREAM_STOP           _IO(WAVEGEN_IOC_MAGIC, 40)
+#define WAVEGEN_IOCTL_GET_STREAM_STATUS     _IOR(WAVEGEN_IOC_MAGIC, 41, struct wavegen_stream_status)
+#define WAVEGEN_IOCTL_CLAIM                 _IOWR(WAVEGEN_IOC_MAGIC, 42, struct wavegen_claim)
+#define WAVEGEN_IOCTL_UNCLAIM               _IOWR(WAVEGEN_IOC_MAGIC, 43, struct wavegen_claim)
+#define WAVEGEN_IOCTL_GET_CLAIMS            _IOR(WAVEGEN_IOC_MAGIC, 44, struct wavegen_claim_status)
+#define WAVEGEN_IOCTL_SET_ARB_FORMAT        _IOW(WAVEGEN_IOC_MAGIC, 45, struct wavegen_arb_format)
 
 /* ============================================================
  * Function prototypes (implemented in wavegen_ip.c)
  * ============================================================ */
 
+#ifdef __KERNEL__
+
+void wavegen_ip_image_init(void __iomem *base);
+void wavegen_ip_write_reg(void __iomem *base, unsigned int off, u32 value);
 void wavegen_ip_set_mode(void __iomem *base, struct wavegen_mode *mode);
+void wavegen_ip_get_mode(void __iomem *base, struct wavegen_mode *mode);
 void wavegen_ip_set_frequency(void __iomem *base, struct wavegen_frequency *freq);
 void wavegen_ip_set_amplitude(void __iomem *base, struct wavegen_amplitude *amp);
 void wavegen_ip_set_offset(void __iomem *base, struct wavegen_offset *offset);
@@ -109,11 +411,42 @@ void wavegen_ip_set_duty_cycle(void __iomem *base, struct wavegen_duty_cycle *dc
 void wavegen_ip_set_phase_offset(void __iomem *base, struct wavegen_phase_offset *po);
 void wavegen_ip_set_cycles(void __iomem *base, struct wavegen_cycles *cyc);
 void wavegen_ip_enable(void __iomem *base, struct wavegen_enable *en);
+void wavegen_ip_get_enable(void __iomem *base, struct wavegen_enable *en);
 void wavegen_ip_set_arb_depth(void __iomem *base, struct wavegen_arb_waveform_depth *d);
 void wavegen_ip_set_arb_data(void __iomem *base, struct wavegen_arb_waveform_data *d);
 void wavegen_ip_trigger(void __iomem *base, struct wavegen_trigger *trig);
 void wavegen_ip_reconfig(void __iomem *base);
+void wavegen_ip_apply(void __iomem *base, unsigned int keep);
 void wavegen_ip_get_status(void __iomem *base, struct wavegen_status *st);
 void wavegen_ip_soft_reset(void __iomem *base, struct wavegen_trigger *rst);
+void wavegen_ip_set_trigger_config(void __iomem *base, struct wavegen_trigger_config *tc);
+void wavegen_ip_get_trigger_latency(void __iomem *base, struct wavegen_trigger_latency *lat);
+void wavegen_ip_set_modulation(void __iomem *base, struct wavegen_modulation *mod);
+void wavegen_ip_get_counters(void __iomem *base, struct wavegen_counters *cnt);
+void wavegen_ip_clear_counters(void __iomem *base);
+unsigned int wavegen_ip_profile_count(void __iomem *base);
+void wavegen_ip_set_profile(void __iomem *base, struct wavegen_profile *p);
+void wavegen_ip_get_profile(void __iomem *base, struct wavegen_profile *p);
+void wavegen_ip_select_profile(void __iomem *base, struct wavegen_profile_select *sel);
+void wavegen_ip_get_profile_select(void __iomem *base, struct wavegen_profile_select *sel);
+void wavegen_ip_commit(void __iomem *base, struct wavegen_commit *c);
+void wavegen_ip_get_sample_count(void __iomem *base, struct wavegen_sample_count *sc);
+void wavegen_ip_set_sync(void __iomem *base, struct wavegen_sync *s);
+void wavegen_ip_get_sync(void __iomem *base, struct wavegen_sync *s);
+void wavegen_ip_sync_fire(void __iomem *base);
+void wavegen_ip_set_noise(void __iomem *base, struct wavegen_noise *n);
+void wavegen_ip_set_arb_interp(void __iomem *base, struct wavegen_arb_interp *ai);
+void wavegen_ip_set_arb_format(void __iomem *base, struct wavegen_arb_format *af);
+void wavegen_ip_get_arb_format(void __iomem *base, struct wavegen_arb_format *af);
+void wavegen_ip_capture_arm(void __iomem *base, struct wavegen_capture_config *cfg);
+void wavegen_ip_capture_trigger(void __iomem *base);
+void wavegen_ip_get_capture_status(void __iomem *base, struct wavegen_capture_status *st);
+void wavegen_ip_read_capture(void __iomem *base, unsigned int start, unsigned int count, u32 *buf);
+void wavegen_ip_run_channel(void __iomem *base, unsigned int channel, bool run);
+void wavegen_ip_stream_setup(void __iomem *base, unsigned int channel,
+                             unsigned int frequency, unsigned int table,
+                             unsigned int keep);
+
+#endif /* __KERNEL__ */
 
 #endif /* WAVEGEN_IP_H */
\ No newline at end of file
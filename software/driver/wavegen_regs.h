@@ -23,18 +23,166 @@
 #define WAVEGEN_DTCYC_OFFSET    0x18    /* [31:16]=dtcyc_b, [15:0]=dtcyc_a */
 #define WAVEGEN_CYCLES_OFFSET   0x1C    /* [31:16]=cycles_b, [15:0]=cycles_a */
 #define WAVEGEN_PHASE_OFFSET    0x20    /* [31:16]=phase_b, [15:0]=phase_a */
-#define WAVEGEN_ARB_DEPTH_OFFSET 0x24   /* [31:0]=arb waveform depth */
-#define WAVEGEN_ARB_DATA_OFFSET  0x28   /* [15:0]=arb sample data */
+#define WAVEGEN_ARB_DEPTH_OFFSET 0x24   /* [31:0]=arb table length, any value */
 #define WAVEGEN_RECONFIG_OFFSET  0x2C   /* Write any value to apply shadows */
 #define WAVEGEN_STATUS_OFFSET    0x30   /* [RO] status register */
 #define WAVEGEN_TRIGGER_OFFSET   0x34   /* [1]=trigger_b, [0]=trigger_a */
 #define WAVEGEN_SOFT_RST_OFFSET  0x38   /* [1]=reset_b, [0]=reset_a */
+#define WAVEGEN_TRIG_CFG_OFFSET  0x3C   /* [23:16]=trig_cfg_b, [7:0]=trig_cfg_a */
+#define WAVEGEN_TRIG_LAT_A_OFFSET 0x40  /* [RO] trigger-to-start latency A */
+#define WAVEGEN_TRIG_LAT_B_OFFSET 0x44  /* [RO] trigger-to-start latency B */
+#define WAVEGEN_MOD_CFG_OFFSET   0x48   /* [23:16]=mod_cfg_b, [7:0]=mod_cfg_a */
+#define WAVEGEN_MOD_DEPTH_OFFSET 0x4C   /* [31:16]=depth_b, [15:0]=depth_a */
+#define WAVEGEN_MOD_FREQ_A_OFFSET 0x50  /* [31:0]=modulator frequency A */
+#define WAVEGEN_MOD_FREQ_B_OFFSET 0x54  /* [31:0]=modulator frequency B */
+#define WAVEGEN_MOD_DEV_A_OFFSET 0x58   /* [31:0]=FM peak deviation A */
+#define WAVEGEN_MOD_DEV_B_OFFSET 0x5C   /* [31:0]=FM peak deviation B */
+#define WAVEGEN_CNT_CTRL_OFFSET  0x60   /* [1]=clear, [0]=snapshot counters */
+#define WAVEGEN_PROFILE_SEL_OFFSET 0x64 /* [3:0]=profile, [8]=pins, [23:16]=count */
+#define WAVEGEN_COMMIT_CTRL_OFFSET 0x68 /* [1:0]=commit mode, [4]=late (RO) */
+#define WAVEGEN_COMMIT_TIME_LO_OFFSET 0x6C /* Commit sample timestamp [31:0] */
+#define WAVEGEN_COMMIT_TIME_HI_OFFSET 0x70 /* Commit sample timestamp [63:32] */
+#define WAVEGEN_SAMPLE_CNT_LO_OFFSET 0x74 /* [RO] samples [31:0], latches hi */
+#define WAVEGEN_SAMPLE_CNT_HI_OFFSET 0x78 /* [RO] latched samples [63:32] */
+#define WAVEGEN_SYNC_CFG_OFFSET  0x7C   /* [17:16]=sync_cfg_b, [1:0]=sync_cfg_a */
+#define WAVEGEN_REG_SPAN         0x400  /* Register decode window (256 words) */
+
+/* Performance counter snapshot (read-only; 64-bit counters are lo/hi pairs) */
+#define WAVEGEN_CNT_CLK_OFFSET          0x80    /* IP clock cycles */
+#define WAVEGEN_CNT_SAMPLES_A_OFFSET    0x88    /* Samples generated, channel A */
+#define WAVEGEN_CNT_SAMPLES_B_OFFSET    0x90    /* Samples generated, channel B */
+#define WAVEGEN_CNT_SINCE_TRIG_A_OFFSET 0x98    /* IP clocks since last trigger A */
+#define WAVEGEN_CNT_SINCE_TRIG_B_OFFSET 0xA0    /* IP clocks since last trigger B */
+#define WAVEGEN_CNT_CYCLES_A_OFFSET     0xA8    /* Completed waveform cycles A */
+#define WAVEGEN_CNT_CYCLES_B_OFFSET     0xAC    /* Completed waveform cycles B */
+#define WAVEGEN_CNT_DAC_FRAMES_OFFSET   0xB0    /* DAC update strobes */
+#define WAVEGEN_CNT_UNDERFLOW_OFFSET    0xB4    /* DAC strobe before sample ready */
+#define WAVEGEN_CNT_OVERRUN_OFFSET      0xB8    /* Engine request while busy */
+#define WAVEGEN_CNT_RECONFIG_OFFSET     0xBC    /* Shadow register applies */
+
+/* Multi-board sync (after the counter block) */
+#define WAVEGEN_SYNC_CTRL_OFFSET   0xC0 /* [0]=fire (WO), [1]=loopback, [2]=count reset */
+#define WAVEGEN_SYNC_PERIOD_OFFSET 0xC4 /* [31:0]=samples between pulses, 0 = off */
+
+/* Noise mode (shadowed, applied by RECONFIG) */
+#define WAVEGEN_NOISE_CFG_OFFSET    0xC8 /* [16]=gaussian B, [0]=gaussian A */
+#define WAVEGEN_NOISE_SEED_A_OFFSET 0xCC /* [31:0]=seed, loaded on channel start */
+#define WAVEGEN_NOISE_SEED_B_OFFSET 0xD0
+
+/* ARB playback (shadowed, applied by RECONFIG) */
+#define WAVEGEN_ARB_CFG_OFFSET      0xD4 /* [16]=interpolate B, [9:8]=format, [0]=interpolate A */
+
+/* Output capture (not shadowed) */
+#define WAVEGEN_CAP_CTRL_OFFSET     0xD8 /* [0]=arm, [1]=trigger (WO), [2]=source, [5:4]=trigger */
+#define WAVEGEN_CAP_CFG_OFFSET      0xDC /* [31:16]=decimation, [15:0]=pre-trigger samples */
+#define WAVEGEN_CAP_STATUS_OFFSET   0xE0 /* [RO] [31:16]=depth, [2]=done, [1]=triggered, [0]=waiting */
+
+/* ARB sample window: sample n is written at WAVEGEN_ARB_DATA_OFFSET + n * 4 */
+#define WAVEGEN_ARB_DATA_OFFSET  0x4000 /* [15:0]=arb sample data */
+#define WAVEGEN_ARB_MAX_SAMPLES  4096   /* Largest ARB_WAVEFORM_DEPTH / bulk write */
+
+/* Capture window [RO]: sample n (oldest first) at WAVEGEN_CAP_DATA_OFFSET + n * 4 */
+#define WAVEGEN_CAP_DATA_OFFSET  0x8000 /* [31:16]=channel B, [15:0]=channel A */
+#define WAVEGEN_CAP_MAX_SAMPLES  4096   /* Largest CAPTURE_DEPTH */
+
+/*
+ * Profile banks: profile p is at WAVEGEN_PROFILE_OFFSET + p * STRIDE and
+ * holds MODE, FREQ_A/B, OFFSET, AMPLTD, DTCYC, CYCLES and PHASE at their
+ * register offsets (add WAVEGEN_*_OFFSET to the bank address).
+ */
+#define WAVEGEN_PROFILE_OFFSET   0xC000
+#define WAVEGEN_PROFILE_STRIDE   0x40
+#define WAVEGEN_MAX_PROFILES     16     /* Largest NUM_PROFILES */
 
 /* Status register bit definitions */
 #define WAVEGEN_STATUS_READY        (1 << 0)
 #define WAVEGEN_STATUS_RECONFIG     (1 << 1)
 #define WAVEGEN_STATUS_CHA_RUNNING  (1 << 2)
 #define WAVEGEN_STATUS_CHB_RUNNING  (1 << 3)
+#define WAVEGEN_STATUS_CHA_ARMED    (1 << 4)
+#define WAVEGEN_STATUS_CHB_ARMED    (1 << 5)
+
+/* Trigger configuration bits (one byte per channel in TRIG_CFG) */
+#define WAVEGEN_TRIG_ARM            (1 << 0)    /* Wait for trigger after enable */
+#define WAVEGEN_TRIG_EXT_EN         (1 << 1)    /* Accept external trigger input */
+#define WAVEGEN_TRIG_EDGE_SHIFT     2
+#define WAVEGEN_TRIG_EDGE_RISING    0
+#define WAVEGEN_TRIG_EDGE_FALLING   1
+#define WAVEGEN_TRIG_EDGE_BOTH      2
+
+/* Counter control bits */
+#define WAVEGEN_CNT_SNAPSHOT        (1 << 0)
+#define WAVEGEN_CNT_CLEAR           (1 << 1)
+
+/* PROFILE_SEL bits */
+#define WAVEGEN_PROFILE_INDEX_MASK  0xF
+#define WAVEGEN_PROFILE_PINS        (1 << 8)    /* profile_sel pins choose */
+#define WAVEGEN_PROFILE_COUNT_SHIFT 16          /* [RO] NUM_PROFILES */
+
+/* COMMIT_CTRL modes and bits */
+#define WAVEGEN_COMMIT_NONE         0           /* Cancel a pending commit */
+#define WAVEGEN_COMMIT_AT           1           /* Apply at COMMIT_TIME */
+#define WAVEGEN_COMMIT_WRAP_A       2           /* Apply at next phase wrap of A */
+#define WAVEGEN_COMMIT_WRAP_B       3           /* Apply at next phase wrap of B */
+#define WAVEGEN_COMMIT_MODE_MASK    0x3
+#define WAVEGEN_COMMIT_LATE         (1 << 4)
+
+/* SYNC_CFG bits (per channel, B at WAVEGEN_SYNC_CFG_B_SHIFT) */
+#define WAVEGEN_SYNC_CFG_ARM        (1 << 0)    /* Act on the next sync edge */
+#define WAVEGEN_SYNC_CFG_EVERY      (1 << 1)    /* Act on every sync edge */
+#define WAVEGEN_SYNC_CFG_MASK       0x3
+#define WAVEGEN_SYNC_CFG_B_SHIFT    16
+
+/* SYNC_CTRL bits */
+#define WAVEGEN_SYNC_CTRL_FIRE      (1 << 0)    /* Emit one sync_out pulse */
+#define WAVEGEN_SYNC_CTRL_LOOPBACK  (1 << 1)    /* sync_out drives the local input */
+#define WAVEGEN_SYNC_CTRL_CNT_RESET (1 << 2)    /* Clear SAMPLE_CNT on each sync */
+
+/* NOISE_CFG bits (per channel, B at WAVEGEN_NOISE_CFG_B_SHIFT) */
+#define WAVEGEN_NOISE_GAUSS         (1 << 0)    /* Gaussian instead of uniform */
+#define WAVEGEN_NOISE_CFG_B_SHIFT   16
+
+/* ARB_CFG bits (per channel, B at WAVEGEN_ARB_CFG_B_SHIFT) */
+#define WAVEGEN_ARB_CFG_INTERP      (1 << 0)    /* Linear interpolation */
+#define WAVEGEN_ARB_CFG_B_SHIFT     16
+#define WAVEGEN_ARB_CFG_FORMAT_SHIFT 8          /* Memory format, both channels */
+#define WAVEGEN_ARB_CFG_FORMAT_MASK (0x3 << WAVEGEN_ARB_CFG_FORMAT_SHIFT)
+
+/*
+ * ARB memory formats. The delta formats store 9-word blocks: a key
+ * sample, then 16 signed 8-bit or 32 signed 4-bit slots, low slot
+ * first in each word. Slot 0 holds the block shift; sample j of the
+ * block is key + ((slot 1 + ... + slot j) << shift), saturated.
+ */
+#define WAVEGEN_ARB_FMT_RAW         0           /* One 16-bit sample per word */
+#define WAVEGEN_ARB_FMT_DELTA8      1           /* 16 samples per block */
+#define WAVEGEN_ARB_FMT_DELTA4      2           /* 32 samples per block */
+#define WAVEGEN_ARB_BLOCK_WORDS     9
+
+/* CAP_CTRL bits */
+#define WAVEGEN_CAP_CTRL_ARM        (1 << 0)    /* Start a capture */
+#define WAVEGEN_CAP_CTRL_TRIGGER    (1 << 1)    /* Software trigger */
+#define WAVEGEN_CAP_CTRL_OUTPUT     (1 << 2)    /* Scaled output, else engine */
+#define WAVEGEN_CAP_CTRL_TRIG_SHIFT 4
+#define WAVEGEN_CAP_TRIG_SOFTWARE   0
+#define WAVEGEN_CAP_TRIG_CH_A       1           /* Channel A armed trigger */
+#define WAVEGEN_CAP_TRIG_EXTERNAL   2           /* ext_trigger rising edge */
+#define WAVEGEN_CAP_TRIG_SYNC       3           /* Multi-board sync event */
+#define WAVEGEN_CAP_CFG_DECIM_SHIFT 16
+
+/* CAP_STATUS bits */
+#define WAVEGEN_CAP_STATUS_WAITING   (1 << 0)
+#define WAVEGEN_CAP_STATUS_TRIGGERED (1 << 1)
+#define WAVEGEN_CAP_STATUS_DONE      (1 << 2)
+#define WAVEGEN_CAP_STATUS_DEPTH_SHIFT 16
+
+/* Modulation configuration bits (one byte per channel in MOD_CFG) */
+#define WAVEGEN_MOD_TYPE_MASK       0x3
+#define WAVEGEN_MOD_OFF             0
+#define WAVEGEN_MOD_AM              1
+#define WAVEGEN_MOD_FM              2
+#define WAVEGEN_MOD_PM              3
+#define WAVEGEN_MOD_SRC_OTHER       (1 << 2)    /* Modulate from other channel */
 
 /* Waveform mode constants */
 #define WAVEGEN_MODE_DC         0
@@ -43,6 +191,8 @@
 #define WAVEGEN_MODE_TRIANGLE   3
 #define WAVEGEN_MODE_SQUARE     4
 #define WAVEGEN_MODE_ARB        5
+#define WAVEGEN_MODE_NOISE      6
+#define WAVEGEN_MODE_QUADRATURE 7   /* Cosine of the other channel's phase */
 
 /* Channel constants */
 #define WAVEGEN_CHANNEL_A       0
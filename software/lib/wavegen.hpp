@@ -0,0 +1,588 @@
+#ifndef WAVEGEN_HPP
+#define WAVEGEN_HPP
+
+/*
+ * Waveform Generator C++ Layer (header-only, C++17)
+ *
+ * A typed front end over the same registers the C libraries drive:
+ *
+ *   - wavegen::reg holds the register map as constexpr offsets. Every
+ *     entry is checked against wavegen_regs.h, and against the
+ *     baremetal WAVEGEN_HW_*_OFF macros when wavegen_lib_baremetal.h
+ *     is included first, so a layout change that misses one header
+ *     fails to compile.
+ *   - ChannelConfig<Channel::A> / <Channel::B> carry unit types
+ *     (Frequency, Phase, Amplitude, Offset, Duty) whose factories
+ *     convert engineering units to register words in constexpr code.
+ *     Out-of-range values in a constant expression do not compile;
+ *     at run time they saturate.
+ *   - image() packs a two-channel setup into the eight shadowed
+ *     register words, so a static configuration is a constant array
+ *     and loading it is eight stores and a RECONFIG.
+ *   - Mmio (volatile stores, or WAVEGEN_WRITE32/READ32 when those are
+ *     defined) and, on Linux, Ioctl (the driver's command ring: all
+ *     writes up to an apply go in one ioctl) share the interface
+ *     write/read/apply/flush used by the generic helpers. Ioctl writes
+ *     are queued until apply(), read(), flush() or destruction; run()
+ *     flushes, since the run bits act at once.
+ *
+ * Usage:
+ *   #include "wavegen.hpp"
+ *   using namespace wavegen::literals;
+ *
+ *   constexpr wavegen::ChannelConfig<wavegen::Channel::A> a{
+ *       wavegen::Mode::sine, 1_kHz, wavegen::Amplitude::fraction(0.5)};
+ *   constexpr auto img = wavegen::image(a, wavegen::preset::off<wavegen::Channel::B>);
+ *
+ *   wavegen::Mmio bus(XPAR_WAVEGEN_0_BASEADDR);
+ *   wavegen::load(bus, img);
+ *   wavegen::run(bus, true, false);
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../driver/wavegen_regs.h"
+
+#if defined(__linux__) && __has_include(<sys/ioctl.h>)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "../driver/wavegen_ip.h"
+#define WAVEGEN_HPP_IOCTL 1
+#endif
+
+namespace wavegen {
+
+// ============================================================
+// Register map
+// ============================================================
+namespace reg {
+inline constexpr std::uint32_t mode         = 0x00;
+inline constexpr std::uint32_t run          = 0x04;
+inline constexpr std::uint32_t freq_a       = 0x08;
+inline constexpr std::uint32_t freq_b       = 0x0C;
+inline constexpr std::uint32_t offset       = 0x10;
+inline constexpr std::uint32_t amplitude    = 0x14;
+inline constexpr std::uint32_t duty_cycle   = 0x18;
+inline constexpr std::uint32_t cycles       = 0x1C;
+inline constexpr std::uint32_t phase        = 0x20;
+inline constexpr std::uint32_t arb_depth    = 0x24;
+inline constexpr std::uint32_t reconfig     = 0x2C;
+inline constexpr std::uint32_t status       = 0x30;
+inline constexpr std::uint32_t trigger      = 0x34;
+inline constexpr std::uint32_t soft_reset   = 0x38;
+inline constexpr std::uint32_t trig_cfg     = 0x3C;
+inline constexpr std::uint32_t trig_lat_a   = 0x40;
+inline constexpr std::uint32_t trig_lat_b   = 0x44;
+inline constexpr std::uint32_t mod_cfg      = 0x48;
+inline constexpr std::uint32_t mod_depth    = 0x4C;
+inline constexpr std::uint32_t mod_freq_a   = 0x50;
+inline constexpr std::uint32_t mod_freq_b   = 0x54;
+inline constexpr std::uint32_t mod_dev_a    = 0x58;
+inline constexpr std::uint32_t mod_dev_b    = 0x5C;
+inline constexpr std::uint32_t cnt_ctrl     = 0x60;
+inline constexpr std::uint32_t profile_sel  = 0x64;
+inline constexpr std::uint32_t commit_ctrl  = 0x68;
+inline constexpr std::uint32_t commit_time  = 0x6C;     // lo, hi at +4
+inline constexpr std::uint32_t sample_cnt   = 0x74;     // lo (latches hi), hi at +4
+inline constexpr std::uint32_t sync_cfg     = 0x7C;
+inline constexpr std::uint32_t counters     = 0x80;     // Snapshot block
+inline constexpr std::uint32_t sync_ctrl    = 0xC0;
+inline constexpr std::uint32_t sync_period  = 0xC4;
+inline constexpr std::uint32_t noise_cfg    = 0xC8;
+inline constexpr std::uint32_t noise_seed_a = 0xCC;
+inline constexpr std::uint32_t noise_seed_b = 0xD0;
+inline constexpr std::uint32_t arb_cfg      = 0xD4;
+inline constexpr std::uint32_t cap_ctrl     = 0xD8;
+inline constexpr std::uint32_t cap_cfg      = 0xDC;
+inline constexpr std::uint32_t cap_status   = 0xE0;
+inline constexpr std::uint32_t span         = 0x400;    // Register decode window
+inline constexpr std::uint32_t arb_data     = 0x4000;   // Sample n at + n * 4
+inline constexpr std::uint32_t cap_data     = 0x8000;
+inline constexpr std::uint32_t profiles     = 0xC000;
+inline constexpr std::uint32_t profile_stride = 0x40;
+}
+
+static_assert(reg::mode == WAVEGEN_MODE_OFFSET, "register map: MODE");
+static_assert(reg::run == WAVEGEN_RUN_OFFSET, "register map: RUN");
+static_assert(reg::freq_a == WAVEGEN_FREQ_A_OFFSET, "register map: FREQ_A");
+static_assert(reg::freq_b == WAVEGEN_FREQ_B_OFFSET, "register map: FREQ_B");
+static_assert(reg::offset == WAVEGEN_OFFSET_OFFSET, "register map: OFFSET");
+static_assert(reg::amplitude == WAVEGEN_AMPLTD_OFFSET, "register map: AMPLTD");
+static_assert(reg::duty_cycle == WAVEGEN_DTCYC_OFFSET, "register map: DTCYC");
+static_assert(reg::cycles == WAVEGEN_CYCLES_OFFSET, "register map: CYCLES");
+static_assert(reg::phase == WAVEGEN_PHASE_OFFSET, "register map: PHASE");
+static_assert(reg::arb_depth == WAVEGEN_ARB_DEPTH_OFFSET, "register map: ARB_DEPTH");
+static_assert(reg::reconfig == WAVEGEN_RECONFIG_OFFSET, "register map: RECONFIG");
+static_assert(reg::status == WAVEGEN_STATUS_OFFSET, "register map: STATUS");
+static_assert(reg::trigger == WAVEGEN_TRIGGER_OFFSET, "register map: TRIGGER");
+static_assert(reg::soft_reset == WAVEGEN_SOFT_RST_OFFSET, "register map: SOFT_RST");
+static_assert(reg::trig_cfg == WAVEGEN_TRIG_CFG_OFFSET, "register map: TRIG_CFG");
+static_assert(reg::trig_lat_a == WAVEGEN_TRIG_LAT_A_OFFSET, "register map: TRIG_LAT_A");
+static_assert(reg::trig_lat_b == WAVEGEN_TRIG_LAT_B_OFFSET, "register map: TRIG_LAT_B");
+static_assert(reg::mod_cfg == WAVEGEN_MOD_CFG_OFFSET, "register map: MOD_CFG");
+static_assert(reg::mod_depth == WAVEGEN_MOD_DEPTH_OFFSET, "register map: MOD_DEPTH");
+static_assert(reg::mod_freq_a == WAVEGEN_MOD_FREQ_A_OFFSET, "register map: MOD_FREQ_A");
+static_assert(reg::mod_freq_b == WAVEGEN_MOD_FREQ_B_OFFSET, "register map: MOD_FREQ_B");
+static_assert(reg::mod_dev_a == WAVEGEN_MOD_DEV_A_OFFSET, "register map: MOD_DEV_A");
+static_assert(reg::mod_dev_b == WAVEGEN_MOD_DEV_B_OFFSET, "register map: MOD_DEV_B");
+static_assert(reg::cnt_ctrl == WAVEGEN_CNT_CTRL_OFFSET, "register map: CNT_CTRL");
+static_assert(reg::profile_sel == WAVEGEN_PROFILE_SEL_OFFSET, "register map: PROFILE_SEL");
+static_assert(reg::commit_ctrl == WAVEGEN_COMMIT_CTRL_OFFSET, "register map: COMMIT_CTRL");
+static_assert(reg::commit_time == WAVEGEN_COMMIT_TIME_LO_OFFSET &&
+              reg::commit_time + 4 == WAVEGEN_COMMIT_TIME_HI_OFFSET, "register map: COMMIT_TIME");
+static_assert(reg::sample_cnt == WAVEGEN_SAMPLE_CNT_LO_OFFSET &&
+              reg::sample_cnt + 4 == WAVEGEN_SAMPLE_CNT_HI_OFFSET, "register map: SAMPLE_CNT");
+static_assert(reg::sync_cfg == WAVEGEN_SYNC_CFG_OFFSET, "register map: SYNC_CFG");
+static_assert(reg::counters == WAVEGEN_CNT_CLK_OFFSET, "register map: counter block");
+static_assert(reg::sync_ctrl == WAVEGEN_SYNC_CTRL_OFFSET, "register map: SYNC_CTRL");
+static_assert(reg::sync_period == WAVEGEN_SYNC_PERIOD_OFFSET, "register map: SYNC_PERIOD");
+static_assert(reg::noise_cfg == WAVEGEN_NOISE_CFG_OFFSET, "register map: NOISE_CFG");
+static_assert(reg::noise_seed_a == WAVEGEN_NOISE_SEED_A_OFFSET, "register map: NOISE_SEED_A");
+static_assert(reg::noise_seed_b == WAVEGEN_NOISE_SEED_B_OFFSET, "register map: NOISE_SEED_B");
+static_assert(reg::arb_cfg == WAVEGEN_ARB_CFG_OFFSET, "register map: ARB_CFG");
+static_assert(reg::cap_ctrl == WAVEGEN_CAP_CTRL_OFFSET, "register map: CAP_CTRL");
+static_assert(reg::cap_cfg == WAVEGEN_CAP_CFG_OFFSET, "register map: CAP_CFG");
+static_assert(reg::cap_status == WAVEGEN_CAP_STATUS_OFFSET, "register map: CAP_STATUS");
+static_assert(reg::span == WAVEGEN_REG_SPAN, "register map: decode window");
+static_assert(reg::arb_data == WAVEGEN_ARB_DATA_OFFSET, "register map: ARB window");
+static_assert(reg::cap_data == WAVEGEN_CAP_DATA_OFFSET, "register map: capture window");
+static_assert(reg::profiles == WAVEGEN_PROFILE_OFFSET &&
+              reg::profile_stride == WAVEGEN_PROFILE_STRIDE, "register map: profile banks");
+
+#ifdef WAVEGEN_LIB_BAREMETAL_H
+static_assert(reg::mode == WAVEGEN_HW_MODE_OFF && reg::run == WAVEGEN_HW_RUN_OFF &&
+              reg::freq_a == WAVEGEN_HW_FREQ_A_OFF && reg::freq_b == WAVEGEN_HW_FREQ_B_OFF &&
+              reg::offset == WAVEGEN_HW_OFFSET_OFF && reg::amplitude == WAVEGEN_HW_AMPLTD_OFF &&
+              reg::duty_cycle == WAVEGEN_HW_DTCYC_OFF && reg::cycles == WAVEGEN_HW_CYCLES_OFF &&
+              reg::phase == WAVEGEN_HW_PHASE_OFF && reg::arb_depth == WAVEGEN_HW_ARB_DEPTH_OFF &&
+              reg::reconfig == WAVEGEN_HW_RECONFIG_OFF && reg::status == WAVEGEN_HW_STATUS_OFF,
+              "baremetal register map: control block");
+static_assert(reg::trigger == WAVEGEN_HW_TRIGGER_OFF && reg::soft_reset == WAVEGEN_HW_SOFT_RST_OFF &&
+              reg::trig_cfg == WAVEGEN_HW_TRIG_CFG_OFF && reg::trig_lat_a == WAVEGEN_HW_TRIG_LAT_A_OFF &&
+              reg::trig_lat_b == WAVEGEN_HW_TRIG_LAT_B_OFF && reg::mod_cfg == WAVEGEN_HW_MOD_CFG_OFF &&
+              reg::mod_depth == WAVEGEN_HW_MOD_DEPTH_OFF && reg::mod_freq_a == WAVEGEN_HW_MOD_FREQ_A_OFF &&
+              reg::mod_freq_b == WAVEGEN_HW_MOD_FREQ_B_OFF && reg::mod_dev_a == WAVEGEN_HW_MOD_DEV_A_OFF &&
+              reg::mod_dev_b == WAVEGEN_HW_MOD_DEV_B_OFF && reg::cnt_ctrl == WAVEGEN_HW_CNT_CTRL_OFF,
+              "baremetal register map: trigger and modulation");
+static_assert(reg::profile_sel == WAVEGEN_HW_PROFILE_SEL_OFF && reg::commit_ctrl == WAVEGEN_HW_COMMIT_CTRL_OFF &&
+              reg::commit_time == WAVEGEN_HW_COMMIT_TIME_OFF && reg::sample_cnt == WAVEGEN_HW_SAMPLE_CNT_OFF &&
+              reg::sync_cfg == WAVEGEN_HW_SYNC_CFG_OFF && reg::counters == WAVEGEN_HW_CNT_BASE_OFF &&
+              reg::sync_ctrl == WAVEGEN_HW_SYNC_CTRL_OFF && reg::sync_period == WAVEGEN_HW_SYNC_PERIOD_OFF &&
+              reg::noise_cfg == WAVEGEN_HW_NOISE_CFG_OFF && reg::noise_seed_a == WAVEGEN_HW_NOISE_SEED_A_OFF &&
+              reg::noise_seed_b == WAVEGEN_HW_NOISE_SEED_B_OFF && reg::arb_cfg == WAVEGEN_HW_ARB_CFG_OFF,
+              "baremetal register map: commit, sync, noise, ARB");
+static_assert(reg::cap_ctrl == WAVEGEN_HW_CAP_CTRL_OFF && reg::cap_cfg == WAVEGEN_HW_CAP_CFG_OFF &&
+              reg::cap_status == WAVEGEN_HW_CAP_STATUS_OFF && reg::cap_data == WAVEGEN_HW_CAP_DATA_OFF &&
+              reg::arb_data == WAVEGEN_HW_ARB_DATA_OFF && reg::profiles == WAVEGEN_HW_PROFILE_OFF &&
+              reg::profile_stride == WAVEGEN_HW_PROFILE_STRIDE,
+              "baremetal register map: windows");
+#endif
+
+// ============================================================
+// Channels and modes
+// ============================================================
+enum class Channel : unsigned { A = WAVEGEN_CHANNEL_A, B = WAVEGEN_CHANNEL_B };
+
+enum class Mode : std::uint32_t {
+    dc       = WAVEGEN_MODE_DC,
+    sine     = WAVEGEN_MODE_SINE,
+    sawtooth = WAVEGEN_MODE_SAWTOOTH,
+    triangle = WAVEGEN_MODE_TRIANGLE,
+    square   = WAVEGEN_MODE_SQUARE,
+    arb      = WAVEGEN_MODE_ARB,
+    noise    = WAVEGEN_MODE_NOISE,
+    quadrature = WAVEGEN_MODE_QUADRATURE
+};
+
+// Where a channel's fields sit in the shared registers
+template <Channel C>
+struct ChannelLayout {
+    static constexpr unsigned field_shift = (C == Channel::A) ? 0 : 16;  // 16-bit packed
+    static constexpr unsigned mode_shift  = (C == Channel::A) ? 0 : 4;
+    static constexpr std::uint32_t freq   = (C == Channel::A) ? reg::freq_a : reg::freq_b;
+    static constexpr std::uint32_t run    = (C == Channel::A) ? 0x1 : 0x2;
+};
+
+// ============================================================
+// Unit conversion (constexpr)
+// ============================================================
+namespace detail {
+
+// Deliberately not constexpr: reaching it in a constant expression is a
+// compile error, so out-of-range constants are caught at build time.
+inline void out_of_range() {}
+
+constexpr std::int64_t round_half_away(double x)
+{
+    return static_cast<std::int64_t>(x < 0 ? x - 0.5 : x + 0.5);
+}
+
+constexpr std::int64_t to_word(double x, std::int64_t lo, std::int64_t hi)
+{
+    if (!(x >= static_cast<double>(lo) - 0.5 && x <= static_cast<double>(hi) + 0.5)) {
+        out_of_range();
+        return x > 0 ? hi : lo;     // NaN saturates low
+    }
+    std::int64_t v = round_half_away(x);
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+constexpr std::uint32_t pack16(std::uint16_t a, std::uint16_t b)
+{
+    return static_cast<std::uint32_t>(a) | (static_cast<std::uint32_t>(b) << 16);
+}
+
+} // namespace detail
+
+// FREQ register word, 100uHz units
+struct Frequency {
+    std::uint32_t word;
+
+    static constexpr Frequency hz(double f)
+    {
+        return {static_cast<std::uint32_t>(detail::to_word(f * 10000.0, 0, 0xFFFFFFFFLL))};
+    }
+    static constexpr Frequency raw(std::uint32_t w) { return {w}; }
+};
+
+// PHASE field, 0.01 degree units (-180 to 180 degrees)
+struct Phase {
+    std::int16_t word;
+
+    static constexpr Phase degrees(double d)
+    {
+        return {static_cast<std::int16_t>(detail::to_word(d * 100.0, -18000, 18000))};
+    }
+    static constexpr Phase raw(std::int16_t w) { return {w}; }
+};
+
+// AMPLTD field, 0 to 32767 (full scale)
+struct Amplitude {
+    std::uint16_t word;
+
+    static constexpr Amplitude fraction(double f)
+    {
+        return {static_cast<std::uint16_t>(detail::to_word(f * 32767.0, 0, 32767))};
+    }
+    static constexpr Amplitude raw(std::uint16_t w) { return {w}; }
+};
+
+// OFFSET field, signed, 32767 = positive full scale
+struct Offset {
+    std::int16_t word;
+
+    static constexpr Offset fraction(double f)
+    {
+        return {static_cast<std::int16_t>(detail::to_word(f * 32767.0, -32768, 32767))};
+    }
+    static constexpr Offset raw(std::int16_t w) { return {w}; }
+};
+
+// DTCYC field, 0 to 65535 = 0 to 100%
+struct Duty {
+    std::uint16_t word;
+
+    static constexpr Duty fraction(double f)
+    {
+        return {static_cast<std::uint16_t>(detail::to_word(f * 65536.0, 0, 65535))};
+    }
+    static constexpr Duty raw(std::uint16_t w) { return {w}; }
+};
+
+namespace literals {
+constexpr Frequency operator""_Hz(long double f) { return Frequency::hz(static_cast<double>(f)); }
+constexpr Frequency operator""_Hz(unsigned long long f) { return Frequency::hz(static_cast<double>(f)); }
+constexpr Frequency operator""_kHz(long double f) { return Frequency::hz(static_cast<double>(f) * 1e3); }
+constexpr Frequency operator""_kHz(unsigned long long f) { return Frequency::hz(static_cast<double>(f) * 1e3); }
+constexpr Phase operator""_deg(long double d) { return Phase::degrees(static_cast<double>(d)); }
+constexpr Phase operator""_deg(unsigned long long d) { return Phase::degrees(static_cast<double>(d)); }
+} // namespace literals
+
+// ============================================================
+// Channel configuration and register images
+// ============================================================
+template <Channel C>
+struct ChannelConfig {
+    Mode mode = Mode::dc;
+    Frequency frequency{0};
+    Amplitude amplitude{0};
+    Offset offset{0};
+    Duty duty_cycle{32768};
+    Phase phase{0};
+    std::uint16_t cycles = 0;               // 0 = continuous
+};
+
+struct RegWrite {
+    std::uint32_t offset;
+    std::uint32_t value;
+};
+
+template <std::size_t N>
+using RegisterImage = std::array<RegWrite, N>;
+
+// The shadowed words of a two-channel setup (RECONFIG applies them)
+constexpr RegisterImage<8> image(const ChannelConfig<Channel::A> &a,
+                                 const ChannelConfig<Channel::B> &b)
+{
+    using LA = ChannelLayout<Channel::A>;
+    using LB = ChannelLayout<Channel::B>;
+
+    return {{
+        {reg::mode, (static_cast<std::uint32_t>(a.mode) << LA::mode_shift) |
+                    (static_cast<std::uint32_t>(b.mode) << LB::mode_shift)},
+        {LA::freq, a.frequency.word},
+        {LB::freq, b.frequency.word},
+        {reg::offset, detail::pack16(static_cast<std::uint16_t>(a.offset.word),
+                                     static_cast<std::uint16_t>(b.offset.word))},
+        {reg::amplitude, detail::pack16(a.amplitude.word, b.amplitude.word)},
+        {reg::duty_cycle, detail::pack16(a.duty_cycle.word, b.duty_cycle.word)},
+        {reg::cycles, detail::pack16(a.cycles, b.cycles)},
+        {reg::phase, detail::pack16(static_cast<std::uint16_t>(a.phase.word),
+                                    static_cast<std::uint16_t>(b.phase.word))},
+    }};
+}
+
+namespace preset {
+template <Channel C>
+inline constexpr ChannelConfig<C> off{};
+
+template <Channel C>
+inline constexpr ChannelConfig<C> sine_1khz{Mode::sine, Frequency::hz(1000), Amplitude::raw(32767)};
+
+template <Channel C>
+inline constexpr ChannelConfig<C> square_1khz{Mode::square, Frequency::hz(1000), Amplitude::raw(32767)};
+
+template <Channel C>
+inline constexpr ChannelConfig<C> triangle_1khz{Mode::triangle, Frequency::hz(1000), Amplitude::raw(32767)};
+
+template <Channel C>
+inline constexpr ChannelConfig<C> sawtooth_1khz{Mode::sawtooth, Frequency::hz(1000), Amplitude::raw(32767)};
+} // namespace preset
+
+static_assert(image(preset::sine_1khz<Channel::A>, preset::off<Channel::B>)[1].value == 10000000,
+              "1 kHz is 10000000 in 100uHz units, as in wavegen_preset_1khz_sine()");
+
+// ============================================================
+// Backends: write(offset, value), read(offset), apply()
+// ============================================================
+
+// Memory-mapped registers (baremetal, or /dev/mem / UIO mappings)
+class Mmio {
+public:
+    explicit constexpr Mmio(std::uintptr_t base) : base_(base) {}
+
+    void write(std::uint32_t off, std::uint32_t value) const
+    {
+#if defined(WAVEGEN_WRITE32)
+        WAVEGEN_WRITE32(base_ + off, value);
+#else
+        *reinterpret_cast<volatile std::uint32_t *>(base_ + off) = value;
+#endif
+    }
+
+    std::uint32_t read(std::uint32_t off) const
+    {
+#if defined(WAVEGEN_READ32)
+        return WAVEGEN_READ32(base_ + off);
+#else
+        return *reinterpret_cast<volatile std::uint32_t *>(base_ + off);
+#endif
+    }
+
+    void apply() const { write(reg::reconfig, 1); }
+
+    // Stores reach the bus as they are made
+    void flush() const {}
+
+private:
+    std::uintptr_t base_;
+};
+
+#ifdef WAVEGEN_HPP_IOCTL
+/*
+ * Linux driver through its command ring: write() only queues, apply()
+ * queues the RECONFIG and submits everything in one ioctl, read() submits
+ * and returns the value from its completion (0 if it failed). flush()
+ * submits queued writes without an apply; the destructor flushes too, so
+ * no queued write is dropped. Uses its own open of the device, so it
+ * does not disturb a ring mapped by wavegen_lib. error() returns the
+ * last negative errno seen (failed entry or ioctl), 0 if none. A command
+ * that finds the ring still full after a submit is not queued, and
+ * error() reports -EBUSY (as wavegen_lib's ring calls return
+ * WAVEGEN_ERR_BUSY).
+ */
+class Ioctl {
+public:
+    explicit Ioctl(const char *path = "/dev/wavegen")
+    {
+        long page = sysconf(_SC_PAGESIZE);
+
+        fd_ = ::open(path, O_RDWR);
+        if (fd_ < 0)
+            return;
+        len_ = (sizeof(wavegen_ring) + page - 1) & ~static_cast<std::size_t>(page - 1);
+        void *p = ::mmap(nullptr, len_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd_);
+            fd_ = -1;
+            return;
+        }
+        ring_ = static_cast<wavegen_ring *>(p);
+        sq_tail_ = __atomic_load_n(&ring_->sq_tail, __ATOMIC_RELAXED);
+        cq_head_ = __atomic_load_n(&ring_->cq_head, __ATOMIC_RELAXED);
+    }
+
+    ~Ioctl()
+    {
+        flush();
+        if (ring_)
+            ::munmap(ring_, len_);
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+
+    Ioctl(const Ioctl &) = delete;
+    Ioctl &operator=(const Ioctl &) = delete;
+
+    bool ok() const { return ring_ != nullptr; }
+    int error() const { return error_; }
+
+    void write(std::uint32_t off, std::uint32_t value)
+    {
+        push(WAVEGEN_RING_OP_WRITE, off, value, 0);
+    }
+
+    std::uint32_t read(std::uint32_t off)
+    {
+        want_ = ++tag_ ? tag_ : ++tag_;
+        found_ = false;
+        if (!push(WAVEGEN_RING_OP_READ, off, 0, want_))
+            return 0;
+        submit();
+        return found_ ? value_ : 0;
+    }
+
+    void apply()
+    {
+        if (push(WAVEGEN_RING_OP_APPLY, 0, 0, 0))
+            submit();
+    }
+
+    // Execute everything queued without an apply
+    void flush() { submit(); }
+
+    void submit()
+    {
+        wavegen_ring_submit req{};
+
+        if (!ok())
+            return;
+        req.to_submit = queued();
+        if (req.to_submit && ::ioctl(fd_, WAVEGEN_IOCTL_RING_SUBMIT, &req) < 0)
+            error_ = -errno;
+        reap();
+    }
+
+private:
+    // Consume completions: read results and failed entries
+    void reap()
+    {
+        std::uint32_t tail = __atomic_load_n(&ring_->cq_tail, __ATOMIC_ACQUIRE);
+
+        for (; cq_head_ != tail; cq_head_++) {
+            const wavegen_cqe &c = ring_->cq[cq_head_ & (WAVEGEN_RING_CQ_ENTRIES - 1)];
+            if (c.result < 0)
+                error_ = c.result;
+            else if (c.tag == want_ && want_) {
+                value_ = c.value;
+                found_ = true;
+            }
+        }
+        __atomic_store_n(&ring_->cq_head, cq_head_, __ATOMIC_RELEASE);
+    }
+
+    std::uint32_t queued() const
+    {
+        return sq_tail_ - __atomic_load_n(&ring_->sq_head, __ATOMIC_ACQUIRE);
+    }
+
+    // Queue one entry; false if the ring is still full after a submit
+    bool push(std::uint8_t opcode, std::uint32_t off, std::uint32_t value, std::uint32_t tag)
+    {
+        if (!ok())
+            return false;
+        if (queued() >= WAVEGEN_RING_SQ_ENTRIES) {
+            submit();
+            if (queued() >= WAVEGEN_RING_SQ_ENTRIES) {
+                error_ = -EBUSY;
+                return false;
+            }
+        }
+
+        wavegen_sqe &e = ring_->sq[sq_tail_ & (WAVEGEN_RING_SQ_ENTRIES - 1)];
+        e.opcode = opcode;
+        e.flags = 0;
+        e.reserved = 0;
+        e.offset = off;
+        e.value = value;
+        e.tag = tag;
+        __atomic_store_n(&ring_->sq_tail, ++sq_tail_, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    int fd_ = -1;
+    wavegen_ring *ring_ = nullptr;
+    std::size_t len_ = 0;
+    std::uint32_t sq_tail_ = 0;
+    std::uint32_t cq_head_ = 0;
+    std::uint32_t tag_ = 0;
+    std::uint32_t want_ = 0;
+    std::uint32_t value_ = 0;
+    bool found_ = false;
+    int error_ = 0;
+};
+#endif
+
+// ============================================================
+// Operations on any backend
+// ============================================================
+
+// Write a register image, then apply it
+template <class Bus, std::size_t N>
+void load(Bus &bus, const RegisterImage<N> &img)
+{
+    for (const RegWrite &w : img)
+        bus.write(w.offset, w.value);
+    bus.apply();
+}
+
+// Set both run bits (one write, no read-modify-write); not shadowed, so
+// a queuing backend submits it at once
+template <class Bus>
+void run(Bus &bus, bool a, bool b)
+{
+    bus.write(reg::run, (a ? 0x1u : 0u) | (b ? 0x2u : 0u));
+    bus.flush();
+}
+
+// Shadowed: takes effect on the next apply(), which also submits it
+template <Channel C, class Bus>
+void set_frequency(Bus &bus, Frequency f)
+{
+    bus.write(ChannelLayout<C>::freq, f.word);
+}
+
+template <class Bus>
+std::uint32_t status(Bus &bus)
+{
+    return bus.read(reg::status);
+}
+
+} // namespace wavegen
+
+#endif /* WAVEGEN_HPP */
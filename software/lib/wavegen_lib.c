@@ -2,9 +2,12 @@
 #include <unistd.h>
 #include <string.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <stdlib.h>
+#include <errno.h>
 #include "wavegen_lib.h"
 #include "../driver/wavegen_ip.h"
+#include "../driver/wavegen_regs.h"
 
 /* ============================================================
  * Internal state
@@ -13,6 +16,18 @@ static int fd = -1;
 static wavegen_mode_t current_mode_a = WAVEGEN_MODE_DC;
 static wavegen_mode_t current_mode_b = WAVEGEN_MODE_DC;
 
+/* Command ring mapping and the indices this side produces */
+static struct wavegen_ring *ring = NULL;
+static size_t ring_len;
+static uint32_t ring_sq_tail;
+static uint32_t ring_cq_head;
+
+/* A call the driver refused with EBUSY hit another open file's claim */
+static wavegen_error_t ioctl_error(void)
+{
+    return errno == EBUSY ? WAVEGEN_ERR_BUSY : WAVEGEN_ERR_IOCTL;
+}
+
 /* ============================================================
  * Core API
  * ============================================================ */
@@ -29,6 +44,10 @@ wavegen_error_t wavegen_init(void)
 
 void wavegen_close(void)
 {
+    if (ring) {
+        munmap(ring, ring_len);
+        ring = NULL;
+    }
     if (fd >= 0) {
         close(fd);
         fd = -1;
@@ -44,7 +63,7 @@ wavegen_error_t wavegen_set_mode(wavegen_channel_t channel, wavegen_mode_t mode)
     struct wavegen_mode config;
 
     if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
-    if (mode > WAVEGEN_MODE_ARB) return WAVEGEN_ERR_PARAM;
+    if (mode > WAVEGEN_MODE_QUADRATURE) return WAVEGEN_ERR_PARAM;
 
     /* Read-modify-write: preserve the other channel's mode */
     if (channel == WAVEGEN_CH_A) {
@@ -65,7 +84,7 @@ wavegen_error_t wavegen_set_mode(wavegen_channel_t channel, wavegen_mode_t mode)
     }
 
     if (ioctl(fd, WAVEGEN_IOCTL_SET_MODE, &config) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
@@ -86,7 +105,7 @@ wavegen_error_t wavegen_set_frequency(wavegen_channel_t channel, uint32_t freque
     config.value = frequency;
 
     if (ioctl(fd, WAVEGEN_IOCTL_SET_FREQUENCY, &config) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
@@ -107,7 +126,7 @@ wavegen_error_t wavegen_set_amplitude(wavegen_channel_t channel, uint16_t amplit
     config.value = amplitude;
 
     if (ioctl(fd, WAVEGEN_IOCTL_SET_AMPLITUDE, &config) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
@@ -128,7 +147,7 @@ wavegen_error_t wavegen_set_offset(wavegen_channel_t channel, int16_t offset)
     config.value = offset;
 
     if (ioctl(fd, WAVEGEN_IOCTL_SET_OFFSET, &config) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
@@ -149,7 +168,7 @@ wavegen_error_t wavegen_set_duty_cycle(wavegen_channel_t channel, uint16_t duty_
     config.value = duty_cycle;
 
     if (ioctl(fd, WAVEGEN_IOCTL_SET_DUTY_CYCLE, &config) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
@@ -173,7 +192,7 @@ wavegen_error_t wavegen_set_phase_offset(wavegen_channel_t channel, int16_t phas
     config.value = phase_offset;
 
     if (ioctl(fd, WAVEGEN_IOCTL_SET_PHASE_OFFSET, &config) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
@@ -194,7 +213,7 @@ wavegen_error_t wavegen_set_cycles(wavegen_channel_t channel, uint16_t cycles)
     config.value = cycles;
 
     if (ioctl(fd, WAVEGEN_IOCTL_SET_CYCLES, &config) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
@@ -218,7 +237,7 @@ wavegen_error_t wavegen_enable(wavegen_channel_t channel, int enable)
         config.channel_b = enable ? 1 : 0;
 
     if (ioctl(fd, WAVEGEN_IOCTL_ENABLE, &config) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
@@ -240,7 +259,63 @@ wavegen_error_t wavegen_apply(void)
 {
     if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
     if (ioctl(fd, WAVEGEN_IOCTL_RECONFIG) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
+    return WAVEGEN_OK;
+}
+
+static wavegen_error_t wavegen_commit(unsigned int mode, uint64_t sample)
+{
+    struct wavegen_commit c;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+
+    c.mode = mode;
+    c.reserved = 0;
+    c.sample = sample;
+    if (ioctl(fd, WAVEGEN_IOCTL_COMMIT, &c) < 0)
+        return ioctl_error();
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_apply_at(uint64_t sample)
+{
+    return wavegen_commit(WAVEGEN_COMMIT_AT, sample);
+}
+
+wavegen_error_t wavegen_apply_at_wrap(wavegen_channel_t channel)
+{
+    if (channel == WAVEGEN_CH_A)
+        return wavegen_commit(WAVEGEN_COMMIT_WRAP_A, 0);
+    if (channel == WAVEGEN_CH_B)
+        return wavegen_commit(WAVEGEN_COMMIT_WRAP_B, 0);
+    return fd < 0 ? WAVEGEN_ERR_NOT_INIT : WAVEGEN_ERR_PARAM;
+}
+
+wavegen_error_t wavegen_cancel_apply(void)
+{
+    return wavegen_commit(WAVEGEN_COMMIT_NONE, 0);
+}
+
+wavegen_error_t wavegen_get_sample_count(uint64_t *count)
+{
+    struct wavegen_sample_count sc;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!count) return WAVEGEN_ERR_PARAM;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_SAMPLE_COUNT, &sc) < 0)
+        return ioctl_error();
+    *count = sc.count;
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_get_commit_status(int *pending, int *late)
+{
+    struct wavegen_sample_count sc;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_SAMPLE_COUNT, &sc) < 0)
+        return ioctl_error();
+    if (pending) *pending = sc.commit_pending ? 1 : 0;
+    if (late) *late = sc.commit_late ? 1 : 0;
     return WAVEGEN_OK;
 }
 
@@ -253,7 +328,7 @@ wavegen_error_t wavegen_trigger(wavegen_channel_t channel)
     trig.channel_b = (channel == WAVEGEN_CH_B || channel == WAVEGEN_CH_BOTH) ? 1 : 0;
 
     if (ioctl(fd, WAVEGEN_IOCTL_TRIGGER, &trig) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
@@ -267,7 +342,7 @@ wavegen_error_t wavegen_reset(wavegen_channel_t channel)
     rst.channel_b = (channel == WAVEGEN_CH_B || channel == WAVEGEN_CH_BOTH) ? 1 : 0;
 
     if (ioctl(fd, WAVEGEN_IOCTL_SOFT_RESET, &rst) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
@@ -279,12 +354,150 @@ wavegen_error_t wavegen_get_status(wavegen_status_t *status)
     if (!status) return WAVEGEN_ERR_PARAM;
 
     if (ioctl(fd, WAVEGEN_IOCTL_GET_STATUS, &raw) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     status->ready = raw.ready;
     status->reconfig_busy = raw.reconfig_busy;
     status->channel_a_running = raw.channel_a_running;
     status->channel_b_running = raw.channel_b_running;
+    status->channel_a_armed = raw.channel_a_armed;
+    status->channel_b_armed = raw.channel_b_armed;
+    return WAVEGEN_OK;
+}
+
+/* ============================================================
+ * Trigger API
+ * ============================================================ */
+
+wavegen_error_t wavegen_set_trigger_config(wavegen_channel_t channel, int arm,
+                                           int external, wavegen_trigger_edge_t edge)
+{
+    struct wavegen_trigger_config config;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (edge > WAVEGEN_EDGE_BOTH) return WAVEGEN_ERR_PARAM;
+
+    if (channel == WAVEGEN_CH_BOTH) {
+        wavegen_error_t ret;
+        ret = wavegen_set_trigger_config(WAVEGEN_CH_A, arm, external, edge);
+        if (ret != WAVEGEN_OK) return ret;
+        return wavegen_set_trigger_config(WAVEGEN_CH_B, arm, external, edge);
+    }
+
+    config.channel = (channel == WAVEGEN_CH_A) ? 0 : 1;
+    config.arm = arm ? 1 : 0;
+    config.external = external ? 1 : 0;
+    config.edge = edge;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_SET_TRIGGER_CONFIG, &config) < 0)
+        return ioctl_error();
+
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_get_trigger_latency(wavegen_channel_t channel, uint32_t *cycles)
+{
+    struct wavegen_trigger_latency lat;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!cycles || channel == WAVEGEN_CH_BOTH) return WAVEGEN_ERR_PARAM;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_TRIGGER_LATENCY, &lat) < 0)
+        return ioctl_error();
+
+    *cycles = (channel == WAVEGEN_CH_A) ? lat.channel_a : lat.channel_b;
+    return WAVEGEN_OK;
+}
+
+/* ============================================================
+ * Modulation
+ * ============================================================ */
+
+wavegen_error_t wavegen_set_modulation(wavegen_channel_t channel,
+                                       const wavegen_modulation_t *mod)
+{
+    struct wavegen_modulation config;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!mod || mod->type > WAVEGEN_MOD_PM || mod->depth > 32767)
+        return WAVEGEN_ERR_PARAM;
+
+    if (channel == WAVEGEN_CH_BOTH) {
+        wavegen_error_t ret;
+        ret = wavegen_set_modulation(WAVEGEN_CH_A, mod);
+        if (ret != WAVEGEN_OK) return ret;
+        return wavegen_set_modulation(WAVEGEN_CH_B, mod);
+    }
+
+    config.channel = (channel == WAVEGEN_CH_A) ? 0 : 1;
+    config.type = mod->type;
+    config.source = (mod->source == WAVEGEN_MOD_SRC_OTHER) ? 1 : 0;
+    config.depth = mod->depth;
+    config.frequency = mod->frequency;
+    config.deviation = mod->deviation;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_SET_MODULATION, &config) < 0)
+        return ioctl_error();
+
+    return WAVEGEN_OK;
+}
+
+/* ============================================================
+ * Noise
+ * ============================================================ */
+
+wavegen_error_t wavegen_set_noise(wavegen_channel_t channel, int gaussian, uint32_t seed)
+{
+    struct wavegen_noise config;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (channel > WAVEGEN_CH_BOTH) return WAVEGEN_ERR_PARAM;
+
+    if (channel == WAVEGEN_CH_BOTH) {
+        wavegen_error_t ret;
+        ret = wavegen_set_noise(WAVEGEN_CH_A, gaussian, seed);
+        if (ret != WAVEGEN_OK) return ret;
+        return wavegen_set_noise(WAVEGEN_CH_B, gaussian, ~seed);
+    }
+
+    config.channel = (channel == WAVEGEN_CH_A) ? 0 : 1;
+    config.gaussian = gaussian ? 1 : 0;
+    config.seed = seed;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_SET_NOISE, &config) < 0)
+        return ioctl_error();
+
+    return WAVEGEN_OK;
+}
+
+/* ============================================================
+ * Performance Counters
+ * ============================================================ */
+
+wavegen_error_t wavegen_get_counters(wavegen_counters_t *counters)
+{
+    struct wavegen_counters raw;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!counters) return WAVEGEN_ERR_PARAM;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_COUNTERS, &raw) < 0)
+        return ioctl_error();
+
+    counters->clk_count = raw.clk_count;
+    counters->samples_a = raw.samples_a;
+    counters->samples_b = raw.samples_b;
+    counters->since_trigger_a = raw.since_trigger_a;
+    counters->since_trigger_b = raw.since_trigger_b;
+    counters->cycles_a = raw.cycles_a;
+    counters->cycles_b = raw.cycles_b;
+    counters->dac_frames = raw.dac_frames;
+    counters->underflows = raw.underflows;
+    counters->overruns = raw.overruns;
+    counters->reconfigs = raw.reconfigs;
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_clear_counters(void)
+{
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (ioctl(fd, WAVEGEN_IOCTL_CLEAR_COUNTERS) < 0)
+        return ioctl_error();
     return WAVEGEN_OK;
 }
 
@@ -323,6 +536,274 @@ wavegen_error_t wavegen_configure(wavegen_channel_t channel,
     return wavegen_apply();
 }
 
+/* ============================================================
+ * Profile API
+ * ============================================================ */
+
+static uint32_t pack_pair(uint16_t a, uint16_t b)
+{
+    return ((uint32_t)b << 16) | a;
+}
+
+wavegen_error_t wavegen_store_profile(uint32_t index,
+                                       const wavegen_config_t *config_a,
+                                       const wavegen_config_t *config_b)
+{
+    struct wavegen_profile p;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!config_a || !config_b || index >= WAVEGEN_MAX_PROFILES)
+        return WAVEGEN_ERR_PARAM;
+    if (config_a->mode > WAVEGEN_MODE_QUADRATURE || config_b->mode > WAVEGEN_MODE_QUADRATURE)
+        return WAVEGEN_ERR_PARAM;
+    if (config_a->phase_offset < -18000 || config_a->phase_offset > 18000 ||
+        config_b->phase_offset < -18000 || config_b->phase_offset > 18000)
+        return WAVEGEN_ERR_PARAM;
+
+    p.index      = index;
+    p.mode       = ((uint32_t)config_b->mode << 4) | config_a->mode;
+    p.freq_a     = config_a->frequency;
+    p.freq_b     = config_b->frequency;
+    p.offset     = pack_pair((uint16_t)config_a->offset, (uint16_t)config_b->offset);
+    p.amplitude  = pack_pair(config_a->amplitude, config_b->amplitude);
+    p.duty_cycle = pack_pair(config_a->duty_cycle, config_b->duty_cycle);
+    p.cycles     = pack_pair(config_a->cycles, config_b->cycles);
+    p.phase      = pack_pair((uint16_t)config_a->phase_offset,
+                             (uint16_t)config_b->phase_offset);
+
+    if (ioctl(fd, WAVEGEN_IOCTL_SET_PROFILE, &p) < 0)
+        return ioctl_error();
+
+    return WAVEGEN_OK;
+}
+
+/* Re-read the modes of the applied profile so wavegen_set_mode keeps
+ * the other channel's mode */
+static wavegen_error_t sync_profile_modes(uint32_t index)
+{
+    struct wavegen_profile p;
+
+    p.index = index;
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_PROFILE, &p) < 0)
+        return ioctl_error();
+
+    current_mode_a = (wavegen_mode_t)(p.mode & 0xF);
+    current_mode_b = (wavegen_mode_t)((p.mode >> 4) & 0xF);
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_select_profile(uint32_t index)
+{
+    struct wavegen_profile_select sel;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (index >= WAVEGEN_MAX_PROFILES) return WAVEGEN_ERR_PARAM;
+
+    sel.index = index;
+    sel.pins = 0;
+    sel.count = 0;
+    if (ioctl(fd, WAVEGEN_IOCTL_SELECT_PROFILE, &sel) < 0)
+        return ioctl_error();
+
+    return sync_profile_modes(sel.index);
+}
+
+wavegen_error_t wavegen_set_profile_pins(int enable)
+{
+    struct wavegen_profile_select sel;
+    uint32_t active;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_PROFILE_SELECT, &sel) < 0)
+        return ioctl_error();
+
+    /* Leaving pin select keeps the profile the pins last applied */
+    active = sel.index;
+    sel.pins = enable ? 1 : 0;
+    if (ioctl(fd, WAVEGEN_IOCTL_SELECT_PROFILE, &sel) < 0)
+        return ioctl_error();
+
+    return enable ? WAVEGEN_OK : sync_profile_modes(active);
+}
+
+wavegen_error_t wavegen_get_profile(uint32_t *index, int *pins, uint32_t *count)
+{
+    struct wavegen_profile_select sel;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_PROFILE_SELECT, &sel) < 0)
+        return ioctl_error();
+
+    if (index) *index = sel.index;
+    if (pins) *pins = sel.pins ? 1 : 0;
+    if (count) *count = sel.count;
+    return sync_profile_modes(sel.index);
+}
+
+/* ============================================================
+ * Multi-Board Sync
+ * ============================================================ */
+
+wavegen_error_t wavegen_sync_setup(int master, uint32_t period, int reset_count)
+{
+    struct wavegen_sync s;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+
+    /* Read-modify-write: keep the channel arms */
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_SYNC, &s) < 0)
+        return ioctl_error();
+    s.loopback = master ? 1 : 0;
+    s.period = period;
+    s.reset_count = reset_count ? 1 : 0;
+    if (ioctl(fd, WAVEGEN_IOCTL_SET_SYNC, &s) < 0)
+        return ioctl_error();
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_sync_arm(wavegen_channel_t channel, wavegen_sync_mode_t mode)
+{
+    struct wavegen_sync s;
+    unsigned int cfg;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (channel > WAVEGEN_CH_BOTH) return WAVEGEN_ERR_PARAM;
+
+    if (mode == WAVEGEN_SYNC_ONCE)
+        cfg = WAVEGEN_SYNC_CFG_ARM;
+    else if (mode == WAVEGEN_SYNC_EVERY)
+        cfg = WAVEGEN_SYNC_CFG_EVERY;
+    else if (mode == WAVEGEN_SYNC_OFF)
+        cfg = 0;
+    else
+        return WAVEGEN_ERR_PARAM;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_SYNC, &s) < 0)
+        return ioctl_error();
+    if (channel == WAVEGEN_CH_A || channel == WAVEGEN_CH_BOTH)
+        s.cfg_a = cfg;
+    if (channel == WAVEGEN_CH_B || channel == WAVEGEN_CH_BOTH)
+        s.cfg_b = cfg;
+    if (ioctl(fd, WAVEGEN_IOCTL_SET_SYNC, &s) < 0)
+        return ioctl_error();
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_sync_fire(void)
+{
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (ioctl(fd, WAVEGEN_IOCTL_SYNC_FIRE) < 0)
+        return ioctl_error();
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_sync_armed(wavegen_channel_t channel, int *armed)
+{
+    struct wavegen_sync s;
+    unsigned int cfg = 0;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!armed || channel > WAVEGEN_CH_BOTH) return WAVEGEN_ERR_PARAM;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_SYNC, &s) < 0)
+        return ioctl_error();
+    if (channel == WAVEGEN_CH_A || channel == WAVEGEN_CH_BOTH)
+        cfg |= s.cfg_a;
+    if (channel == WAVEGEN_CH_B || channel == WAVEGEN_CH_BOTH)
+        cfg |= s.cfg_b;
+    *armed = (cfg & WAVEGEN_SYNC_CFG_ARM) ? 1 : 0;
+    return WAVEGEN_OK;
+}
+
+/* ============================================================
+ * Output Capture
+ * ============================================================ */
+
+wavegen_error_t wavegen_capture_arm(const wavegen_capture_config_t *config)
+{
+    struct wavegen_capture_config raw;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!config || config->trigger > WAVEGEN_CAPTURE_TRIG_SYNC)
+        return WAVEGEN_ERR_PARAM;
+
+    raw.source = (config->source == WAVEGEN_CAPTURE_OUTPUT) ? 1 : 0;
+    raw.trigger = config->trigger;
+    raw.pre_trigger = config->pre_trigger;
+    raw.decimation = config->decimation;
+    if (ioctl(fd, WAVEGEN_IOCTL_CAPTURE_ARM, &raw) < 0)
+        return ioctl_error();
+
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_capture_trigger(void)
+{
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_CAPTURE_TRIGGER) < 0)
+        return ioctl_error();
+
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_capture_wait(uint32_t timeout_ms)
+{
+    struct wavegen_capture_status st;
+    uint64_t waited_us = 0;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+
+    for (;;) {
+        if (ioctl(fd, WAVEGEN_IOCTL_GET_CAPTURE_STATUS, &st) < 0)
+            return ioctl_error();
+        if (st.done)
+            return WAVEGEN_OK;
+        if (waited_us >= timeout_ms * 1000ULL)
+            return WAVEGEN_ERR_BUSY;
+        usleep(100);
+        waited_us += 100;
+    }
+}
+
+wavegen_error_t wavegen_capture_depth(uint32_t *depth)
+{
+    struct wavegen_capture_status st;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!depth) return WAVEGEN_ERR_PARAM;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_CAPTURE_STATUS, &st) < 0)
+        return ioctl_error();
+    *depth = st.depth;
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_capture_read(uint32_t start, uint32_t count,
+                                     int16_t *a, int16_t *b)
+{
+    struct wavegen_capture_status st;
+    struct wavegen_capture_read rd;
+    unsigned int *buf;
+    uint32_t i;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (count == 0 || (!a && !b)) return WAVEGEN_ERR_PARAM;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_CAPTURE_STATUS, &st) < 0)
+        return ioctl_error();
+    if (!st.done) return WAVEGEN_ERR_BUSY;
+    if (start >= st.depth || count > st.depth - start) return WAVEGEN_ERR_PARAM;
+
+    buf = malloc(count * sizeof(*buf));
+    if (!buf) return WAVEGEN_ERR_ALLOC;
+
+    rd.start = start;
+    rd.count = count;
+    rd.data = buf;
+    if (ioctl(fd, WAVEGEN_IOCTL_READ_CAPTURE, &rd) < 0) {
+        free(buf);
+        return ioctl_error();
+    }
+    for (i = 0; i < count; i++) {
+        if (a) a[i] = (int16_t)(buf[i] & 0xFFFF);
+        if (b) b[i] = (int16_t)(buf[i] >> 16);
+    }
+    free(buf);
+    return WAVEGEN_OK;
+}
+
 /* ============================================================
  * Arbitrary Waveform API
  * ============================================================ */
@@ -334,7 +815,28 @@ wavegen_error_t wavegen_set_arb_depth(uint32_t depth)
 
     config.depth = depth;
     if (ioctl(fd, WAVEGEN_IOCTL_SET_ARB_DEPTH, &config) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
+
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_set_arb_interpolation(wavegen_channel_t channel, int enable)
+{
+    struct wavegen_arb_interp config;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (channel > WAVEGEN_CH_BOTH) return WAVEGEN_ERR_PARAM;
+
+    if (channel == WAVEGEN_CH_BOTH) {
+        wavegen_error_t ret;
+        ret = wavegen_set_arb_interpolation(WAVEGEN_CH_A, enable);
+        if (ret != WAVEGEN_OK) return ret;
+        return wavegen_set_arb_interpolation(WAVEGEN_CH_B, enable);
+    }
+
+    config.channel = (channel == WAVEGEN_CH_A) ? 0 : 1;
+    config.enable = enable ? 1 : 0;
+    if (ioctl(fd, WAVEGEN_IOCTL_SET_ARB_INTERP, &config) < 0)
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
@@ -343,43 +845,565 @@ wavegen_error_t wavegen_set_arb_sample(uint32_t index, uint16_t value)
 {
     struct wavegen_arb_waveform_data config;
     if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (index >= WAVEGEN_ARB_MAX_SAMPLES) return WAVEGEN_ERR_PARAM;
 
     config.offset = index;
     config.value = value;
     if (ioctl(fd, WAVEGEN_IOCTL_SET_ARB_DATA, &config) < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
 
     return WAVEGEN_OK;
 }
 
-wavegen_error_t wavegen_load_arb_waveform(const uint16_t *data, uint32_t count)
+/* The driver accepts at most this many samples per bulk ioctl */
+#define WAVEGEN_ARB_BULK_MAX 4096
+
+wavegen_error_t wavegen_write_arb(uint32_t start, const uint16_t *data,
+                                  uint32_t count)
 {
     struct wavegen_arb_waveform_bulk bulk;
     unsigned int *buf;
-    unsigned int i;
+    unsigned int i, n;
+    int ret = 0;
 
     if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
     if (!data || count == 0) return WAVEGEN_ERR_PARAM;
+    if (count > WAVEGEN_ARB_MAX_SAMPLES || start > WAVEGEN_ARB_MAX_SAMPLES - count)
+        return WAVEGEN_ERR_PARAM;
 
     /* Convert uint16_t array to unsigned int array for ioctl */
-    buf = (unsigned int *)malloc(count * sizeof(unsigned int));
+    n = count < WAVEGEN_ARB_BULK_MAX ? count : WAVEGEN_ARB_BULK_MAX;
+    buf = (unsigned int *)malloc(n * sizeof(unsigned int));
     if (!buf) return WAVEGEN_ERR_ALLOC;
 
-    for (i = 0; i < count; i++)
-        buf[i] = data[i];
+    while (count > 0 && ret >= 0) {
+        n = count < WAVEGEN_ARB_BULK_MAX ? count : WAVEGEN_ARB_BULK_MAX;
+        for (i = 0; i < n; i++)
+            buf[i] = data[i];
 
-    bulk.start_offset = 0;
-    bulk.count = count;
-    bulk.data = buf;
+        bulk.start_offset = start;
+        bulk.count = n;
+        bulk.data = buf;
+        ret = ioctl(fd, WAVEGEN_IOCTL_SET_ARB_BULK, &bulk);
 
-    int ret = ioctl(fd, WAVEGEN_IOCTL_SET_ARB_BULK, &bulk);
+        start += n;
+        data += n;
+        count -= n;
+    }
     free(buf);
 
     if (ret < 0)
-        return WAVEGEN_ERR_IOCTL;
+        return ioctl_error();
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_load_arb_waveform(const uint16_t *data, uint32_t count)
+{
+    wavegen_error_t ret;
+
+    ret = wavegen_write_arb(0, data, count);
+    if (ret != WAVEGEN_OK)
+        return ret;
+
+    /* Also set the depth register, and the plain format for the samples */
+    ret = wavegen_set_arb_depth(count);
+    if (ret != WAVEGEN_OK)
+        return ret;
+    return wavegen_set_arb_format(WAVEGEN_ARB_RAW);
+}
+
+wavegen_error_t wavegen_load_arb_cached(const uint16_t *data, uint32_t count,
+                                        int *hit)
+{
+    struct wavegen_arb_cached req;
+
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!data || count == 0 || count > WAVEGEN_ARB_BULK_MAX)
+        return WAVEGEN_ERR_PARAM;
+
+    req.start_offset = 0;
+    req.count = count;
+    req.depth = count;
+    req.hit = 0;
+    req.hash = wavegen_arb_hash(data, count);
+    req.data = (unsigned short *)data;
+    if (ioctl(fd, WAVEGEN_IOCTL_LOAD_ARB_CACHED, &req) < 0)
+        return ioctl_error();
+
+    if (hit)
+        *hit = req.hit ? 1 : 0;
+    return wavegen_set_arb_format(WAVEGEN_ARB_RAW);
+}
+
+wavegen_error_t wavegen_get_arb_cache_stats(wavegen_arb_cache_stats_t *stats)
+{
+    struct wavegen_arb_cache_stats raw;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!stats) return WAVEGEN_ERR_PARAM;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_ARB_CACHE_STATS, &raw) < 0)
+        return ioctl_error();
+
+    stats->hits = raw.hits;
+    stats->misses = raw.misses;
+    stats->samples_skipped = raw.samples_skipped;
+    stats->samples_written = raw.samples_written;
+    return WAVEGEN_OK;
+}
+
+/* ============================================================
+ * Compressed ARB
+ * ============================================================ */
+
+/* Samples per block: 16 byte or 32 nibble slots, slot 0 the shift */
+static uint32_t arb_block_samples(wavegen_arb_format_t format)
+{
+    return format == WAVEGEN_ARB_DELTA4 ? 32 : 16;
+}
+
+static int arb_slot(wavegen_arb_format_t format, const uint16_t *block,
+                    uint32_t slot)
+{
+    uint16_t word;
+
+    if (format == WAVEGEN_ARB_DELTA4) {
+        int v;
+        word = block[1 + slot / 4];
+        v = (word >> (4 * (slot % 4))) & 0xF;
+        return v >= 8 ? v - 16 : v;
+    }
+    word = block[1 + slot / 2];
+    return (int8_t)(word >> (8 * (slot % 2)));
+}
+
+/* Offset from the key in steps of 2^shift, rounded (arithmetic shift) */
+static int32_t arb_steps(uint16_t sample, int32_t key, int shift)
+{
+    return ((int16_t)sample - key + ((1 << shift) >> 1)) >> shift;
+}
+
+/* Sample j of a block, as the IP's decoder computes it */
+static int16_t arb_block_sample(wavegen_arb_format_t format,
+                                const uint16_t *block, uint32_t j)
+{
+    int32_t sum = 0, value;
+    uint32_t m;
+
+    for (m = 1; m <= j; m++)
+        sum += arb_slot(format, block, m);
+    value = (int16_t)block[0] + sum * (1 << (arb_slot(format, block, 0) & 0xF));
+    if (value > 32767) value = 32767;
+    if (value < -32768) value = -32768;
+    return (int16_t)value;
+}
+
+uint32_t wavegen_arb_encoded_words(wavegen_arb_format_t format, uint32_t count)
+{
+    uint32_t per = arb_block_samples(format);
+
+    if (format == WAVEGEN_ARB_RAW)
+        return count;
+    return (count + per - 1) / per * WAVEGEN_ARB_BLOCK_WORDS;
+}
+
+wavegen_error_t wavegen_arb_encode(wavegen_arb_format_t format,
+                                   const uint16_t *samples, uint32_t count,
+                                   uint16_t *words, uint32_t max_words,
+                                   wavegen_arb_encode_info_t *info)
+{
+    uint32_t per = arb_block_samples(format);
+    int lim = format == WAVEGEN_ARB_DELTA4 ? 7 : 127;
+    uint32_t base, j, max_error = 0, lossy = 0;
+
+    if (format > WAVEGEN_ARB_DELTA4 || !samples || !words || count == 0)
+        return WAVEGEN_ERR_PARAM;
+    if (wavegen_arb_encoded_words(format, count) > max_words)
+        return WAVEGEN_ERR_PARAM;
+
+    if (format == WAVEGEN_ARB_RAW) {
+        memcpy(words, samples, count * sizeof(*samples));
+    } else {
+        for (base = 0; base < count; base += per) {
+            uint16_t *block = words + base / per * WAVEGEN_ARB_BLOCK_WORDS;
+            uint32_t n = count - base < per ? count - base : per;
+            int32_t key = (int16_t)samples[base];
+            int slots[32];
+            int shift;
+
+            /*
+             * Smallest shift whose steps all fit (15 always does). Each
+             * sample is quantized against the key, not the previous
+             * decoded value, so rounding errors do not accumulate.
+             */
+            for (shift = 0; shift < 15; shift++) {
+                for (j = 1; j < n; j++) {
+                    int32_t d = arb_steps(samples[base + j], key, shift) -
+                                arb_steps(samples[base + j - 1], key, shift);
+                    if (d > lim || d < -lim - 1)
+                        break;
+                }
+                if (j == n)
+                    break;
+            }
+
+            memset(slots, 0, sizeof(slots));
+            slots[0] = shift;
+            for (j = 1; j < n; j++)
+                slots[j] = arb_steps(samples[base + j], key, shift) -
+                           arb_steps(samples[base + j - 1], key, shift);
+            if (shift)
+                lossy++;
+
+            memset(block, 0, WAVEGEN_ARB_BLOCK_WORDS * sizeof(*block));
+            block[0] = (uint16_t)key;
+            for (j = 0; j < per; j++) {
+                if (format == WAVEGEN_ARB_DELTA4)
+                    block[1 + j / 4] |= (uint16_t)((slots[j] & 0xF) << (4 * (j % 4)));
+                else
+                    block[1 + j / 2] |= (uint16_t)((slots[j] & 0xFF) << (8 * (j % 2)));
+            }
+
+            for (j = 0; j < n; j++) {
+                int32_t err = arb_block_sample(format, block, j) - (int16_t)samples[base + j];
+                if (err < 0) err = -err;
+                if ((uint32_t)err > max_error) max_error = (uint32_t)err;
+            }
+        }
+    }
+
+    if (info) {
+        info->samples = count;
+        info->words = wavegen_arb_encoded_words(format, count);
+        info->ratio = (double)count / info->words;
+        info->max_error = max_error;
+        info->lossy_blocks = lossy;
+    }
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_arb_decode(wavegen_arb_format_t format,
+                                   const uint16_t *words, uint32_t count,
+                                   uint16_t *samples)
+{
+    uint32_t per = arb_block_samples(format);
+    uint32_t i;
+
+    if (format > WAVEGEN_ARB_DELTA4 || !words || !samples)
+        return WAVEGEN_ERR_PARAM;
+
+    for (i = 0; i < count; i++) {
+        if (format == WAVEGEN_ARB_RAW)
+            samples[i] = words[i];
+        else
+            samples[i] = (uint16_t)arb_block_sample(format,
+                             words + i / per * WAVEGEN_ARB_BLOCK_WORDS, i % per);
+    }
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_set_arb_format(wavegen_arb_format_t format)
+{
+    struct wavegen_arb_format config;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (format > WAVEGEN_ARB_DELTA4) return WAVEGEN_ERR_PARAM;
+
+    config.format = format;
+    if (ioctl(fd, WAVEGEN_IOCTL_SET_ARB_FORMAT, &config) < 0)
+        return ioctl_error();
+
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_load_arb_compressed(wavegen_arb_format_t format,
+                                           const uint16_t *samples,
+                                           uint32_t count,
+                                           wavegen_arb_encode_info_t *info)
+{
+    uint32_t words = wavegen_arb_encoded_words(format, count);
+    uint16_t *buf;
+    wavegen_error_t ret;
+
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (format > WAVEGEN_ARB_DELTA4 || !samples || count == 0)
+        return WAVEGEN_ERR_PARAM;
+
+    buf = malloc(words * sizeof(*buf));
+    if (!buf) return WAVEGEN_ERR_ALLOC;
+
+    ret = wavegen_arb_encode(format, samples, count, buf, words, info);
+    if (ret == WAVEGEN_OK)
+        ret = wavegen_write_arb(0, buf, words);
+    free(buf);
+    if (ret != WAVEGEN_OK)
+        return ret;
+
+    ret = wavegen_set_arb_depth(count);
+    if (ret != WAVEGEN_OK)
+        return ret;
+    return wavegen_set_arb_format(format);
+}
+
+/* ============================================================
+ * Command Ring API
+ * ============================================================ */
+
+wavegen_error_t wavegen_ring_init(void)
+{
+    long page = sysconf(_SC_PAGESIZE);
+    void *p;
+
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (ring) return WAVEGEN_OK;
+
+    ring_len = (sizeof(struct wavegen_ring) + page - 1) & ~(size_t)(page - 1);
+    p = mmap(NULL, ring_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+        return WAVEGEN_ERR_INIT;
+
+    ring = p;
+    ring_sq_tail = __atomic_load_n(&ring->sq_tail, __ATOMIC_RELAXED);
+    ring_cq_head = __atomic_load_n(&ring->cq_head, __ATOMIC_RELAXED);
+    return WAVEGEN_OK;
+}
+
+static wavegen_error_t ring_push(uint8_t opcode, uint32_t offset,
+                                 uint32_t value, uint32_t tag)
+{
+    struct wavegen_sqe *sqe;
+    wavegen_error_t err;
+
+    if (!ring) return WAVEGEN_ERR_NOT_INIT;
+
+    if (ring_sq_tail - __atomic_load_n(&ring->sq_head, __ATOMIC_ACQUIRE)
+            >= WAVEGEN_RING_SQ_ENTRIES) {
+        err = wavegen_ring_submit(NULL);
+        if (err != WAVEGEN_OK)
+            return err;
+        if (ring_sq_tail - __atomic_load_n(&ring->sq_head, __ATOMIC_ACQUIRE)
+                >= WAVEGEN_RING_SQ_ENTRIES)
+            return WAVEGEN_ERR_BUSY;    /* Blocked on unreaped completions */
+    }
+
+    sqe = &ring->sq[ring_sq_tail & (WAVEGEN_RING_SQ_ENTRIES - 1)];
+    sqe->opcode = opcode;
+    sqe->flags = 0;
+    sqe->reserved = 0;
+    sqe->offset = offset;
+    sqe->value = value;
+    sqe->tag = tag;
+    __atomic_store_n(&ring->sq_tail, ++ring_sq_tail, __ATOMIC_RELEASE);
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_ring_write(uint32_t reg, uint32_t value)
+{
+    return ring_push(WAVEGEN_RING_OP_WRITE, reg, value, 0);
+}
+
+wavegen_error_t wavegen_ring_set_frequency(wavegen_channel_t channel,
+                                           uint32_t frequency)
+{
+    wavegen_error_t err = WAVEGEN_OK;
+
+    if (channel > WAVEGEN_CH_BOTH) return WAVEGEN_ERR_PARAM;
+    if (channel == WAVEGEN_CH_A || channel == WAVEGEN_CH_BOTH)
+        err = ring_push(WAVEGEN_RING_OP_WRITE, WAVEGEN_FREQ_A_OFFSET, frequency, 0);
+    if (err == WAVEGEN_OK && (channel == WAVEGEN_CH_B || channel == WAVEGEN_CH_BOTH))
+        err = ring_push(WAVEGEN_RING_OP_WRITE, WAVEGEN_FREQ_B_OFFSET, frequency, 0);
+    return err;
+}
+
+wavegen_error_t wavegen_ring_apply(void)
+{
+    return ring_push(WAVEGEN_RING_OP_APPLY, 0, 0, 0);
+}
+
+wavegen_error_t wavegen_ring_read(uint32_t reg, uint32_t tag)
+{
+    return ring_push(WAVEGEN_RING_OP_READ, reg, 0, tag);
+}
+
+wavegen_error_t wavegen_ring_submit(uint32_t *submitted)
+{
+    struct wavegen_ring_submit req;
+
+    if (!ring) return WAVEGEN_ERR_NOT_INIT;
+
+    req.to_submit = ring_sq_tail - __atomic_load_n(&ring->sq_head, __ATOMIC_ACQUIRE);
+    req.submitted = 0;
+    if (req.to_submit && ioctl(fd, WAVEGEN_IOCTL_RING_SUBMIT, &req) < 0)
+        return ioctl_error();
+
+    if (submitted)
+        *submitted = req.submitted;
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_ring_reap(wavegen_completion_t *completions,
+                                  uint32_t max, uint32_t *count)
+{
+    uint32_t tail, n = 0;
+
+    if (!ring) return WAVEGEN_ERR_NOT_INIT;
+    if (!completions || !count) return WAVEGEN_ERR_PARAM;
+
+    tail = __atomic_load_n(&ring->cq_tail, __ATOMIC_ACQUIRE);
+    while (ring_cq_head != tail && n < max) {
+        const struct wavegen_cqe *cqe =
+            &ring->cq[ring_cq_head & (WAVEGEN_RING_CQ_ENTRIES - 1)];
+        completions[n].tag = cqe->tag;
+        completions[n].result = cqe->result;
+        completions[n].value = cqe->value;
+        ring_cq_head++;
+        n++;
+    }
+    __atomic_store_n(&ring->cq_head, ring_cq_head, __ATOMIC_RELEASE);
+
+    *count = n;
+    return WAVEGEN_OK;
+}
+
+/* ============================================================
+ * Sample Streaming API
+ * ============================================================ */
 
-    /* Also set the depth register */
-    return wavegen_set_arb_depth(count);
+wavegen_error_t wavegen_stream_start(wavegen_channel_t channel,
+                                     const wavegen_stream_config_t *config)
+{
+    struct wavegen_stream_config cfg;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (channel > WAVEGEN_CH_B || !config) return WAVEGEN_ERR_PARAM;
+
+    cfg.channel = (channel == WAVEGEN_CH_A) ? WAVEGEN_CHANNEL_A : WAVEGEN_CHANNEL_B;
+    cfg.frequency = config->frequency;
+    cfg.sampling_frequency = config->sampling_frequency;
+    cfg.table = config->table;
+    cfg.buffer = config->buffer;
+    cfg.watermark = config->watermark;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_STREAM_START, &cfg) < 0)
+        return ioctl_error();
+
+    if (channel == WAVEGEN_CH_A)
+        current_mode_a = WAVEGEN_MODE_ARB;
+    else
+        current_mode_b = WAVEGEN_MODE_ARB;
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_stream_write(const uint16_t *samples, uint32_t count)
+{
+    const char *p = (const char *)samples;
+    size_t left = (size_t)count * sizeof(*samples);
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!samples && count) return WAVEGEN_ERR_PARAM;
+
+    while (left) {
+        ssize_t n = write(fd, p, left);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return ioctl_error();
+        }
+        p += n;
+        left -= (size_t)n;
+    }
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_stream_drain(uint32_t timeout_ms)
+{
+    struct wavegen_stream_status st;
+    uint64_t waited_us = 0;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+
+    for (;;) {
+        if (ioctl(fd, WAVEGEN_IOCTL_GET_STREAM_STATUS, &st) < 0)
+            return ioctl_error();
+        if (!st.running || (st.queued == 0 && st.ahead == 0))
+            return WAVEGEN_OK;
+        if (waited_us >= timeout_ms * 1000ULL)
+            return WAVEGEN_ERR_BUSY;
+        usleep(1000);
+        waited_us += 1000;
+    }
+}
+
+wavegen_error_t wavegen_stream_stop(void)
+{
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (ioctl(fd, WAVEGEN_IOCTL_STREAM_STOP) < 0)
+        return ioctl_error();
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_stream_get_status(wavegen_stream_status_t *status)
+{
+    struct wavegen_stream_status st;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!status) return WAVEGEN_ERR_PARAM;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_STREAM_STATUS, &st) < 0)
+        return ioctl_error();
+
+    status->running = st.running;
+    status->queued = st.queued;
+    status->ahead = st.ahead;
+    status->written = st.written;
+    status->underruns = st.underruns;
+    status->silence = st.silence;
+    return WAVEGEN_OK;
+}
+
+int wavegen_stream_fd(void)
+{
+    return fd;
+}
+
+/* ============================================================
+ * Channel Claim API
+ * ============================================================ */
+
+wavegen_error_t wavegen_claim(uint32_t resources, int exclusive)
+{
+    struct wavegen_claim req = {0};
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!resources || (resources & ~WAVEGEN_RES_ALL)) return WAVEGEN_ERR_PARAM;
+
+    req.resources = resources;
+    req.flags = exclusive ? WAVEGEN_CLAIM_EXCLUSIVE : 0;
+    if (ioctl(fd, WAVEGEN_IOCTL_CLAIM, &req) < 0)
+        return ioctl_error();
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_unclaim(uint32_t resources)
+{
+    struct wavegen_claim req = {0};
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (resources & ~WAVEGEN_RES_ALL) return WAVEGEN_ERR_PARAM;
+
+    req.resources = resources;
+    if (ioctl(fd, WAVEGEN_IOCTL_UNCLAIM, &req) < 0)
+        return ioctl_error();
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_get_claims(wavegen_claims_t *claims)
+{
+    struct wavegen_claim_status st;
+    unsigned int i;
+    if (fd < 0) return WAVEGEN_ERR_NOT_INIT;
+    if (!claims) return WAVEGEN_ERR_PARAM;
+
+    if (ioctl(fd, WAVEGEN_IOCTL_GET_CLAIMS, &st) < 0)
+        return ioctl_error();
+    claims->held_exclusive = st.held_exclusive;
+    claims->held_shared = st.held_shared;
+    claims->exclusive = st.exclusive;
+    for (i = 0; i < WAVEGEN_CLAIM_COUNT; i++)
+        claims->shared[i] = st.shared[i];
+    return WAVEGEN_OK;
 }
 
 /* ============================================================
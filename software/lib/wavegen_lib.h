@@ -26,7 +26,9 @@ typedef enum {
     WAVEGEN_MODE_SAWTOOTH  = 2,
     WAVEGEN_MODE_TRIANGLE  = 3,
     WAVEGEN_MODE_SQUARE    = 4,
-    WAVEGEN_MODE_ARB       = 5
+    WAVEGEN_MODE_ARB       = 5,
+    WAVEGEN_MODE_NOISE     = 6,
+    WAVEGEN_MODE_QUADRATURE = 7         /* Cosine of the other channel's phase */
 } wavegen_mode_t;
 
 /* ============================================================
@@ -38,6 +40,128 @@ typedef enum {
     WAVEGEN_CH_BOTH = 2
 } wavegen_channel_t;
 
+/* ============================================================
+ * External trigger edge selection
+ * ============================================================ */
+typedef enum {
+    WAVEGEN_EDGE_RISING  = 0,
+    WAVEGEN_EDGE_FALLING = 1,
+    WAVEGEN_EDGE_BOTH    = 2
+} wavegen_trigger_edge_t;
+
+/* ============================================================
+ * Modulation type and source
+ * ============================================================ */
+typedef enum {
+    WAVEGEN_MOD_OFF = 0,
+    WAVEGEN_MOD_AM  = 1,
+    WAVEGEN_MOD_FM  = 2,
+    WAVEGEN_MOD_PM  = 3
+} wavegen_mod_type_t;
+
+typedef enum {
+    WAVEGEN_MOD_SRC_INTERNAL = 0,   /* Internal low-rate oscillator */
+    WAVEGEN_MOD_SRC_OTHER    = 1    /* Other channel's waveform */
+} wavegen_mod_source_t;
+
+/* ============================================================
+ * Multi-board sync: what a channel does on a sync edge
+ * ============================================================ */
+typedef enum {
+    WAVEGEN_SYNC_OFF   = 0,         /* Ignore sync edges */
+    WAVEGEN_SYNC_ONCE  = 1,         /* Act on the next edge, then disarm */
+    WAVEGEN_SYNC_EVERY = 2          /* Act on every edge */
+} wavegen_sync_mode_t;
+
+/* ============================================================
+ * Output capture
+ * ============================================================ */
+typedef enum {
+    WAVEGEN_CAPTURE_ENGINE    = 0,  /* Waveform before amplitude/offset */
+    WAVEGEN_CAPTURE_OUTPUT    = 1   /* Scaled output as sent to the DAC path */
+} wavegen_capture_source_t;
+
+typedef enum {
+    WAVEGEN_CAPTURE_TRIG_SW   = 0,  /* wavegen_capture_trigger() only */
+    WAVEGEN_CAPTURE_TRIG_CHA  = 1,  /* Channel A armed-trigger release */
+    WAVEGEN_CAPTURE_TRIG_EXT  = 2,  /* Rising edge of ext_trigger */
+    WAVEGEN_CAPTURE_TRIG_SYNC = 3   /* Multi-board sync edge */
+} wavegen_capture_trigger_t;
+
+typedef struct {
+    wavegen_capture_source_t source;
+    wavegen_capture_trigger_t trigger;
+    uint16_t pre_trigger;           /* Samples kept before the trigger */
+    uint16_t decimation;            /* Keep 1 of decimation + 1 samples */
+} wavegen_capture_config_t;
+
+/* ============================================================
+ * Sample streaming
+ * ============================================================ */
+typedef struct {
+    uint32_t frequency;         /* Table passes, 100uHz units (rate = frequency * table) */
+    uint32_t sampling_frequency; /* Engine rate: SAMPLING_FREQUENCY >> INTERP_STAGES */
+    uint32_t table;             /* ARB entries used, <= ARB_WAVEFORM_DEPTH (0 = 1024) */
+    uint32_t buffer;            /* Driver ring in samples, power of two (0 = 65536) */
+    uint32_t watermark;         /* Free samples for poll() writable (0 = buffer / 2) */
+} wavegen_stream_config_t;
+
+typedef struct {
+    int      running;
+    uint32_t queued;            /* Samples waiting in the driver ring */
+    uint32_t ahead;             /* Samples in ARB memory not played yet */
+    uint64_t written;           /* Samples sent to ARB memory */
+    uint64_t underruns;         /* Times the stream ran dry */
+    uint64_t silence;           /* Zero samples played for lack of data */
+} wavegen_stream_status_t;
+
+/* ============================================================
+ * Channel claims
+ * ============================================================ */
+typedef enum {
+    WAVEGEN_RES_CH_A   = 1 << 0,
+    WAVEGEN_RES_CH_B   = 1 << 1,
+    WAVEGEN_RES_DEVICE = 1 << 2,    /* ARB memory, profiles, commit, sync, capture */
+    WAVEGEN_RES_ALL    = 0x7
+} wavegen_resource_t;
+
+typedef struct {
+    uint32_t held_exclusive;    /* WAVEGEN_RES_* this process holds alone */
+    uint32_t held_shared;
+    uint32_t exclusive;         /* Held exclusively by anyone */
+    uint32_t shared[3];         /* Shared holders of A, B and the device */
+} wavegen_claims_t;
+
+/* ============================================================
+ * Real-time update queue (wavegen_rt.c)
+ * ============================================================ */
+typedef enum {
+    WAVEGEN_RT_FREQUENCY    = 0,    /* 100uHz units */
+    WAVEGEN_RT_AMPLITUDE    = 1,
+    WAVEGEN_RT_OFFSET       = 2,    /* int16_t value */
+    WAVEGEN_RT_DUTY_CYCLE   = 3,
+    WAVEGEN_RT_PHASE_OFFSET = 4,    /* int16_t value */
+    WAVEGEN_RT_PARAM_COUNT
+} wavegen_rt_param_t;
+
+typedef struct {
+    uint32_t capacity;          /* Queue entries, power of two (0 = 256) */
+    uint32_t interval_us;       /* Minimum time between flushes (0 = none) */
+    int      apply;             /* wavegen_apply() after each flush */
+} wavegen_rt_config_t;
+
+typedef struct {
+    uint32_t depth;             /* Updates queued now */
+    uint32_t max_depth;         /* Highest depth seen */
+    uint32_t capacity;
+    uint64_t pushed;            /* Updates accepted */
+    uint64_t dropped;           /* Updates refused, queue full */
+    uint64_t coalesced;         /* Updates overwritten before being written */
+    uint64_t writes;            /* Parameter writes issued */
+    uint64_t flushes;           /* Batches written */
+    uint64_t errors;            /* Writes or applies that failed */
+} wavegen_rt_stats_t;
+
 /* ============================================================
  * Error codes
  * ============================================================ */
@@ -47,7 +171,8 @@ typedef enum {
     WAVEGEN_ERR_NOT_INIT   = -2,
     WAVEGEN_ERR_IOCTL      = -3,
     WAVEGEN_ERR_PARAM      = -4,
-    WAVEGEN_ERR_ALLOC      = -5
+    WAVEGEN_ERR_ALLOC      = -5,
+    WAVEGEN_ERR_BUSY       = -6     /* Command ring full, or claimed elsewhere */
 } wavegen_error_t;
 
 /* ============================================================
@@ -58,6 +183,8 @@ typedef struct {
     int reconfig_busy;
     int channel_a_running;
     int channel_b_running;
+    int channel_a_armed;        /* Waiting for a trigger */
+    int channel_b_armed;
 } wavegen_status_t;
 
 /* ============================================================
@@ -73,6 +200,70 @@ typedef struct {
     uint16_t cycles;            /* 0 = continuous */
 } wavegen_config_t;
 
+/* ============================================================
+ * Modulation configuration structure
+ * ============================================================ */
+typedef struct {
+    wavegen_mod_type_t type;
+    wavegen_mod_source_t source;
+    uint16_t depth;             /* AM depth / PM deviation, 0 to 32767 */
+    uint32_t frequency;         /* Internal oscillator, 100uHz units */
+    uint32_t deviation;         /* FM peak deviation, 100uHz units */
+} wavegen_modulation_t;
+
+/* ============================================================
+ * Performance counters (coherent snapshot)
+ * ============================================================ */
+typedef struct {
+    uint64_t clk_count;         /* IP clock cycles since clear */
+    uint64_t samples_a;         /* Samples generated, channel A */
+    uint64_t samples_b;
+    uint64_t since_trigger_a;   /* IP clocks since last trigger A */
+    uint64_t since_trigger_b;
+    uint32_t cycles_a;          /* Completed waveform cycles A */
+    uint32_t cycles_b;
+    uint32_t dac_frames;        /* DAC update strobes */
+    uint32_t underflows;        /* DAC strobe before sample was ready */
+    uint32_t overruns;          /* Engine request while still busy */
+    uint32_t reconfigs;         /* Shadow register applies */
+} wavegen_counters_t;
+
+/* ============================================================
+ * ARB upload cache statistics (driver-wide)
+ * ============================================================ */
+typedef struct {
+    uint64_t hits;              /* Cached loads skipped */
+    uint64_t misses;            /* Cached loads written */
+    uint64_t samples_skipped;   /* Samples not re-sent on hits */
+    uint64_t samples_written;   /* Samples written on misses */
+} wavegen_arb_cache_stats_t;
+
+/* ============================================================
+ * Compressed ARB memory format
+ * ============================================================ */
+typedef enum {
+    WAVEGEN_ARB_RAW    = 0,     /* One 16-bit sample per word */
+    WAVEGEN_ARB_DELTA8 = 1,     /* 16 samples per 9 words (1.78x) */
+    WAVEGEN_ARB_DELTA4 = 2      /* 32 samples per 9 words (3.56x) */
+} wavegen_arb_format_t;
+
+typedef struct {
+    uint32_t samples;           /* Samples encoded */
+    uint32_t words;             /* ARB memory words (= upload size) */
+    double   ratio;             /* samples / words */
+    uint32_t max_error;         /* Largest |decoded - input|, 0 = lossless */
+    uint32_t lossy_blocks;      /* Blocks that needed a shift */
+} wavegen_arb_encode_info_t;
+
+/* ============================================================
+ * Command ring completion
+ * ============================================================ */
+typedef struct {
+    uint32_t tag;               /* Tag passed when queueing */
+    int32_t  result;            /* 0 or -errno */
+    uint32_t value;             /* Register value for reads */
+} wavegen_completion_t;
+
 /* ============================================================
  * Core API
  * ============================================================ */
@@ -124,6 +315,26 @@ wavegen_error_t wavegen_stop(wavegen_channel_t channel);
 /* Apply all shadow register changes atomically */
 wavegen_error_t wavegen_apply(void);
 
+/*
+ * Apply the shadow registers when the engine sample counter reaches
+ * `sample` (both channels, exactly between two samples). A timestamp
+ * that has already passed applies at once and sets the late flag.
+ * Arming replaces any pending timed commit.
+ */
+wavegen_error_t wavegen_apply_at(uint64_t sample);
+
+/* Apply the shadow registers at the channel's next phase wrap */
+wavegen_error_t wavegen_apply_at_wrap(wavegen_channel_t channel);
+
+/* Cancel a pending wavegen_apply_at() / wavegen_apply_at_wrap() */
+wavegen_error_t wavegen_cancel_apply(void);
+
+/* Free-running engine sample counter (samples since IP reset) */
+wavegen_error_t wavegen_get_sample_count(uint64_t *count);
+
+/* Timed commit state: pending (1 = still armed), late (last one was late) */
+wavegen_error_t wavegen_get_commit_status(int *pending, int *late);
+
 /* Software trigger (synchronized start) */
 wavegen_error_t wavegen_trigger(wavegen_channel_t channel);
 
@@ -133,6 +344,61 @@ wavegen_error_t wavegen_reset(wavegen_channel_t channel);
 /* Get current status */
 wavegen_error_t wavegen_get_status(wavegen_status_t *status);
 
+/* ============================================================
+ * Trigger API
+ * ============================================================ */
+
+/*
+ * Configure triggered start (applied by wavegen_apply()).
+ * arm:      hold the channel at phase 0 after enable until triggered
+ * external: also accept the external trigger input on the given edge
+ */
+wavegen_error_t wavegen_set_trigger_config(wavegen_channel_t channel, int arm,
+                                           int external, wavegen_trigger_edge_t edge);
+
+/* Read trigger-to-start latency of the last trigger, in IP clock cycles */
+wavegen_error_t wavegen_get_trigger_latency(wavegen_channel_t channel, uint32_t *cycles);
+
+/* ============================================================
+ * Modulation API
+ * ============================================================ */
+
+/*
+ * Configure AM/FM/PM modulation (applied by wavegen_apply()).
+ * AM: depth 32767 = 100% (envelope swings from 0 to full amplitude)
+ * FM: carrier frequency swings by +/- deviation
+ * PM: depth 32767 = +/-180 degrees
+ */
+wavegen_error_t wavegen_set_modulation(wavegen_channel_t channel,
+                                       const wavegen_modulation_t *mod);
+
+/* ============================================================
+ * Noise API
+ * ============================================================ */
+
+/*
+ * Configure the WAVEGEN_MODE_NOISE source (applied by wavegen_apply()).
+ * gaussian: 0 = uniform over full scale, 1 = gaussian (sigma ~0.29 FS)
+ * seed:     the sequence restarts from the seed whenever the channel
+ *           starts, so equal seeds give identical runs. WAVEGEN_CH_BOTH
+ *           gives channel B the inverted seed, so the channels differ.
+ * Amplitude and offset apply as for the other modes.
+ */
+wavegen_error_t wavegen_set_noise(wavegen_channel_t channel, int gaussian, uint32_t seed);
+
+/* ============================================================
+ * Performance Counter API
+ * ============================================================ */
+
+/*
+ * Snapshot and read all counters. Delivered sample rate in Hz is
+ * samples_a * f_clk / clk_count, where f_clk is the IP clock (100 MHz).
+ */
+wavegen_error_t wavegen_get_counters(wavegen_counters_t *counters);
+
+/* Zero all counters */
+wavegen_error_t wavegen_clear_counters(void);
+
 /* ============================================================
  * Batch Configuration API
  * ============================================================ */
@@ -141,19 +407,320 @@ wavegen_error_t wavegen_get_status(wavegen_status_t *status);
 wavegen_error_t wavegen_configure(wavegen_channel_t channel,
                                    const wavegen_config_t *config);
 
+/* ============================================================
+ * Profile API
+ *
+ * The IP holds a number of profile banks (8 by default), each a
+ * full configuration of both channels. Selecting a profile applies
+ * it to both channels in one clock cycle, with no RECONFIG needed.
+ * ============================================================ */
+
+/* Store configurations for channels A and B in a profile bank */
+wavegen_error_t wavegen_store_profile(uint32_t index,
+                                       const wavegen_config_t *config_a,
+                                       const wavegen_config_t *config_b);
+
+/* Apply a stored profile (one register write) */
+wavegen_error_t wavegen_select_profile(uint32_t index);
+
+/* Let the external profile_sel pins choose the profile (0 = registers) */
+wavegen_error_t wavegen_set_profile_pins(int enable);
+
+/* Read the active profile, pin select state and number of banks */
+wavegen_error_t wavegen_get_profile(uint32_t *index, int *pins, uint32_t *count);
+
+/* ============================================================
+ * Multi-Board Sync API
+ *
+ * Boards sharing a sample clock are aligned by one sync pulse: the
+ * master's sync_out drives every other board's sync_in. A channel
+ * armed for sync that is waiting for a trigger starts on the edge;
+ * a running one restarts at phase 0. To align a set of boards, call
+ * wavegen_sync_arm() on each board (each runs its own library
+ * instance), then wavegen_sync_fire() on the master.
+ * ============================================================ */
+
+/*
+ * Set the board's sync role (takes effect at once).
+ * master:      act on the local sync_out pulse as well (loopback)
+ * period:      also emit a pulse every `period` engine samples (PPS
+ *              style); 0 = only on wavegen_sync_fire()
+ * reset_count: clear the sample counter on each sync edge, so timed
+ *              commits (wavegen_apply_at) line up across boards
+ */
+wavegen_error_t wavegen_sync_setup(int master, uint32_t period, int reset_count);
+
+/* Choose what the channel does on sync edges (takes effect at once) */
+wavegen_error_t wavegen_sync_arm(wavegen_channel_t channel, wavegen_sync_mode_t mode);
+
+/* Emit one sync pulse on sync_out (master board) */
+wavegen_error_t wavegen_sync_fire(void);
+
+/* armed = 1 while a WAVEGEN_SYNC_ONCE arm has not seen its edge yet */
+wavegen_error_t wavegen_sync_armed(wavegen_channel_t channel, int *armed);
+
+/* ============================================================
+ * Output Capture API
+ *
+ * The IP records a window of samples of both channels into on-chip
+ * memory: pre_trigger samples before the trigger, the rest after it.
+ * A capture holds wavegen_capture_depth() samples.
+ * ============================================================ */
+
+/* Start a new capture (the previous one is discarded) */
+wavegen_error_t wavegen_capture_arm(const wavegen_capture_config_t *config);
+
+/* Software trigger */
+wavegen_error_t wavegen_capture_trigger(void);
+
+/* Wait until the capture is complete; WAVEGEN_ERR_BUSY on timeout */
+wavegen_error_t wavegen_capture_wait(uint32_t timeout_ms);
+
+/* Samples per capture (the CAPTURE_DEPTH parameter) */
+wavegen_error_t wavegen_capture_depth(uint32_t *depth);
+
+/*
+ * Read count samples of a completed capture from index start (0 is the
+ * oldest; the first sample after the trigger is at pre_trigger).
+ * a or b may be NULL. WAVEGEN_ERR_BUSY while still capturing.
+ */
+wavegen_error_t wavegen_capture_read(uint32_t start, uint32_t count,
+                                     int16_t *a, int16_t *b);
+
 /* ============================================================
  * Arbitrary Waveform API
  * ============================================================ */
 
-/* Set arbitrary waveform depth */
+/*
+ * Set the arbitrary waveform length. Any length up to the ARB memory
+ * size plays exactly once per period (0 = the whole memory).
+ */
 wavegen_error_t wavegen_set_arb_depth(uint32_t depth);
 
+/*
+ * Linearly interpolate between adjacent ARB samples (applied by
+ * wavegen_apply()), so short tables play without steps at any frequency.
+ */
+wavegen_error_t wavegen_set_arb_interpolation(wavegen_channel_t channel, int enable);
+
 /* Load a single arbitrary waveform sample */
 wavegen_error_t wavegen_set_arb_sample(uint32_t index, uint16_t value);
 
 /* Load arbitrary waveform data in bulk */
 wavegen_error_t wavegen_load_arb_waveform(const uint16_t *data, uint32_t count);
 
+/* Write samples starting at ARB index start (depth register unchanged) */
+wavegen_error_t wavegen_write_arb(uint32_t start, const uint16_t *data,
+                                  uint32_t count);
+
+/* Load a waveform (as wavegen_load_arb_waveform) through the driver's
+ * content cache: one small ioctl, and the samples are only copied when
+ * ARB memory does not already hold them. hit (optional) reports which. */
+wavegen_error_t wavegen_load_arb_cached(const uint16_t *data, uint32_t count,
+                                        int *hit);
+
+/* Read ARB upload cache statistics */
+wavegen_error_t wavegen_get_arb_cache_stats(wavegen_arb_cache_stats_t *stats);
+
+/*
+ * Compressed ARB tables. In the delta formats ARB memory holds 9-word
+ * blocks of 16 (DELTA8) or 32 (DELTA4) samples: a 16-bit key sample
+ * and signed 8- or 4-bit steps scaled by a per-block shift, decoded
+ * by the IP during playback. A block is lossless while its steps fit;
+ * steeper blocks take the smallest shift that fits, with an error of
+ * at most half of 2^shift. ARB_DEPTH counts samples, not words.
+ */
+
+/* ARB memory words needed for count samples */
+uint32_t wavegen_arb_encoded_words(wavegen_arb_format_t format, uint32_t count);
+
+/* Encode count samples into words (max_words long); info is optional */
+wavegen_error_t wavegen_arb_encode(wavegen_arb_format_t format,
+                                   const uint16_t *samples, uint32_t count,
+                                   uint16_t *words, uint32_t max_words,
+                                   wavegen_arb_encode_info_t *info);
+
+/* Decode count samples exactly as the IP plays them */
+wavegen_error_t wavegen_arb_decode(wavegen_arb_format_t format,
+                                   const uint16_t *words, uint32_t count,
+                                   uint16_t *samples);
+
+/* Select the ARB memory format for both channels (applied by wavegen_apply()) */
+wavegen_error_t wavegen_set_arb_format(wavegen_arb_format_t format);
+
+/* Encode, upload from index 0 and set depth and format; info is optional */
+wavegen_error_t wavegen_load_arb_compressed(wavegen_arb_format_t format,
+                                           const uint16_t *samples,
+                                           uint32_t count,
+                                           wavegen_arb_encode_info_t *info);
+
+/* ============================================================
+ * Command Ring API
+ *
+ * Queue register writes, reads and applies in a ring shared with
+ * the driver and execute them all with one wavegen_ring_submit().
+ * Entries run in queue order. reg is a byte offset from
+ * wavegen_regs.h; packed registers carry both channels, so write
+ * the full word. Reads return their value in a completion; writes
+ * and applies only complete on error.
+ * ============================================================ */
+
+/* Map the command ring (after wavegen_init) */
+wavegen_error_t wavegen_ring_init(void);
+
+/* Queue a register write */
+wavegen_error_t wavegen_ring_write(uint32_t reg, uint32_t value);
+
+/* Queue a frequency change (FREQ_A/FREQ_B, 100uHz units) */
+wavegen_error_t wavegen_ring_set_frequency(wavegen_channel_t channel,
+                                           uint32_t frequency);
+
+/* Queue a shadow register apply */
+wavegen_error_t wavegen_ring_apply(void);
+
+/* Queue a register read; the completion carries tag and value */
+wavegen_error_t wavegen_ring_read(uint32_t reg, uint32_t tag);
+
+/* Execute everything queued; submitted (optional) gets the count */
+wavegen_error_t wavegen_ring_submit(uint32_t *submitted);
+
+/* Collect up to max completions */
+wavegen_error_t wavegen_ring_reap(wavegen_completion_t *completions,
+                                  uint32_t max, uint32_t *count);
+
+/* ============================================================
+ * Sample Streaming API
+ *
+ * Play an unbounded sample sequence on one channel with plain
+ * write()s: the driver queues the samples and copies them into
+ * ARB memory just ahead of playback. The channel runs in ARB mode
+ * without modulation until wavegen_stream_stop(); ARB_DEPTH is set
+ * to the stream table for both channels. Samples are in ARB table
+ * format. poll() the descriptor from wavegen_stream_fd() for
+ * POLLOUT, or splice() into it; writes must be whole samples.
+ * ============================================================ */
+
+/* Start streaming on channel A or B (one stream per device) */
+wavegen_error_t wavegen_stream_start(wavegen_channel_t channel,
+                                     const wavegen_stream_config_t *config);
+
+/* Queue count samples, blocking while the driver ring is full */
+wavegen_error_t wavegen_stream_write(const uint16_t *samples, uint32_t count);
+
+/* Wait until every queued sample has been played; WAVEGEN_ERR_BUSY on timeout */
+wavegen_error_t wavegen_stream_drain(uint32_t timeout_ms);
+
+/* Stop the channel and discard anything still queued */
+wavegen_error_t wavegen_stream_stop(void);
+
+wavegen_error_t wavegen_stream_get_status(wavegen_stream_status_t *status);
+
+/* Device descriptor for poll()/splice() (-1 before wavegen_init) */
+int wavegen_stream_fd(void);
+
+/* ============================================================
+ * Channel Claim API
+ *
+ * Several processes may open the device, e.g. independent test
+ * programs on channel A and channel B. A claim keeps other
+ * processes off a channel (or the device-wide state): while it is
+ * held, their writes to it fail with WAVEGEN_ERR_BUSY, and
+ * wavegen_enable() or a mode change from them leaves it as it is.
+ * Shared claims exclude only processes without a claim; reads are
+ * never restricted. Unclaimed resources stay writable by everyone,
+ * as before. Claims are dropped by wavegen_close() or on exit.
+ * ============================================================ */
+
+/* Claim all of resources (WAVEGEN_RES_*) or none; WAVEGEN_ERR_BUSY
+ * if another process holds one, or an exclusive claim finds sharers.
+ * Claiming a held resource switches it between shared and exclusive. */
+wavegen_error_t wavegen_claim(uint32_t resources, int exclusive);
+
+wavegen_error_t wavegen_unclaim(uint32_t resources);
+
+wavegen_error_t wavegen_get_claims(wavegen_claims_t *claims);
+
+/* ============================================================
+ * Real-Time Update Queue (wavegen_rt.c, link with -pthread)
+ *
+ * For control loops that must not block: wavegen_rt_push() only
+ * writes into a lock-free single-producer/single-consumer queue
+ * (bounded time, no allocation, no locks). A flusher thread started
+ * by wavegen_rt_start() drains it, keeps the last value per
+ * parameter and channel, and writes the changes with the regular
+ * setters, then one wavegen_apply() per batch when config->apply
+ * is set (the default with a NULL config). Push from one thread
+ * only. A full queue drops the update (WAVEGEN_ERR_BUSY).
+ * ============================================================ */
+
+/* Start the flusher (after wavegen_init); config may be NULL */
+wavegen_error_t wavegen_rt_start(const wavegen_rt_config_t *config);
+
+/* Queue a parameter change; never blocks */
+wavegen_error_t wavegen_rt_push(wavegen_rt_param_t param, wavegen_channel_t channel,
+                                uint32_t value);
+
+/* Write what is still queued, then stop the flusher */
+wavegen_error_t wavegen_rt_stop(void);
+
+/* Queue depth, drop and coalescing counters */
+wavegen_error_t wavegen_rt_get_stats(wavegen_rt_stats_t *stats);
+
+/* ============================================================
+ * ARB Table Synthesis (wavegen_synth.c, link with -lm)
+ *
+ * Generators write count samples into a caller table in the
+ * format WaveForms plays: two's-complement 16-bit, 1.0 = 32767.
+ * Results are rounded to nearest (ties to even) and clipped to
+ * -32768..32767. Vector kernels: AVX2 (chosen at run time on
+ * x86) and NEON (ARM builds with NEON enabled), else scalar C.
+ * ============================================================ */
+
+typedef struct {
+    double cycles;              /* Cycles per table (integer = seamless loop) */
+    double amplitude;           /* Fraction of full scale */
+    double phase;               /* Start phase in degrees */
+} wavegen_tone_t;
+
+typedef enum {
+    WAVEGEN_PRBS7  = 7,         /* x^7 + x^6 + 1 */
+    WAVEGEN_PRBS9  = 9,         /* x^9 + x^5 + 1 */
+    WAVEGEN_PRBS15 = 15,        /* x^15 + x^14 + 1 */
+    WAVEGEN_PRBS23 = 23,        /* x^23 + x^18 + 1 */
+    WAVEGEN_PRBS31 = 31         /* x^31 + x^28 + 1 */
+} wavegen_prbs_t;
+
+/* Sum of sine tones */
+wavegen_error_t wavegen_synth_multitone(uint16_t *table, uint32_t count,
+                                        const wavegen_tone_t *tones,
+                                        uint32_t num_tones);
+
+/* sin(pi x)/(pi x) centred in the table, x spanning +/-lobes */
+wavegen_error_t wavegen_synth_sinc(uint16_t *table, uint32_t count,
+                                   double lobes, double amplitude);
+
+/* Gaussian pulse centred in the table, sigma as a fraction of count */
+wavegen_error_t wavegen_synth_gaussian(uint16_t *table, uint32_t count,
+                                       double sigma, double amplitude);
+
+/* +/-amplitude PRBS, each bit held for samples_per_bit (seed 0 = all ones) */
+wavegen_error_t wavegen_synth_prbs(uint16_t *table, uint32_t count,
+                                   wavegen_prbs_t order,
+                                   uint32_t samples_per_bit,
+                                   double amplitude, uint32_t seed);
+
+/* Periodic linear resampling of src (1.0 = full scale) to count samples */
+wavegen_error_t wavegen_synth_resample(uint16_t *table, uint32_t count,
+                                       const float *src, uint32_t src_count,
+                                       double gain);
+
+/* Scale, round and clip float samples (1.0 = full scale) */
+wavegen_error_t wavegen_synth_quantize(uint16_t *table, const float *src,
+                                       uint32_t count, double gain);
+
+/* Active kernel: "avx2", "neon" or "scalar" */
+const char *wavegen_synth_kernel(void);
+
 /* ============================================================
  * Preset Waveforms (convenience functions)
  * ============================================================ */
@@ -18,6 +18,11 @@
  *   wavegen_hw_set_amplitude(WAVEGEN_HW_CH_A, 32767);
  *   wavegen_hw_enable(WAVEGEN_HW_CH_A, 1);
  *   wavegen_hw_reconfig();
+ *
+ * For control loops, use a wavegen_hw_ctx_t instead (see "Cached
+ * context" below): setters only touch a RAM copy of the registers and
+ * wavegen_hw_ctx_commit() writes just the changed words, with no bus
+ * reads at all.
  */
 
 #include <stdint.h>
@@ -25,7 +30,9 @@
 /* ============================================================
  * Platform abstraction for register I/O
  * ============================================================ */
-#ifdef __XILINX__
+#if defined(WAVEGEN_WRITE32) && defined(WAVEGEN_READ32)
+  /* Access supplied by the includer (e.g. the simulation bus model) */
+#elif defined(__XILINX__)
   #include "xil_io.h"
   #define WAVEGEN_WRITE32(addr, val) Xil_Out32((addr), (val))
   #define WAVEGEN_READ32(addr)       Xil_In32((addr))
@@ -48,11 +55,39 @@
 #define WAVEGEN_HW_CYCLES_OFF    0x1C
 #define WAVEGEN_HW_PHASE_OFF     0x20
 #define WAVEGEN_HW_ARB_DEPTH_OFF 0x24
-#define WAVEGEN_HW_ARB_DATA_OFF  0x28
 #define WAVEGEN_HW_RECONFIG_OFF  0x2C
 #define WAVEGEN_HW_STATUS_OFF    0x30
 #define WAVEGEN_HW_TRIGGER_OFF   0x34
 #define WAVEGEN_HW_SOFT_RST_OFF  0x38
+#define WAVEGEN_HW_TRIG_CFG_OFF  0x3C
+#define WAVEGEN_HW_TRIG_LAT_A_OFF 0x40
+#define WAVEGEN_HW_TRIG_LAT_B_OFF 0x44
+#define WAVEGEN_HW_MOD_CFG_OFF   0x48
+#define WAVEGEN_HW_MOD_DEPTH_OFF 0x4C
+#define WAVEGEN_HW_MOD_FREQ_A_OFF 0x50
+#define WAVEGEN_HW_MOD_FREQ_B_OFF 0x54
+#define WAVEGEN_HW_MOD_DEV_A_OFF 0x58
+#define WAVEGEN_HW_MOD_DEV_B_OFF 0x5C
+#define WAVEGEN_HW_CNT_CTRL_OFF  0x60
+#define WAVEGEN_HW_PROFILE_SEL_OFF 0x64  /* [3:0]=profile, [8]=pins, [23:16]=count */
+#define WAVEGEN_HW_COMMIT_CTRL_OFF 0x68  /* [1:0]=mode, [4]=late */
+#define WAVEGEN_HW_COMMIT_TIME_OFF 0x6C  /* 64-bit timestamp, lo then hi */
+#define WAVEGEN_HW_SAMPLE_CNT_OFF  0x74  /* 64-bit sample counter, lo then hi */
+#define WAVEGEN_HW_SYNC_CFG_OFF    0x7C  /* [17:16]=cfg_b, [1:0]=cfg_a */
+#define WAVEGEN_HW_CNT_BASE_OFF  0x80    /* Counter snapshot block (16 words) */
+#define WAVEGEN_HW_SYNC_CTRL_OFF   0xC0  /* [0]=fire, [1]=loopback, [2]=count reset */
+#define WAVEGEN_HW_SYNC_PERIOD_OFF 0xC4  /* Samples between sync pulses, 0 = off */
+#define WAVEGEN_HW_NOISE_CFG_OFF 0xC8    /* [16]/[0] = gaussian B/A (shadowed) */
+#define WAVEGEN_HW_NOISE_SEED_A_OFF 0xCC /* Seed, loaded on channel start */
+#define WAVEGEN_HW_NOISE_SEED_B_OFF 0xD0
+#define WAVEGEN_HW_ARB_CFG_OFF   0xD4    /* [16]/[0] = interpolate B/A, [9:8] format (shadowed) */
+#define WAVEGEN_HW_CAP_CTRL_OFF  0xD8    /* Capture arm/trigger, source, trigger select */
+#define WAVEGEN_HW_CAP_CFG_OFF   0xDC    /* [31:16] decimation, [15:0] pre-trigger */
+#define WAVEGEN_HW_CAP_STATUS_OFF 0xE0   /* [31:16] depth, [2] done */
+#define WAVEGEN_HW_CAP_DATA_OFF  0x8000  /* Capture window, oldest sample first */
+#define WAVEGEN_HW_ARB_DATA_OFF  0x4000  /* ARB sample window base */
+#define WAVEGEN_HW_PROFILE_OFF   0xC000  /* Profile banks, 0x40 apart */
+#define WAVEGEN_HW_PROFILE_STRIDE 0x40
 
 /* ============================================================
  * Constants
@@ -63,7 +98,9 @@ typedef enum {
     WAVEGEN_HW_SAWTOOTH  = 2,
     WAVEGEN_HW_TRIANGLE  = 3,
     WAVEGEN_HW_SQUARE    = 4,
-    WAVEGEN_HW_ARB       = 5
+    WAVEGEN_HW_ARB       = 5,
+    WAVEGEN_HW_NOISE     = 6,
+    WAVEGEN_HW_QUADRATURE = 7           /* Cosine of the other channel's phase */
 } wavegen_hw_mode_t;
 
 typedef enum {
@@ -71,6 +108,45 @@ typedef enum {
     WAVEGEN_HW_CH_B = 1
 } wavegen_hw_channel_t;
 
+typedef enum {
+    WAVEGEN_HW_EDGE_RISING  = 0,
+    WAVEGEN_HW_EDGE_FALLING = 1,
+    WAVEGEN_HW_EDGE_BOTH    = 2
+} wavegen_hw_trigger_edge_t;
+
+typedef enum {
+    WAVEGEN_HW_MOD_OFF = 0,
+    WAVEGEN_HW_MOD_AM  = 1,
+    WAVEGEN_HW_MOD_FM  = 2,
+    WAVEGEN_HW_MOD_PM  = 3
+} wavegen_hw_mod_type_t;
+
+/* Counter snapshot, in register order starting at WAVEGEN_HW_CNT_BASE_OFF */
+typedef struct {
+    uint64_t clk_count;
+    uint64_t samples_a;
+    uint64_t samples_b;
+    uint64_t since_trigger_a;
+    uint64_t since_trigger_b;
+    uint32_t cycles_a;
+    uint32_t cycles_b;
+    uint32_t dac_frames;
+    uint32_t underflows;
+    uint32_t overruns;
+    uint32_t reconfigs;
+} wavegen_hw_counters_t;
+
+/* One profile bank: a full configuration of both channels */
+typedef struct {
+    wavegen_hw_mode_t mode_a, mode_b;
+    uint32_t freq_a, freq_b;
+    uint16_t amp_a, amp_b;
+    int16_t  offset_a, offset_b;
+    uint16_t duty_a, duty_b;
+    int16_t  phase_a, phase_b;
+    uint16_t cycles_a, cycles_b;
+} wavegen_hw_profile_t;
+
 /* ============================================================
  * API functions (all inline for baremetal use)
  * ============================================================ */
@@ -153,6 +229,22 @@ static inline void wavegen_hw_set_arb_depth(uint32_t depth) {
     WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_ARB_DEPTH_OFF, depth);
 }
 
+/* Linear interpolation between ARB samples; applied by wavegen_hw_reconfig() */
+static inline void wavegen_hw_set_arb_interp(wavegen_hw_channel_t ch, int enable) {
+    uint32_t reg = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_ARB_CFG_OFF);
+    uint32_t bit = (ch == WAVEGEN_HW_CH_A) ? 0x1u : 0x10000u;
+    reg = enable ? (reg | bit) : (reg & ~bit);
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_ARB_CFG_OFF, reg);
+}
+
+/* ARB memory format, 0 = samples, 1/2 = 8/4-bit delta blocks (see
+ * wavegen_arb_encode()); applied by wavegen_hw_reconfig() */
+static inline void wavegen_hw_set_arb_format(uint32_t format) {
+    uint32_t reg = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_ARB_CFG_OFF);
+    reg = (reg & ~0x300u) | ((format & 0x3u) << 8);
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_ARB_CFG_OFF, reg);
+}
+
 static inline void wavegen_hw_set_arb_sample(uint32_t index, uint16_t value) {
     WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_ARB_DATA_OFF + index * 4, value);
 }
@@ -161,6 +253,78 @@ static inline void wavegen_hw_reconfig(void) {
     WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_RECONFIG_OFF, 1);
 }
 
+/*
+ * Timed commit: apply the shadow registers when the engine sample
+ * counter reaches `sample`, exactly between two samples on both
+ * channels. Use instead of wavegen_hw_reconfig().
+ */
+static inline void wavegen_hw_reconfig_at(uint64_t sample) {
+    /* Disarm first so a pending commit never sees a half-written time */
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_COMMIT_CTRL_OFF, 0);
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_COMMIT_TIME_OFF, (uint32_t)sample);
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_COMMIT_TIME_OFF + 4, (uint32_t)(sample >> 32));
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_COMMIT_CTRL_OFF, 1);
+}
+
+/* Apply the shadow registers at the channel's next phase wrap */
+static inline void wavegen_hw_reconfig_at_wrap(wavegen_hw_channel_t ch) {
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_COMMIT_CTRL_OFF,
+                    (ch == WAVEGEN_HW_CH_A) ? 2 : 3);
+}
+
+/* Nonzero while a timed commit is armed */
+static inline uint32_t wavegen_hw_commit_pending(void) {
+    return WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_COMMIT_CTRL_OFF) & 0x3;
+}
+
+/* Engine samples since IP reset (the low-word read latches the high word) */
+static inline uint64_t wavegen_hw_get_sample_count(void) {
+    uint32_t lo = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_SAMPLE_CNT_OFF);
+    uint32_t hi = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_SAMPLE_CNT_OFF + 4);
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/*
+ * Multi-board sync role: master also acts on its own sync_out pulse;
+ * period > 0 emits a pulse every `period` samples; reset_count clears
+ * the sample counter on each sync edge.
+ */
+static inline void wavegen_hw_sync_setup(int master, uint32_t period, int reset_count) {
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_SYNC_CTRL_OFF,
+                    (master ? 0x2u : 0) | (reset_count ? 0x4u : 0));
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_SYNC_PERIOD_OFF, period);
+}
+
+/* Start (if armed by trigger config) or restart at phase 0 on the next
+ * sync edge, or on every edge with `every` set */
+static inline void wavegen_hw_sync_arm(wavegen_hw_channel_t ch, int every) {
+    uint32_t cfg = every ? 0x2u : 0x1u;
+    uint32_t reg = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_SYNC_CFG_OFF);
+    if (ch == WAVEGEN_HW_CH_A)
+        reg = (reg & 0xFFFF0000) | cfg;
+    else
+        reg = (reg & 0x0000FFFF) | (cfg << 16);
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_SYNC_CFG_OFF, reg);
+}
+
+static inline void wavegen_hw_sync_disarm(wavegen_hw_channel_t ch) {
+    uint32_t reg = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_SYNC_CFG_OFF);
+    reg &= (ch == WAVEGEN_HW_CH_A) ? 0xFFFF0000 : 0x0000FFFF;
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_SYNC_CFG_OFF, reg);
+}
+
+/* Emit one sync pulse (master board) */
+static inline void wavegen_hw_sync_fire(void) {
+    uint32_t ctrl = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_SYNC_CTRL_OFF);
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_SYNC_CTRL_OFF, ctrl | 0x1u);
+}
+
+/* Nonzero while a one-shot sync arm has not seen its edge */
+static inline uint32_t wavegen_hw_sync_armed(wavegen_hw_channel_t ch) {
+    uint32_t reg = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_SYNC_CFG_OFF);
+    return (ch == WAVEGEN_HW_CH_A) ? (reg & 0x1) : ((reg >> 16) & 0x1);
+}
+
 static inline void wavegen_hw_trigger(wavegen_hw_channel_t ch) {
     uint32_t val = (ch == WAVEGEN_HW_CH_A) ? 1 : 2;
     WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_TRIGGER_OFF, val);
@@ -179,6 +343,335 @@ static inline void wavegen_hw_soft_reset(wavegen_hw_channel_t ch) {
     WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_SOFT_RST_OFF, val);
 }
 
+/* Armed start: hold at phase 0 after enable until a (software or external) trigger */
+static inline void wavegen_hw_set_trigger_config(wavegen_hw_channel_t ch, int arm,
+                                                 int external, wavegen_hw_trigger_edge_t edge) {
+    uint32_t cfg = (arm ? 0x1u : 0) | (external ? 0x2u : 0) | (((uint32_t)edge & 0x3) << 2);
+    uint32_t reg = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_TRIG_CFG_OFF);
+    if (ch == WAVEGEN_HW_CH_A)
+        reg = (reg & 0xFFFF0000) | cfg;
+    else
+        reg = (reg & 0x0000FFFF) | (cfg << 16);
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_TRIG_CFG_OFF, reg);
+}
+
+/* Trigger-to-start latency of the last trigger (IP clock cycles) */
+static inline uint32_t wavegen_hw_get_trigger_latency(wavegen_hw_channel_t ch) {
+    uintptr_t off = (ch == WAVEGEN_HW_CH_A) ? WAVEGEN_HW_TRIG_LAT_A_OFF : WAVEGEN_HW_TRIG_LAT_B_OFF;
+    return WAVEGEN_READ32(_wavegen_base + off);
+}
+
+/* AM/FM/PM modulation; from_other selects the other channel as source */
+static inline void wavegen_hw_set_modulation(wavegen_hw_channel_t ch, wavegen_hw_mod_type_t type,
+                                             int from_other, uint16_t depth,
+                                             uint32_t freq, uint32_t deviation) {
+    uint32_t cfg = ((uint32_t)type & 0x3) | (from_other ? 0x4u : 0);
+    uint32_t cfg_reg = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_MOD_CFG_OFF);
+    uint32_t depth_reg = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_MOD_DEPTH_OFF);
+    depth &= 0x7FFF;
+    if (ch == WAVEGEN_HW_CH_A) {
+        cfg_reg = (cfg_reg & 0xFFFF0000) | cfg;
+        depth_reg = (depth_reg & 0xFFFF0000) | depth;
+        WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_MOD_FREQ_A_OFF, freq);
+        WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_MOD_DEV_A_OFF, deviation);
+    } else {
+        cfg_reg = (cfg_reg & 0x0000FFFF) | (cfg << 16);
+        depth_reg = (depth_reg & 0x0000FFFF) | ((uint32_t)depth << 16);
+        WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_MOD_FREQ_B_OFF, freq);
+        WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_MOD_DEV_B_OFF, deviation);
+    }
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_MOD_CFG_OFF, cfg_reg);
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_MOD_DEPTH_OFF, depth_reg);
+}
+
+/*
+ * Output capture. output: 1 = scaled output, 0 = engine waveform.
+ * trig: 0 = software, 1 = channel A trigger, 2 = ext_trigger, 3 = sync.
+ */
+static inline void wavegen_hw_capture_arm(int output, uint32_t trig,
+                                          uint16_t pre, uint16_t decimation) {
+    uint32_t ctrl = (output ? 0x4u : 0) | ((trig & 0x3) << 4);
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_CAP_CFG_OFF, ((uint32_t)decimation << 16) | pre);
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_CAP_CTRL_OFF, ctrl | 0x1);
+}
+
+static inline void wavegen_hw_capture_trigger(void) {
+    uint32_t ctrl = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_CAP_CTRL_OFF);
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_CAP_CTRL_OFF, ctrl | 0x2);
+}
+
+static inline int wavegen_hw_capture_done(void) {
+    return (WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_CAP_STATUS_OFF) >> 2) & 0x1;
+}
+
+/* Captured sample n (0 = oldest): [31:16] channel B, [15:0] channel A */
+static inline uint32_t wavegen_hw_capture_sample(uint32_t n) {
+    return WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_CAP_DATA_OFF + n * 4);
+}
+
+/* Noise mode source; takes effect with wavegen_hw_reconfig() */
+static inline void wavegen_hw_set_noise(wavegen_hw_channel_t ch, int gaussian, uint32_t seed) {
+    uint32_t reg = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_NOISE_CFG_OFF);
+    if (ch == WAVEGEN_HW_CH_A) {
+        reg = (reg & ~0x1u) | (gaussian ? 0x1u : 0);
+        WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_NOISE_SEED_A_OFF, seed);
+    } else {
+        reg = (reg & ~0x10000u) | (gaussian ? 0x10000u : 0);
+        WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_NOISE_SEED_B_OFF, seed);
+    }
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_NOISE_CFG_OFF, reg);
+}
+
+/* Snapshot all performance counters and read them coherently */
+static inline void wavegen_hw_read_counters(wavegen_hw_counters_t *c) {
+    uint32_t w[16];
+    int i;
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_CNT_CTRL_OFF, 0x1);
+    for (i = 0; i < 16; i++)
+        w[i] = WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_CNT_BASE_OFF + i * 4);
+    c->clk_count       = ((uint64_t)w[1] << 32) | w[0];
+    c->samples_a       = ((uint64_t)w[3] << 32) | w[2];
+    c->samples_b       = ((uint64_t)w[5] << 32) | w[4];
+    c->since_trigger_a = ((uint64_t)w[7] << 32) | w[6];
+    c->since_trigger_b = ((uint64_t)w[9] << 32) | w[8];
+    c->cycles_a   = w[10];
+    c->cycles_b   = w[11];
+    c->dac_frames = w[12];
+    c->underflows = w[13];
+    c->overruns   = w[14];
+    c->reconfigs  = w[15];
+}
+
+static inline void wavegen_hw_clear_counters(void) {
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_CNT_CTRL_OFF, 0x2);
+}
+
+/* ============================================================
+ * Profiles: store full configurations ahead of time, then switch
+ * both channels in one clock cycle with a single register write
+ * (or from the profile_sel pins). Switching loads the shadow
+ * registers too, so re-init any wavegen_hw_ctx_t afterwards.
+ * ============================================================ */
+
+/* Number of profile banks the IP was built with */
+static inline uint32_t wavegen_hw_profile_count(void) {
+    return (WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_PROFILE_SEL_OFF) >> 16) & 0xFF;
+}
+
+/* Write a profile bank (does not change the output) */
+static inline void wavegen_hw_store_profile(uint32_t index, const wavegen_hw_profile_t *p) {
+    uintptr_t bank = _wavegen_base + WAVEGEN_HW_PROFILE_OFF + index * WAVEGEN_HW_PROFILE_STRIDE;
+    WAVEGEN_WRITE32(bank + WAVEGEN_HW_MODE_OFF,
+                    (((uint32_t)p->mode_b & 0xF) << 4) | ((uint32_t)p->mode_a & 0xF));
+    WAVEGEN_WRITE32(bank + WAVEGEN_HW_FREQ_A_OFF, p->freq_a);
+    WAVEGEN_WRITE32(bank + WAVEGEN_HW_FREQ_B_OFF, p->freq_b);
+    WAVEGEN_WRITE32(bank + WAVEGEN_HW_OFFSET_OFF,
+                    ((uint32_t)(uint16_t)p->offset_b << 16) | (uint16_t)p->offset_a);
+    WAVEGEN_WRITE32(bank + WAVEGEN_HW_AMPLTD_OFF, ((uint32_t)p->amp_b << 16) | p->amp_a);
+    WAVEGEN_WRITE32(bank + WAVEGEN_HW_DTCYC_OFF, ((uint32_t)p->duty_b << 16) | p->duty_a);
+    WAVEGEN_WRITE32(bank + WAVEGEN_HW_CYCLES_OFF, ((uint32_t)p->cycles_b << 16) | p->cycles_a);
+    WAVEGEN_WRITE32(bank + WAVEGEN_HW_PHASE_OFF,
+                    ((uint32_t)(uint16_t)p->phase_b << 16) | (uint16_t)p->phase_a);
+}
+
+/* Apply a profile to both channels; out-of-range indices are ignored */
+static inline void wavegen_hw_select_profile(uint32_t index) {
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_PROFILE_SEL_OFF, index & 0xF);
+}
+
+/* Hand profile selection to the profile_sel pins (applied on every change) */
+static inline void wavegen_hw_profile_pins(void) {
+    WAVEGEN_WRITE32(_wavegen_base + WAVEGEN_HW_PROFILE_SEL_OFF, 0x100);
+}
+
+/* Last applied profile */
+static inline uint32_t wavegen_hw_active_profile(void) {
+    return WAVEGEN_READ32(_wavegen_base + WAVEGEN_HW_PROFILE_SEL_OFF) & 0xF;
+}
+
+/* ============================================================
+ * Cached context (transactions without MMIO reads)
+ *
+ * The context keeps a copy of every writable configuration
+ * register. Setters update the copy and mark changed words;
+ * wavegen_hw_ctx_commit() writes only those words, then one
+ * RECONFIG. begin/commit pairs may nest; only the outermost
+ * commit touches the hardware.
+ *
+ *   wavegen_hw_ctx_t ctx;
+ *   wavegen_hw_ctx_init(&ctx, XPAR_WAVEGEN_0_BASEADDR);
+ *   wavegen_hw_ctx_begin(&ctx);
+ *   wavegen_hw_ctx_set_amplitude(&ctx, WAVEGEN_HW_CH_A, 16000);
+ *   wavegen_hw_ctx_set_amplitude(&ctx, WAVEGEN_HW_CH_B, 8000);
+ *   wavegen_hw_ctx_commit(&ctx);     // 1 write + RECONFIG
+ *
+ * Unlike the read-modify-write setters above, which read back the
+ * active values, a context can change both halves of a packed
+ * register in one transaction.
+ * ============================================================ */
+#define WAVEGEN_HW_CTX_WORDS    24          /* Registers 0x00..0x5C */
+#define WAVEGEN_HW_CTX_CACHED   0x00FC83FFu /* Writable configuration words */
+#define WAVEGEN_HW_CTX_RUN      (1u << (WAVEGEN_HW_RUN_OFF / 4))
+
+typedef struct {
+    uintptr_t base;
+    uint32_t  reg[WAVEGEN_HW_CTX_WORDS];    /* Last value written per word */
+    uint32_t  dirty;                        /* Words changed since commit */
+    uint32_t  depth;                        /* begin/commit nesting */
+} wavegen_hw_ctx_t;
+
+/* Load the cache from the hardware (the only bus reads the context does) */
+static inline void wavegen_hw_ctx_init(wavegen_hw_ctx_t *ctx, uintptr_t base_addr) {
+    int i;
+    ctx->base = base_addr;
+    ctx->dirty = 0;
+    ctx->depth = 0;
+    for (i = 0; i < WAVEGEN_HW_CTX_WORDS; i++)
+        ctx->reg[i] = (WAVEGEN_HW_CTX_CACHED & (1u << i))
+                    ? WAVEGEN_READ32(base_addr + i * 4) : 0;
+}
+
+static inline void _wavegen_ctx_put(wavegen_hw_ctx_t *ctx, uint32_t off, uint32_t val) {
+    uint32_t i = off / 4;
+    if (ctx->reg[i] != val) {
+        ctx->reg[i] = val;
+        ctx->dirty |= 1u << i;
+    }
+}
+
+static inline void _wavegen_ctx_put16(wavegen_hw_ctx_t *ctx, uint32_t off,
+                                      wavegen_hw_channel_t ch, uint16_t val) {
+    uint32_t reg = ctx->reg[off / 4];
+    if (ch == WAVEGEN_HW_CH_A)
+        reg = (reg & 0xFFFF0000) | val;
+    else
+        reg = (reg & 0x0000FFFF) | ((uint32_t)val << 16);
+    _wavegen_ctx_put(ctx, off, reg);
+}
+
+static inline void wavegen_hw_ctx_begin(wavegen_hw_ctx_t *ctx) {
+    ctx->depth++;
+}
+
+/*
+ * Write the changed words and apply them. RUN takes effect without
+ * RECONFIG, so it is written last to start channels on the new settings.
+ */
+static inline void wavegen_hw_ctx_commit(wavegen_hw_ctx_t *ctx) {
+    uint32_t dirty;
+    int i;
+
+    if (ctx->depth > 1) {
+        ctx->depth--;
+        return;
+    }
+    ctx->depth = 0;
+    dirty = ctx->dirty;
+    if (!dirty)
+        return;
+    ctx->dirty = 0;
+
+    for (i = 0; i < WAVEGEN_HW_CTX_WORDS; i++)
+        if (dirty & ~WAVEGEN_HW_CTX_RUN & (1u << i))
+            WAVEGEN_WRITE32(ctx->base + i * 4, ctx->reg[i]);
+    if (dirty & ~WAVEGEN_HW_CTX_RUN)
+        WAVEGEN_WRITE32(ctx->base + WAVEGEN_HW_RECONFIG_OFF, 1);
+    if (dirty & WAVEGEN_HW_CTX_RUN)
+        WAVEGEN_WRITE32(ctx->base + WAVEGEN_HW_RUN_OFF, ctx->reg[WAVEGEN_HW_RUN_OFF / 4]);
+}
+
+static inline void wavegen_hw_ctx_set_mode(wavegen_hw_ctx_t *ctx, wavegen_hw_channel_t ch,
+                                           wavegen_hw_mode_t mode) {
+    uint32_t reg = ctx->reg[WAVEGEN_HW_MODE_OFF / 4];
+    if (ch == WAVEGEN_HW_CH_A)
+        reg = (reg & 0xFFFFFFF0) | (mode & 0x0F);
+    else
+        reg = (reg & 0xFFFFFF0F) | ((mode & 0x0F) << 4);
+    _wavegen_ctx_put(ctx, WAVEGEN_HW_MODE_OFF, reg);
+}
+
+static inline void wavegen_hw_ctx_set_frequency(wavegen_hw_ctx_t *ctx, wavegen_hw_channel_t ch,
+                                                uint32_t freq) {
+    _wavegen_ctx_put(ctx, (ch == WAVEGEN_HW_CH_A) ? WAVEGEN_HW_FREQ_A_OFF : WAVEGEN_HW_FREQ_B_OFF, freq);
+}
+
+static inline void wavegen_hw_ctx_set_amplitude(wavegen_hw_ctx_t *ctx, wavegen_hw_channel_t ch,
+                                                uint16_t amp) {
+    _wavegen_ctx_put16(ctx, WAVEGEN_HW_AMPLTD_OFF, ch, amp);
+}
+
+static inline void wavegen_hw_ctx_set_offset(wavegen_hw_ctx_t *ctx, wavegen_hw_channel_t ch,
+                                             int16_t offset) {
+    _wavegen_ctx_put16(ctx, WAVEGEN_HW_OFFSET_OFF, ch, (uint16_t)offset);
+}
+
+static inline void wavegen_hw_ctx_set_duty_cycle(wavegen_hw_ctx_t *ctx, wavegen_hw_channel_t ch,
+                                                 uint16_t dc) {
+    _wavegen_ctx_put16(ctx, WAVEGEN_HW_DTCYC_OFF, ch, dc);
+}
+
+static inline void wavegen_hw_ctx_set_phase_offset(wavegen_hw_ctx_t *ctx, wavegen_hw_channel_t ch,
+                                                   int16_t po) {
+    _wavegen_ctx_put16(ctx, WAVEGEN_HW_PHASE_OFF, ch, (uint16_t)po);
+}
+
+static inline void wavegen_hw_ctx_set_cycles(wavegen_hw_ctx_t *ctx, wavegen_hw_channel_t ch,
+                                             uint16_t cycles) {
+    _wavegen_ctx_put16(ctx, WAVEGEN_HW_CYCLES_OFF, ch, cycles);
+}
+
+static inline void wavegen_hw_ctx_enable(wavegen_hw_ctx_t *ctx, wavegen_hw_channel_t ch,
+                                         int enable) {
+    uint32_t bit = (ch == WAVEGEN_HW_CH_A) ? 1u : 2u;
+    uint32_t reg = ctx->reg[WAVEGEN_HW_RUN_OFF / 4];
+    _wavegen_ctx_put(ctx, WAVEGEN_HW_RUN_OFF, enable ? (reg | bit) : (reg & ~bit));
+}
+
+static inline void wavegen_hw_ctx_set_arb_depth(wavegen_hw_ctx_t *ctx, uint32_t depth) {
+    _wavegen_ctx_put(ctx, WAVEGEN_HW_ARB_DEPTH_OFF, depth);
+}
+
+static inline void wavegen_hw_ctx_set_trigger_config(wavegen_hw_ctx_t *ctx, wavegen_hw_channel_t ch,
+                                                     int arm, int external,
+                                                     wavegen_hw_trigger_edge_t edge) {
+    uint32_t cfg = (arm ? 0x1u : 0) | (external ? 0x2u : 0) | (((uint32_t)edge & 0x3) << 2);
+    _wavegen_ctx_put16(ctx, WAVEGEN_HW_TRIG_CFG_OFF, ch, (uint16_t)cfg);
+}
+
+static inline void wavegen_hw_ctx_set_modulation(wavegen_hw_ctx_t *ctx, wavegen_hw_channel_t ch,
+                                                 wavegen_hw_mod_type_t type, int from_other,
+                                                 uint16_t depth, uint32_t freq,
+                                                 uint32_t deviation) {
+    uint32_t cfg = ((uint32_t)type & 0x3) | (from_other ? 0x4u : 0);
+    _wavegen_ctx_put16(ctx, WAVEGEN_HW_MOD_CFG_OFF, ch, (uint16_t)cfg);
+    _wavegen_ctx_put16(ctx, WAVEGEN_HW_MOD_DEPTH_OFF, ch, depth & 0x7FFF);
+    if (ch == WAVEGEN_HW_CH_A) {
+        _wavegen_ctx_put(ctx, WAVEGEN_HW_MOD_FREQ_A_OFF, freq);
+        _wavegen_ctx_put(ctx, WAVEGEN_HW_MOD_DEV_A_OFF, deviation);
+    } else {
+        _wavegen_ctx_put(ctx, WAVEGEN_HW_MOD_FREQ_B_OFF, freq);
+        _wavegen_ctx_put(ctx, WAVEGEN_HW_MOD_DEV_B_OFF, deviation);
+    }
+}
+
+/*
+ * ISR fast path: set one channel's frequency and apply it at once.
+ * Two bus writes, or none if the frequency is unchanged. RECONFIG
+ * applies every shadow register, so do not call it while the
+ * interrupted code is inside wavegen_hw_ctx_commit() on the same
+ * context.
+ */
+static inline void wavegen_hw_ctx_isr_set_frequency(wavegen_hw_ctx_t *ctx,
+                                                    wavegen_hw_channel_t ch,
+                                                    uint32_t freq) {
+    uint32_t off = (ch == WAVEGEN_HW_CH_A) ? WAVEGEN_HW_FREQ_A_OFF : WAVEGEN_HW_FREQ_B_OFF;
+    if (ctx->reg[off / 4] == freq)
+        return;
+    ctx->reg[off / 4] = freq;
+    WAVEGEN_WRITE32(ctx->base + off, freq);
+    WAVEGEN_WRITE32(ctx->base + WAVEGEN_HW_RECONFIG_OFF, 1);
+}
+
 /* ============================================================
  * Convenience: Configure a channel in one call
  * ============================================================ */
@@ -0,0 +1,262 @@
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "wavegen_lib.h"
+
+/*
+ * Real-time parameter updates.
+ *
+ * A single-producer/single-consumer ring carries parameter changes from
+ * one real-time thread to a flusher thread that owns the ioctls. The
+ * producer side touches only the ring and its own counters: no locks,
+ * no allocation, no system call except a semaphore post when the
+ * flusher may be idle (at most a futex wake, which never blocks). A full
+ * ring drops the update and counts it.
+ *
+ * The flusher drains everything queued into one slot per parameter and
+ * channel, so the last value wins and overwritten values count as
+ * coalesced, then issues one setter per changed slot and, if enabled,
+ * one wavegen_apply() for the batch. A minimum interval between batches
+ * bounds the ioctl rate and lets bursts coalesce.
+ *
+ * Head and tail are free-running; entry = index & (capacity - 1). Each
+ * is written by one side only and published with release/acquire, like
+ * the command ring. Before sleeping the flusher re-reads head after a
+ * full fence, and the producer re-reads tail after one, so a push is
+ * never left in the ring with the flusher asleep. Counters have a single
+ * writer each and are read with relaxed atomics for the statistics.
+ */
+
+#define RT_DEFAULT_CAPACITY 256
+#define RT_MAX_CAPACITY     65536
+#define RT_SLOTS            (WAVEGEN_RT_PARAM_COUNT * 2)
+
+typedef struct {
+    uint16_t param;
+    uint16_t channel;
+    uint32_t value;
+} rt_entry_t;
+
+static struct {
+    /* Producer cache line */
+    uint32_t head __attribute__((aligned(64)));
+    uint32_t max_depth;
+    uint64_t pushed;
+    uint64_t dropped;
+
+    /* Consumer cache line */
+    uint32_t tail __attribute__((aligned(64)));
+    uint64_t coalesced;
+    uint64_t writes;
+    uint64_t flushes;
+    uint64_t errors;
+
+    rt_entry_t *ring;
+    uint32_t mask;
+    uint32_t interval_us;
+    int apply;
+    int stop;
+    sem_t wake;
+    pthread_t thread;
+
+    uint32_t pending[RT_SLOTS];
+    uint8_t dirty[RT_SLOTS];
+} rt;
+
+static void rt_store(uint64_t *counter, uint64_t value)
+{
+    __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+}
+
+/* ============================================================
+ * Flusher
+ * ============================================================ */
+
+static void rt_take(wavegen_rt_param_t param, unsigned int channel, uint32_t value)
+{
+    unsigned int slot = param * 2 + channel;
+
+    if (rt.dirty[slot])
+        rt_store(&rt.coalesced, rt.coalesced + 1);
+    rt.pending[slot] = value;
+    rt.dirty[slot] = 1;
+}
+
+static wavegen_error_t rt_write(wavegen_rt_param_t param, wavegen_channel_t channel,
+                                uint32_t value)
+{
+    switch (param) {
+        case WAVEGEN_RT_FREQUENCY:
+            return wavegen_set_frequency(channel, value);
+        case WAVEGEN_RT_AMPLITUDE:
+            return wavegen_set_amplitude(channel, (uint16_t)value);
+        case WAVEGEN_RT_OFFSET:
+            return wavegen_set_offset(channel, (int16_t)value);
+        case WAVEGEN_RT_DUTY_CYCLE:
+            return wavegen_set_duty_cycle(channel, (uint16_t)value);
+        case WAVEGEN_RT_PHASE_OFFSET:
+            return wavegen_set_phase_offset(channel, (int16_t)value);
+        default:
+            return WAVEGEN_ERR_PARAM;
+    }
+}
+
+/* Drain the ring and write every changed slot; returns slots written */
+static unsigned int rt_flush(void)
+{
+    uint32_t head = __atomic_load_n(&rt.head, __ATOMIC_ACQUIRE);
+    unsigned int slot, n = 0;
+
+    while (rt.tail != head) {
+        const rt_entry_t *e = &rt.ring[rt.tail & rt.mask];
+
+        if (e->channel != WAVEGEN_CH_B)
+            rt_take(e->param, 0, e->value);
+        if (e->channel != WAVEGEN_CH_A)
+            rt_take(e->param, 1, e->value);
+        __atomic_store_n(&rt.tail, rt.tail + 1, __ATOMIC_RELEASE);
+    }
+
+    for (slot = 0; slot < RT_SLOTS; slot++) {
+        if (!rt.dirty[slot])
+            continue;
+        rt.dirty[slot] = 0;
+        if (rt_write(slot / 2, (slot & 1) ? WAVEGEN_CH_B : WAVEGEN_CH_A,
+                     rt.pending[slot]) != WAVEGEN_OK)
+            rt_store(&rt.errors, rt.errors + 1);
+        n++;
+    }
+
+    if (n) {
+        if (rt.apply && wavegen_apply() != WAVEGEN_OK)
+            rt_store(&rt.errors, rt.errors + 1);
+        rt_store(&rt.writes, rt.writes + n);
+        rt_store(&rt.flushes, rt.flushes + 1);
+    }
+    return n;
+}
+
+static void *rt_flusher(void *arg)
+{
+    (void)arg;
+
+    while (!__atomic_load_n(&rt.stop, __ATOMIC_ACQUIRE)) {
+        if (rt_flush()) {
+            if (rt.interval_us)
+                usleep(rt.interval_us);
+            continue;
+        }
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&rt.head, __ATOMIC_ACQUIRE) != rt.tail)
+            continue;
+        sem_wait(&rt.wake);             /* EINTR just loops */
+    }
+    rt_flush();
+    return NULL;
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+wavegen_error_t wavegen_rt_start(const wavegen_rt_config_t *config)
+{
+    uint32_t capacity = config && config->capacity ? config->capacity
+                                                   : RT_DEFAULT_CAPACITY;
+    wavegen_status_t status;
+
+    if (rt.ring) return WAVEGEN_ERR_BUSY;
+    if (wavegen_get_status(&status) != WAVEGEN_OK) return WAVEGEN_ERR_NOT_INIT;
+    if (capacity > RT_MAX_CAPACITY || (capacity & (capacity - 1)))
+        return WAVEGEN_ERR_PARAM;
+
+    memset(&rt, 0, sizeof(rt));
+    rt.ring = malloc(capacity * sizeof(*rt.ring));
+    if (!rt.ring)
+        return WAVEGEN_ERR_ALLOC;
+    memset(rt.ring, 0, capacity * sizeof(*rt.ring));  /* Fault the pages in now */
+    rt.mask = capacity - 1;
+    rt.interval_us = config ? config->interval_us : 0;
+    rt.apply = config ? config->apply : 1;
+
+    if (sem_init(&rt.wake, 0, 0) < 0)
+        goto fail;
+    if (pthread_create(&rt.thread, NULL, rt_flusher, NULL) != 0) {
+        sem_destroy(&rt.wake);
+        goto fail;
+    }
+    return WAVEGEN_OK;
+
+fail:
+    free(rt.ring);
+    rt.ring = NULL;
+    return WAVEGEN_ERR_INIT;
+}
+
+wavegen_error_t wavegen_rt_push(wavegen_rt_param_t param, wavegen_channel_t channel,
+                                uint32_t value)
+{
+    uint32_t head, depth;
+    rt_entry_t *e;
+
+    if (!rt.ring) return WAVEGEN_ERR_NOT_INIT;
+    if (param >= WAVEGEN_RT_PARAM_COUNT || channel > WAVEGEN_CH_BOTH)
+        return WAVEGEN_ERR_PARAM;
+
+    head = rt.head;
+    depth = head - __atomic_load_n(&rt.tail, __ATOMIC_ACQUIRE);
+    if (depth > rt.mask) {
+        rt_store(&rt.dropped, rt.dropped + 1);
+        return WAVEGEN_ERR_BUSY;
+    }
+
+    e = &rt.ring[head & rt.mask];
+    e->param = (uint16_t)param;
+    e->channel = (uint16_t)channel;
+    e->value = value;
+    __atomic_store_n(&rt.head, head + 1, __ATOMIC_RELEASE);
+
+    rt_store(&rt.pushed, rt.pushed + 1);
+    if (depth + 1 > rt.max_depth)
+        __atomic_store_n(&rt.max_depth, depth + 1, __ATOMIC_RELAXED);
+
+    /* Everything before this entry consumed: the flusher may be asleep */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&rt.tail, __ATOMIC_RELAXED) == head)
+        sem_post(&rt.wake);
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_rt_stop(void)
+{
+    if (!rt.ring) return WAVEGEN_ERR_NOT_INIT;
+
+    __atomic_store_n(&rt.stop, 1, __ATOMIC_RELEASE);
+    sem_post(&rt.wake);
+    pthread_join(rt.thread, NULL);
+    sem_destroy(&rt.wake);
+
+    free(rt.ring);
+    rt.ring = NULL;
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_rt_get_stats(wavegen_rt_stats_t *stats)
+{
+    if (!rt.ring) return WAVEGEN_ERR_NOT_INIT;
+    if (!stats) return WAVEGEN_ERR_PARAM;
+
+    stats->depth = __atomic_load_n(&rt.head, __ATOMIC_ACQUIRE) -
+                   __atomic_load_n(&rt.tail, __ATOMIC_ACQUIRE);
+    stats->max_depth = __atomic_load_n(&rt.max_depth, __ATOMIC_RELAXED);
+    stats->capacity = rt.mask + 1;
+    stats->pushed = __atomic_load_n(&rt.pushed, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&rt.dropped, __ATOMIC_RELAXED);
+    stats->coalesced = __atomic_load_n(&rt.coalesced, __ATOMIC_RELAXED);
+    stats->writes = __atomic_load_n(&rt.writes, __ATOMIC_RELAXED);
+    stats->flushes = __atomic_load_n(&rt.flushes, __ATOMIC_RELAXED);
+    stats->errors = __atomic_load_n(&rt.errors, __ATOMIC_RELAXED);
+    return WAVEGEN_OK;
+}
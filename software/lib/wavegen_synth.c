@@ -0,0 +1,466 @@
+#include <math.h>
+#include <stddef.h>
+#include "wavegen_lib.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define WAVEGEN_SYNTH_NEON 1
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define WAVEGEN_SYNTH_AVX2 1
+#endif
+
+/*
+ * ARB table synthesis.
+ *
+ * Every generator works in blocks of SYNTH_BLOCK float samples on the
+ * stack: the block is filled (tone sums, window shapes, interpolation)
+ * and then quantized straight into the caller's table, so no heap
+ * buffers are needed for any table size.
+ *
+ * Two kernels carry the per-sample work and have vector versions:
+ *   - sine accumulation: 32-bit fixed-point phase (turns), folded to a
+ *     quarter wave and evaluated with an odd polynomial (< 1e-7 error)
+ *   - quantization: scale, clip to -32768..32767 (NaN -> -32768) and
+ *     round to nearest, ties to even; all kernels give identical codes
+ * AVX2 is selected at run time on x86; NEON is used when the library is
+ * built for ARM with NEON enabled (e.g. -mfpu=neon on the Zynq A9).
+ * Do not build this file with -ffast-math: the scalar and NEON rounding
+ * relies on IEEE float addition.
+ */
+
+#define SYNTH_BLOCK     256
+#define SYNTH_FULL      32767.0f
+#define SYNTH_MIN       (-32768.0f)
+#define SYNTH_MAX       32767.0f
+#define SYNTH_ROUND     12582912.0f     /* 1.5 * 2^23: round-to-even magic */
+#define SYNTH_PI        3.14159265358979323846
+#define SYNTH_TWO_PI    6.28318530717958647692f
+#define SYNTH_PHASE_SCALE 4294967296.0  /* 2^32 phase units per turn */
+
+/* Odd Taylor coefficients of sin(x), |x| <= pi/2 */
+#define SIN_C3  (-1.66666667e-1f)
+#define SIN_C5  (8.33333333e-3f)
+#define SIN_C7  (-1.98412698e-4f)
+#define SIN_C9  (2.75573192e-6f)
+#define SIN_C11 (-2.50521084e-8f)
+
+/* ============================================================
+ * Scalar kernels
+ * ============================================================ */
+
+static float sin_turns(int32_t phase)
+{
+    float r = (float)phase * (1.0f / 4294967296.0f);    /* [-0.5, 0.5) */
+    float x, x2;
+
+    if (r > 0.25f)
+        r = 0.5f - r;
+    else if (r < -0.25f)
+        r = -0.5f - r;
+
+    x = r * SYNTH_TWO_PI;
+    x2 = x * x;
+    return x * (1.0f + x2 * (SIN_C3 + x2 * (SIN_C5 + x2 * (SIN_C7 +
+               x2 * (SIN_C9 + x2 * SIN_C11)))));
+}
+
+static void sine_acc_scalar(float *acc, uint32_t n, uint32_t phase,
+                            uint32_t inc, float amp)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        acc[i] += amp * sin_turns((int32_t)phase);
+        phase += inc;
+    }
+}
+
+static void quantize_scalar(uint16_t *dst, const float *src, uint32_t n,
+                            float scale)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        float v = src[i] * scale;
+        v = (v > SYNTH_MIN) ? v : SYNTH_MIN;
+        v = (v < SYNTH_MAX) ? v : SYNTH_MAX;
+        v = (v + SYNTH_ROUND) - SYNTH_ROUND;
+        dst[i] = (uint16_t)(int16_t)(int32_t)v;
+    }
+}
+
+/* ============================================================
+ * NEON kernels (ARMv7 NEON subset: no rounding conversions)
+ * ============================================================ */
+#ifdef WAVEGEN_SYNTH_NEON
+
+static float32x4_t sin_turns_neon(int32x4_t phase)
+{
+    float32x4_t r = vmulq_n_f32(vcvtq_f32_s32(phase), 1.0f / 4294967296.0f);
+    float32x4_t half = vbslq_f32(vcltq_f32(r, vdupq_n_f32(0.0f)),
+                                 vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f));
+    uint32x4_t fold = vcgtq_f32(vabsq_f32(r), vdupq_n_f32(0.25f));
+    float32x4_t x, x2, p;
+
+    r = vbslq_f32(fold, vsubq_f32(half, r), r);
+    x = vmulq_n_f32(r, SYNTH_TWO_PI);
+    x2 = vmulq_f32(x, x);
+    p = vaddq_f32(vdupq_n_f32(SIN_C9), vmulq_n_f32(x2, SIN_C11));
+    p = vaddq_f32(vdupq_n_f32(SIN_C7), vmulq_f32(x2, p));
+    p = vaddq_f32(vdupq_n_f32(SIN_C5), vmulq_f32(x2, p));
+    p = vaddq_f32(vdupq_n_f32(SIN_C3), vmulq_f32(x2, p));
+    p = vaddq_f32(vdupq_n_f32(1.0f), vmulq_f32(x2, p));
+    return vmulq_f32(x, p);
+}
+
+static void sine_acc_neon(float *acc, uint32_t n, uint32_t phase,
+                          uint32_t inc, float amp)
+{
+    static const uint32_t lane[4] = { 0, 1, 2, 3 };
+    uint32x4_t p = vmlaq_n_u32(vdupq_n_u32(phase), vld1q_u32(lane), inc);
+    uint32x4_t step = vdupq_n_u32(inc * 4);
+    uint32_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        float32x4_t s = sin_turns_neon(vreinterpretq_s32_u32(p));
+        vst1q_f32(acc + i, vaddq_f32(vld1q_f32(acc + i), vmulq_n_f32(s, amp)));
+        p = vaddq_u32(p, step);
+    }
+    sine_acc_scalar(acc + i, n - i, phase + i * inc, inc, amp);
+}
+
+static void quantize_neon(uint16_t *dst, const float *src, uint32_t n,
+                          float scale)
+{
+    const float32x4_t lo = vdupq_n_f32(SYNTH_MIN);
+    const float32x4_t hi = vdupq_n_f32(SYNTH_MAX);
+    const float32x4_t magic = vdupq_n_f32(SYNTH_ROUND);
+    uint32_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        float32x4_t a = vmulq_n_f32(vld1q_f32(src + i), scale);
+        float32x4_t b = vmulq_n_f32(vld1q_f32(src + i + 4), scale);
+        /* Compare-and-select so NaN clips to the minimum like the scalar path */
+        a = vbslq_f32(vcgtq_f32(a, lo), a, lo);
+        b = vbslq_f32(vcgtq_f32(b, lo), b, lo);
+        a = vbslq_f32(vcltq_f32(a, hi), a, hi);
+        b = vbslq_f32(vcltq_f32(b, hi), b, hi);
+        a = vsubq_f32(vaddq_f32(a, magic), magic);
+        b = vsubq_f32(vaddq_f32(b, magic), magic);
+        vst1q_s16((int16_t *)(dst + i),
+                  vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)),
+                               vqmovn_s32(vcvtq_s32_f32(b))));
+    }
+    quantize_scalar(dst + i, src + i, n - i, scale);
+}
+
+#endif /* WAVEGEN_SYNTH_NEON */
+
+/* ============================================================
+ * AVX2 kernels (compiled for AVX2, selected at run time)
+ * ============================================================ */
+#ifdef WAVEGEN_SYNTH_AVX2
+
+__attribute__((target("avx2")))
+static __m256 sin_turns_avx2(__m256i phase)
+{
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    __m256 r = _mm256_mul_ps(_mm256_cvtepi32_ps(phase),
+                             _mm256_set1_ps(1.0f / 4294967296.0f));
+    __m256 half = _mm256_or_ps(_mm256_and_ps(r, sign_mask), _mm256_set1_ps(0.5f));
+    __m256 fold = _mm256_cmp_ps(_mm256_andnot_ps(sign_mask, r),
+                                _mm256_set1_ps(0.25f), _CMP_GT_OQ);
+    __m256 x, x2, p;
+
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(half, r), fold);
+    x = _mm256_mul_ps(r, _mm256_set1_ps(SYNTH_TWO_PI));
+    x2 = _mm256_mul_ps(x, x);
+    p = _mm256_add_ps(_mm256_set1_ps(SIN_C9), _mm256_mul_ps(x2, _mm256_set1_ps(SIN_C11)));
+    p = _mm256_add_ps(_mm256_set1_ps(SIN_C7), _mm256_mul_ps(x2, p));
+    p = _mm256_add_ps(_mm256_set1_ps(SIN_C5), _mm256_mul_ps(x2, p));
+    p = _mm256_add_ps(_mm256_set1_ps(SIN_C3), _mm256_mul_ps(x2, p));
+    p = _mm256_add_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(x2, p));
+    return _mm256_mul_ps(x, p);
+}
+
+__attribute__((target("avx2")))
+static void sine_acc_avx2(float *acc, uint32_t n, uint32_t phase,
+                          uint32_t inc, float amp)
+{
+    __m256i p = _mm256_add_epi32(_mm256_set1_epi32((int)phase),
+                    _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                       _mm256_set1_epi32((int)inc)));
+    const __m256i step = _mm256_set1_epi32((int)(inc * 8));
+    const __m256 vamp = _mm256_set1_ps(amp);
+    uint32_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256 s = sin_turns_avx2(p);
+        _mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i),
+                                                _mm256_mul_ps(s, vamp)));
+        p = _mm256_add_epi32(p, step);
+    }
+    sine_acc_scalar(acc + i, n - i, phase + i * inc, inc, amp);
+}
+
+__attribute__((target("avx2")))
+static void quantize_avx2(uint16_t *dst, const float *src, uint32_t n,
+                          float scale)
+{
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 lo = _mm256_set1_ps(SYNTH_MIN);
+    const __m256 hi = _mm256_set1_ps(SYNTH_MAX);
+    uint32_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_mul_ps(_mm256_loadu_ps(src + i), vscale);
+        __m256 b = _mm256_mul_ps(_mm256_loadu_ps(src + i + 8), vscale);
+        __m256i packed;
+        /* max(v, lo) returns lo for NaN, matching the scalar path */
+        a = _mm256_min_ps(_mm256_max_ps(a, lo), hi);
+        b = _mm256_min_ps(_mm256_max_ps(b, lo), hi);
+        /* cvtps rounds to nearest even (default MXCSR mode) */
+        packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+        packed = _mm256_permute4x64_epi64(packed, 0xD8);
+        _mm256_storeu_si256((__m256i *)(dst + i), packed);
+    }
+    quantize_scalar(dst + i, src + i, n - i, scale);
+}
+
+#endif /* WAVEGEN_SYNTH_AVX2 */
+
+/* ============================================================
+ * Kernel dispatch
+ * ============================================================ */
+typedef void (*sine_acc_fn)(float *, uint32_t, uint32_t, uint32_t, float);
+typedef void (*quantize_fn)(uint16_t *, const float *, uint32_t, float);
+
+struct synth_kernels {
+    const char *name;
+    sine_acc_fn sine_acc;
+    quantize_fn quantize;
+};
+
+static const struct synth_kernels synth_scalar = {
+    "scalar", sine_acc_scalar, quantize_scalar
+};
+#if defined(WAVEGEN_SYNTH_NEON)
+static const struct synth_kernels synth_neon = {
+    "neon", sine_acc_neon, quantize_neon
+};
+#elif defined(WAVEGEN_SYNTH_AVX2)
+static const struct synth_kernels synth_avx2 = {
+    "avx2", sine_acc_avx2, quantize_avx2
+};
+#endif
+
+/*
+ * The selected table is published with one release store: concurrent
+ * first calls may each select, but they pick the same table and every
+ * reader sees a complete one.
+ */
+static const struct synth_kernels *synth_kernels;
+
+static const struct synth_kernels *synth_select_kernels(void)
+{
+    const struct synth_kernels *k = __atomic_load_n(&synth_kernels, __ATOMIC_ACQUIRE);
+
+    if (k)
+        return k;
+
+    k = &synth_scalar;
+#if defined(WAVEGEN_SYNTH_NEON)
+    k = &synth_neon;
+#elif defined(WAVEGEN_SYNTH_AVX2)
+    /* CPU features are detected by a libgcc constructor before main() */
+    if (__builtin_cpu_supports("avx2"))
+        k = &synth_avx2;
+#endif
+    __atomic_store_n(&synth_kernels, k, __ATOMIC_RELEASE);
+    return k;
+}
+
+const char *wavegen_synth_kernel(void)
+{
+    return synth_select_kernels()->name;
+}
+
+/* Phase increment in 2^32 units per turn, wrapped to 32 bits */
+static uint32_t synth_phase(double turns)
+{
+    double t = turns - floor(turns);
+    return (uint32_t)(uint64_t)(t * SYNTH_PHASE_SCALE + 0.5);
+}
+
+/* ============================================================
+ * Generators
+ * ============================================================ */
+
+wavegen_error_t wavegen_synth_quantize(uint16_t *table, const float *src,
+                                       uint32_t count, double gain)
+{
+    if (!table || !src || count == 0) return WAVEGEN_ERR_PARAM;
+
+    synth_select_kernels()->quantize(table, src, count, (float)(gain * SYNTH_FULL));
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_synth_multitone(uint16_t *table, uint32_t count,
+                                        const wavegen_tone_t *tones,
+                                        uint32_t num_tones)
+{
+    float block[SYNTH_BLOCK];
+    const struct synth_kernels *kern;
+    uint32_t base, i, t;
+
+    if (!table || count == 0 || !tones || num_tones == 0)
+        return WAVEGEN_ERR_PARAM;
+
+    kern = synth_select_kernels();
+    for (base = 0; base < count; base += SYNTH_BLOCK) {
+        uint32_t n = (count - base < SYNTH_BLOCK) ? count - base : SYNTH_BLOCK;
+
+        for (i = 0; i < n; i++)
+            block[i] = 0.0f;
+        for (t = 0; t < num_tones; t++) {
+            double step = tones[t].cycles / count;
+            uint32_t inc = synth_phase(step);
+            uint32_t phase = synth_phase(tones[t].phase / 360.0 + step * base);
+            kern->sine_acc(block, n, phase, inc, (float)tones[t].amplitude);
+        }
+        kern->quantize(table + base, block, n, SYNTH_FULL);
+    }
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_synth_sinc(uint16_t *table, uint32_t count,
+                                   double lobes, double amplitude)
+{
+    float block[SYNTH_BLOCK];
+    const struct synth_kernels *kern;
+    double half = count / 2.0;
+    double step = lobes / count;        /* sin(pi x) argument, in turns */
+    uint32_t inc, base, i;
+
+    if (!table || count < 2 || !(lobes > 0.0))
+        return WAVEGEN_ERR_PARAM;
+
+    kern = synth_select_kernels();
+    inc = synth_phase(step);
+    for (base = 0; base < count; base += SYNTH_BLOCK) {
+        uint32_t n = (count - base < SYNTH_BLOCK) ? count - base : SYNTH_BLOCK;
+
+        for (i = 0; i < n; i++)
+            block[i] = 0.0f;
+        kern->sine_acc(block, n, synth_phase(step * (base - half)), inc, 1.0f);
+        for (i = 0; i < n; i++) {
+            double x = (base + i - half) * 2.0 * step;    /* in units of pi */
+            block[i] = (x == 0.0) ? 1.0f : block[i] / (float)(SYNTH_PI * x);
+        }
+        kern->quantize(table + base, block, n, (float)(amplitude * SYNTH_FULL));
+    }
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_synth_gaussian(uint16_t *table, uint32_t count,
+                                       double sigma, double amplitude)
+{
+    float block[SYNTH_BLOCK];
+    const struct synth_kernels *kern;
+    double half = count / 2.0;
+    float k;
+    uint32_t base, i;
+
+    if (!table || count == 0 || !(sigma > 0.0))
+        return WAVEGEN_ERR_PARAM;
+
+    kern = synth_select_kernels();
+    k = (float)(-0.5 / ((sigma * count) * (sigma * count)));
+    for (base = 0; base < count; base += SYNTH_BLOCK) {
+        uint32_t n = (count - base < SYNTH_BLOCK) ? count - base : SYNTH_BLOCK;
+
+        for (i = 0; i < n; i++) {
+            float d = (float)(base + i - half);
+            block[i] = expf(k * d * d);
+        }
+        kern->quantize(table + base, block, n, (float)(amplitude * SYNTH_FULL));
+    }
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_synth_prbs(uint16_t *table, uint32_t count,
+                                   wavegen_prbs_t order,
+                                   uint32_t samples_per_bit,
+                                   double amplitude, uint32_t seed)
+{
+    uint32_t tap, mask, lfsr, i, hold;
+    uint16_t code[2];
+    float level[2];
+
+    if (!table || count == 0 || samples_per_bit == 0)
+        return WAVEGEN_ERR_PARAM;
+
+    /* Fibonacci LFSR, x^order + x^tap + 1 (maximal length) */
+    switch (order) {
+    case WAVEGEN_PRBS7:  tap = 6;  break;
+    case WAVEGEN_PRBS9:  tap = 5;  break;
+    case WAVEGEN_PRBS15: tap = 14; break;
+    case WAVEGEN_PRBS23: tap = 18; break;
+    case WAVEGEN_PRBS31: tap = 28; break;
+    default: return WAVEGEN_ERR_PARAM;
+    }
+    mask = (uint32_t)((1ULL << order) - 1);
+    lfsr = seed & mask;
+    if (lfsr == 0)
+        lfsr = mask;
+
+    level[0] = -1.0f;
+    level[1] = 1.0f;
+    synth_select_kernels()->quantize(code, level, 2, (float)(amplitude * SYNTH_FULL));
+
+    hold = 0;
+    for (i = 0; i < count; i++) {
+        if (hold == samples_per_bit) {
+            uint32_t fb = ((lfsr >> (order - 1)) ^ (lfsr >> (tap - 1))) & 1;
+            lfsr = ((lfsr << 1) | fb) & mask;
+            hold = 0;
+        }
+        table[i] = code[(lfsr >> (order - 1)) & 1];
+        hold++;
+    }
+    return WAVEGEN_OK;
+}
+
+wavegen_error_t wavegen_synth_resample(uint16_t *table, uint32_t count,
+                                       const float *src, uint32_t src_count,
+                                       double gain)
+{
+    float block[SYNTH_BLOCK];
+    const struct synth_kernels *kern;
+    uint64_t pos = 0, step;
+    uint32_t base, i;
+
+    if (!table || count == 0 || !src || src_count == 0)
+        return WAVEGEN_ERR_PARAM;
+
+    if (src_count == count)
+        return wavegen_synth_quantize(table, src, count, gain);
+
+    /* Periodic linear interpolation, 32.32 fixed-point source position */
+    kern = synth_select_kernels();
+    step = ((uint64_t)src_count << 32) / count;
+    for (base = 0; base < count; base += SYNTH_BLOCK) {
+        uint32_t n = (count - base < SYNTH_BLOCK) ? count - base : SYNTH_BLOCK;
+
+        for (i = 0; i < n; i++) {
+            uint32_t idx = (uint32_t)(pos >> 32);
+            uint32_t next = (idx + 1 == src_count) ? 0 : idx + 1;
+            float frac = (float)(uint32_t)pos * (1.0f / 4294967296.0f);
+            block[i] = src[idx] + frac * (src[next] - src[idx]);
+            pos += step;
+        }
+        kern->quantize(table + base, block, n, (float)(gain * SYNTH_FULL));
+    }
+    return WAVEGEN_OK;
+}
\ No newline at end of file
@@ -0,0 +1,554 @@
+#!/usr/bin/env python3
+"""
+Spectral quality analyzer for the Waveform Generator FPGA IP.
+
+Measures SFDR, THD, SNR, SINAD/ENOB and the largest spurs of the IP output
+by FFT and writes them as a JSON report. The samples come either from a
+bit-exact model of the engine (WaveForms, SineWaves or SineCordic, the ARB
+table reader, NoiseGen, the interpolator and the amplitude/offset scaling)
+or from captured output of the Verilator harness (hdl/sim, raw int16 or
+CSV).
+
+Usage:
+  python spectrum.py [--mode M ...] [--freq F ...] [--phase DEG ...]
+                     [--samples N] [--bits B] [--lut-file FILE]
+                     [--engine {lut,cordic}] [--cordic-iterations I]
+                     [--cordic-width W] [--interp-stages S]
+                     [--arb-file FILE] [--arb-interp]
+                     [--noise-seed S] [--noise-gaussian]
+                     [--sampling-frequency HZ] [--points N] [--coherent]
+                     [-o FILE]
+  python spectrum.py --input wavegen_sim_a.raw [--rate HZ] [-o FILE]
+
+Model sweeps run every combination of --mode, --freq and --phase; --freq
+also takes START:STOP:COUNT for a linear sweep. The LUT is generated with
+coe.py's generator (--samples/--bits) unless --lut-file names a table.
+Each report records the IP configuration it was measured with, so reports
+from different LUT, engine and interpolation settings can be compared
+point by point.
+
+Modes arb, noise and dc:
+  arb    plays the --arb-file table (raw int16 LE, $readmemh hex words, or
+         one integer per line) with ARB_DEPTH = its length, with or without
+         linear interpolation (--arb-interp, ARB_CFG bit 0/16). The table
+         is stored raw; a delta-coded load plays its decoded samples. The
+         fundamental is the largest component, since a table may hold
+         several cycles. PHASE_OFF does not apply to ARB.
+  noise  NoiseGen with --noise-seed, uniform or --noise-gaussian. There is
+         no tone, so only noise_dbfs, snr_db (a full-scale sine over the
+         noise power) and ripple_db (spread of the power over 16 sub-bands)
+         are reported.
+  dc     the OFFSET level; reports the level and any residual as for noise.
+
+The model follows the hardware phase step, FREQ * PHASE_SCALE with
+PHASE_SCALE = 2^32 / engine rate truncated as in WaveForms (one FREQ LSB
+per Hz, so F Hz is modelled as FREQ = F), so a tone is generally not periodic
+in the FFT record and a 7-term Blackman-Harris window is used. --coherent
+rounds the phase step to an odd number of FFT bins instead, which needs no
+window and exercises each reachable phase equally, as coe.py --sfdr does.
+
+Metrics (dBc relative to the fundamental unless noted):
+  sfdr_dbc              fundamental to the largest other component
+  sfdr_nonharmonic_dbc  same, ignoring harmonics (useful for non-sine modes)
+  thd_dbc               harmonics 2..--harmonics, aliased into the band
+  snr_db / sinad_db     fundamental to noise (without / with harmonics)
+  enob                  (SINAD - 1.76) / 6.02
+"""
+
+import argparse
+import json
+import math
+import os
+import sys
+
+try:
+    import numpy as np
+except ImportError:
+    sys.exit("spectrum.py requires numpy")
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from coe import generate_quarter_wave_lut_np, sinewaves_model  # noqa: E402
+
+MODES = ('sine', 'sawtooth', 'triangle', 'square', 'quadrature', 'arb',
+         'noise', 'dc')
+TONELESS = ('noise', 'dc')
+FULL_SCALE = 32767
+
+# Blackman-Harris 7-term (about -180 dB sidelobes, main lobe +/-7 bins)
+BH7 = (0.27105140069342, 0.43329793923448, 0.21812299954311,
+       0.06592544638803, 0.01081174209837, 0.00077658482522,
+       0.00001388721735)
+BH7_HALF_WIDTH = 8
+
+# HalfBandInterp coefficients (Q1.17, gain 2)
+HB_COEF = (80180, -19314, 5848, -1342, 164)
+
+# SineCordic atan(2^-i) table in 2^-32 turn units
+CORDIC_ATAN = (
+    536870912, 316933406, 167458907, 85004756, 42667331, 21354465,
+    10679838, 5340245, 2670163, 1335087, 667544, 333772, 166886, 83443,
+    41722, 20861, 10430, 5215, 2608, 1304, 652, 326, 163, 81, 41, 20, 10,
+    5, 3, 1)
+
+
+# ==========================================================================
+# Engine model
+# ==========================================================================
+
+def load_hex_lut(path):
+    """Read a $readmemh table (one hex word per line) as written by coe.py."""
+    with open(path) as f:
+        return [int(line.split('//')[0], 16) for line in f
+                if line.split('//')[0].strip()]
+
+
+def load_arb_table(path):
+    """ARB samples (signed) from a raw int16 LE, $readmemh or integer file."""
+    if path.endswith(('.raw', '.bin')):
+        return np.fromfile(path, dtype='<i2').astype(np.int64)
+    with open(path) as f:
+        words = [line.split('//')[0].strip() for line in f]
+    words = [w for w in words if w]
+    if path.endswith(('.hex', '.mem')):
+        values = [int(w, 16) & 0xFFFF for w in words]
+        return np.array([v - 0x10000 if v & 0x8000 else v for v in values],
+                        dtype=np.int64)
+    return np.array([int(w, 0) for w in words], dtype=np.int64)
+
+
+def arb_model(table, phase, interp):
+    """Bit-exact model of the ARB reader (raw format, depth = len(table))."""
+    length = len(table)
+    pos = np.asarray(phase, dtype=np.int64) * length
+    index = pos >> 32
+    s0 = table[index]
+    if not interp:
+        return s0
+    s1 = table[np.where(index == length - 1, 0, index + 1)]
+    frac = (pos >> 16) & 0xFFFF
+    return s0 + (((s1 - s0) * frac) >> 16)
+
+
+def noise_model(points, seed, gaussian):
+    """Bit-exact model of NoiseGen from a (re)start with the given seed."""
+    mask = (1 << 64) - 1
+    state = (((seed ^ 0x9E3779B9) & 0xFFFFFFFF) << 32) | ((seed ^ 0x7F4A7C15) & 0xFFFFFFFF)
+    states = np.empty(points, dtype=np.uint64)
+    for i in range(points):
+        states[i] = state
+        state ^= (state << 13) & mask
+        state ^= state >> 7
+        state ^= (state << 17) & mask
+
+    def slice16(k):
+        v = ((states >> np.uint64(16 * k)) & np.uint64(0xFFFF)).astype(np.int64)
+        return np.where(v & 0x8000, v - 0x10000, v)
+
+    if not gaussian:
+        return slice16(3)
+    return (slice16(0) + slice16(1) + slice16(2) + slice16(3)) >> 2
+
+
+def cordic_model(phase, iterations=16, out_width=16):
+    """Bit-exact model of SineCordicChannel; returns (sin, cos) arrays."""
+    n = iterations
+    g = (n - 1).bit_length() + 1 if n > 1 else 1
+    zb = out_width + 6
+    amplitude = ((1 << (out_width - 1)) - 1) << g
+    max_out = (1 << (out_width - 1)) - 1
+
+    k = 1.0
+    p = 1.0
+    for _ in range(n):
+        k /= math.sqrt(1.0 + p)
+        p /= 4.0
+    x0 = int(k * amplitude + 0.5)
+
+    phase = np.asarray(phase, dtype=np.int64) & 0xFFFFFFFF
+    quad = phase >> 30
+    z = (phase >> (30 - (zb - 2))) & ((1 << (zb - 2)) - 1)
+    x = np.full(phase.shape, x0, dtype=np.int64)
+    y = np.zeros(phase.shape, dtype=np.int64)
+    for i in range(n):
+        a = (CORDIC_ATAN[i] + (1 << (31 - zb))) >> (32 - zb)
+        neg = z < 0
+        x, y = (np.where(neg, x + (y >> i), x - (y >> i)),
+                np.where(neg, y - (x >> i), y + (x >> i)))
+        z = np.where(neg, z + a, z - a)
+
+    def finish(v):
+        r = (v + (1 << (g - 1))) >> g
+        return np.clip(r, -max_out, max_out) << (16 - out_width)
+
+    c, s = finish(x), finish(y)
+    sin = np.select([quad == 0, quad == 1, quad == 2], [s, c, -s], -c)
+    cos = np.select([quad == 0, quad == 1, quad == 2], [c, -s, -c], s)
+    return sin, cos
+
+
+def halfband_model(x):
+    """Bit-exact model of one HalfBandInterp stage on a periodic record.
+
+    Output 2n is the mid-point sample from the ten newest inputs, output
+    2n + 1 the input delayed by four samples.
+    """
+    x = np.asarray(x, dtype=np.int64)
+    acc = np.zeros_like(x)
+    for i, c in enumerate(HB_COEF):
+        acc += c * (np.roll(x, 4 - i) + np.roll(x, 5 + i))
+    mid = np.clip((acc + 65536) >> 17, -32768, 32767)
+    out = np.empty(2 * len(x), dtype=np.int64)
+    out[0::2] = mid
+    out[1::2] = np.roll(x, 4)
+    return out
+
+
+def phase_step(freq_hz, cfg, engine_points):
+    """Phase increment and the frequency it actually produces."""
+    engine_rate = cfg.sampling_frequency >> cfg.interp_stages
+    if cfg.coherent:
+        cycles = round(freq_hz / engine_rate * engine_points)
+        cycles = max(1, cycles | 1)
+        step = cycles * (1 << 32) // engine_points
+    else:
+        freq_reg = int(round(freq_hz))
+        step = (freq_reg * ((1 << 32) // engine_rate)) & 0xFFFFFFFF
+    return step, step * engine_rate / 2.0 ** 32
+
+
+def engine_model(mode, step, phase_deg, cfg, engine_points):
+    """Engine samples of one channel (WaveForms wave_*_raw)."""
+    offs = int(round(phase_deg * 100))
+    offs = (offs * ((1 << 32) // 36000)) & 0xFFFFFFFF
+    phase = (np.arange(engine_points, dtype=np.int64) * step + offs) & 0xFFFFFFFF
+
+    if mode in ('sine', 'quadrature'):
+        if cfg.engine == 'cordic':
+            sin, cos = cordic_model(phase, cfg.cordic_iterations, cfg.cordic_width)
+            return sin if mode == 'sine' else cos
+        if mode == 'quadrature':
+            phase = (phase + 0x40000000) & 0xFFFFFFFF
+        return sinewaves_model(cfg.lut, cfg.bits, phase.astype(np.uint64))
+    if mode == 'sawtooth':
+        return (phase >> 17) - 16384
+    if mode == 'triangle':
+        ramp = (phase >> 16) & 0x7FFF
+        return np.where(phase >> 31, 16383 - ramp, ramp - 16384)
+    if mode == 'square':
+        return np.where(phase < (cfg.duty << 16), FULL_SCALE, -FULL_SCALE)
+    if mode == 'arb':
+        # WaveForms indexes the table with the accumulator, without PHASE_OFF
+        return arb_model(cfg.arb, (phase - offs) & 0xFFFFFFFF, cfg.arb_interp)
+    if mode == 'noise':
+        return noise_model(engine_points, cfg.noise_seed, cfg.noise_gaussian)
+    if mode == 'dc':
+        return np.zeros(engine_points, dtype=np.int64)
+    raise ValueError(mode)
+
+
+def output_model(mode, freq_hz, phase_deg, cfg):
+    """IP output at the DAC rate: engine, interpolator, amplitude/offset."""
+    engine_points = cfg.points >> cfg.interp_stages
+    step, actual = phase_step(freq_hz, cfg, engine_points)
+    wave = engine_model(mode, step, phase_deg, cfg, engine_points)
+    for _ in range(cfg.interp_stages):
+        wave = halfband_model(wave)
+    out = ((cfg.amplitude * wave) >> 15) + cfg.offset
+    out = ((out + 32768) & 0xFFFF) - 32768
+    return out, step, actual
+
+
+# ==========================================================================
+# Spectral analysis
+# ==========================================================================
+
+def alias(freq, rate):
+    """Fold a frequency into [0, rate / 2]."""
+    f = math.fmod(freq, rate)
+    return rate - f if f > rate / 2 else f
+
+
+def analyze(samples, rate, fund_freq=None, window=True, harmonics=9, num_spurs=10):
+    """SFDR/THD/SNR/ENOB and a spur table of one record."""
+    x = np.asarray(samples, dtype=np.float64)
+    n = len(x)
+    if window:
+        k = np.arange(n) * (2.0 * math.pi / n)
+        w = sum((-1) ** i * c * np.cos(i * k) for i, c in enumerate(BH7))
+        half = BH7_HALF_WIDTH
+    else:
+        w = np.ones(n)
+        half = 0
+
+    spec = np.abs(np.fft.rfft(x * w)) ** 2
+    spec[1:-1] *= 2.0
+    spec /= n * np.sum(w * w)               # Power per bin, in LSB^2
+    bins = len(spec)
+    bin_hz = rate / n
+
+    def lobe(center):
+        return max(0, center - half), min(bins, center + half + 1)
+
+    used = np.zeros(bins, dtype=bool)
+    lo, hi = lobe(0)
+    used[lo:hi] = True
+
+    if fund_freq is None:
+        search = np.where(used, 0.0, spec)
+        fund_bin = int(np.argmax(search))
+    else:
+        fund_bin = int(round(alias(fund_freq, rate) / bin_hz))
+        lo, hi = max(0, fund_bin - 2), min(bins, fund_bin + 3)
+        fund_bin = lo + int(np.argmax(spec[lo:hi]))
+    lo, hi = lobe(fund_bin)
+    fund_power = float(spec[lo:hi].sum())
+    used[lo:hi] = True
+
+    harm_mask = np.zeros(bins, dtype=bool)
+    harm_list = []
+    for h in range(2, harmonics + 1):
+        hb = int(round(alias(h * fund_bin * bin_hz, rate) / bin_hz))
+        lo, hi = lobe(hb)
+        sel = np.zeros(bins, dtype=bool)
+        sel[lo:hi] = True
+        sel &= ~used & ~harm_mask
+        power = float(spec[sel].sum())
+        harm_mask |= sel
+        harm_list.append({'order': h, 'bin': hb, 'freq_hz': hb * bin_hz,
+                          'dbc': db(power, fund_power)})
+    harm_power = float(spec[harm_mask].sum())
+    noise_power = float(spec[~used & ~harm_mask].sum())
+
+    def largest(mask):
+        rest = np.where(mask, 0.0, spec)
+        b = int(np.argmax(rest))
+        lo, hi = lobe(b)
+        return b, float(rest[lo:hi].sum())
+
+    spurs = []
+    taken = used.copy()
+    for _ in range(num_spurs):
+        b, power = largest(taken)
+        if power <= 0.0:
+            break
+        lo, hi = lobe(b)
+        taken[lo:hi] = True
+        spurs.append({'bin': b, 'freq_hz': b * bin_hz, 'dbc': db(power, fund_power),
+                      'harmonic': bool(harm_mask[b])})
+    _, nonharm = largest(used | harm_mask)
+
+    sinad = db(fund_power, noise_power + harm_power)
+    return {
+        'fundamental': {'bin': fund_bin, 'freq_hz': fund_bin * bin_hz,
+                        'dbfs': db(fund_power, FULL_SCALE ** 2 / 2.0)},
+        'sfdr_dbc': -spurs[0]['dbc'] if spurs else None,
+        'sfdr_nonharmonic_dbc': db(fund_power, nonharm),
+        'thd_dbc': db(harm_power, fund_power),
+        'snr_db': db(fund_power, noise_power),
+        'sinad_db': sinad,
+        'enob': None if sinad is None else round((sinad - 1.76) / 6.02, 2),
+        'harmonics': harm_list,
+        'spurs': spurs,
+    }
+
+
+def analyze_toneless(samples, rate, bands=16):
+    """Level and noise figures of a record without a tone (noise, DC)."""
+    x = np.asarray(samples, dtype=np.float64)
+    n = len(x)
+    mean = float(x.mean())
+    spec = np.abs(np.fft.rfft(x - mean)) ** 2
+    spec[1:-1] *= 2.0
+    spec /= n * n
+    noise_power = float(spec.sum())
+    band_power = [float(b.sum()) for b in np.array_split(spec[1:], bands)]
+    band_db = [db(p, FULL_SCALE ** 2 / 2.0) for p in band_power]
+    ripple = (None if None in band_db
+              else round(max(band_db) - min(band_db), 2))
+    return {
+        'dc_lsb': round(mean, 2),
+        'noise_dbfs': db(noise_power, FULL_SCALE ** 2 / 2.0),
+        'noise_density_dbfs_hz': db(noise_power / (rate / 2.0), FULL_SCALE ** 2 / 2.0),
+        'snr_db': db(FULL_SCALE ** 2 / 2.0, noise_power),
+        'ripple_db': ripple,
+        'sfdr_dbc': None, 'sfdr_nonharmonic_dbc': None, 'thd_dbc': None,
+        'sinad_db': None, 'enob': None, 'harmonics': [], 'spurs': [],
+    }
+
+
+def db(num, den):
+    """10 log10(num / den), or None when either is zero (JSON null)."""
+    if num <= 0.0 or den <= 0.0:
+        return None
+    return round(10.0 * math.log10(num / den), 2)
+
+
+# ==========================================================================
+# Input and sweeps
+# ==========================================================================
+
+def read_capture(path, channel):
+    """Samples from a harness raw file (int16 LE) or CSV (sample,out_a,out_b)."""
+    if path.endswith('.csv'):
+        data = np.loadtxt(path, delimiter=',', skiprows=1, dtype=np.int64, ndmin=2)
+        return data[:, 1 if channel == 'a' else 2]
+    return np.fromfile(path, dtype='<i2').astype(np.int64)
+
+
+def parse_freqs(values):
+    freqs = []
+    for v in values:
+        if ':' in v:
+            start, stop, count = v.split(':')
+            freqs.extend(np.linspace(float(start), float(stop), int(count)).tolist())
+        else:
+            freqs.append(float(v))
+    return freqs
+
+
+def config_dict(cfg):
+    engine = {'engine': cfg.engine}
+    if cfg.engine == 'cordic':
+        engine.update(cordic_iterations=cfg.cordic_iterations,
+                      cordic_width=cfg.cordic_width)
+    else:
+        engine.update(lut_addr_width=len(cfg.lut).bit_length() - 1,
+                      lut_data_width=cfg.bits,
+                      lut_file=cfg.lut_file)
+    engine.update(interp_stages=cfg.interp_stages,
+                  sampling_frequency=cfg.sampling_frequency,
+                  amplitude=cfg.amplitude, offset=cfg.offset, duty=cfg.duty,
+                  points=cfg.points,
+                  window='rectangular' if cfg.coherent else 'blackman-harris-7')
+    if 'arb' in cfg.mode:
+        engine.update(arb_file=cfg.arb_file, arb_depth=len(cfg.arb),
+                      arb_interp=cfg.arb_interp)
+    if 'noise' in cfg.mode:
+        engine.update(noise_seed=cfg.noise_seed,
+                      noise_gaussian=cfg.noise_gaussian)
+    return engine
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Measure SFDR/THD/SNR/ENOB of the waveform generator output")
+    src = parser.add_argument_group('captured input')
+    src.add_argument('--input', type=str, nargs='+',
+                     help='Harness output (.raw int16 or .csv) to analyze instead of the model')
+    src.add_argument('--channel', choices=['a', 'b'], default='a',
+                     help='CSV column to analyze (default: a)')
+    src.add_argument('--rate', type=float, default=None,
+                     help='Sample rate of the input in Hz (default: --sampling-frequency)')
+    src.add_argument('--skip', type=int, default=0,
+                     help='Leading samples to drop (start-up)')
+    src.add_argument('--tone', type=float, default=None,
+                     help='Expected fundamental in Hz (default: largest component)')
+
+    model = parser.add_argument_group('model')
+    model.add_argument('--mode', nargs='+', choices=MODES, default=['sine'])
+    model.add_argument('--freq', nargs='+', default=['1000'],
+                       help='Frequencies in Hz, or START:STOP:COUNT (default: 1000)')
+    model.add_argument('--phase', nargs='+', type=float, default=[0.0],
+                       help='Phase offsets in degrees (default: 0)')
+    model.add_argument('--samples', type=int, default=512,
+                       help='Sine LUT entries, as coe.py --samples (default: 512)')
+    model.add_argument('--bits', type=int, default=16,
+                       help='Sine LUT width, as coe.py --bits (default: 16)')
+    model.add_argument('--lut-file', type=str, default=None,
+                       help='$readmemh table to use instead of generating one')
+    model.add_argument('--engine', choices=['lut', 'cordic'], default='lut',
+                       help='Sine engine (SINE_CORDIC = 0/1, default: lut)')
+    model.add_argument('--cordic-iterations', type=int, default=16)
+    model.add_argument('--cordic-width', type=int, default=16)
+    model.add_argument('--interp-stages', type=int, default=0, choices=[0, 1, 2, 3])
+    model.add_argument('--sampling-frequency', type=int, default=50000,
+                       help='SAMPLING_FREQUENCY parameter (DAC rate, default: 50000)')
+    model.add_argument('--amplitude', type=lambda s: int(s, 0), default=0x7FFF,
+                       help='AMPLTD register value (default: 0x7FFF)')
+    model.add_argument('--offset', type=int, default=0, help='OFFSET register value')
+    model.add_argument('--duty', type=lambda s: int(s, 0), default=0x8000,
+                       help='DTCYC register value for square (default: 0x8000)')
+    model.add_argument('--arb-file', type=str, default=None,
+                       help='ARB table for --mode arb (.raw int16, .hex/.mem, or integers)')
+    model.add_argument('--arb-interp', action='store_true',
+                       help='Linear interpolation between ARB samples')
+    model.add_argument('--noise-seed', type=lambda s: int(s, 0), default=0,
+                       help='NOISE_SEED register value (default: 0)')
+    model.add_argument('--noise-gaussian', action='store_true',
+                       help='Gaussian noise (NOISE_CFG), default uniform')
+    model.add_argument('--coherent', action='store_true',
+                       help='Round the phase step to whole FFT cycles (no window)')
+
+    parser.add_argument('--points', type=int, default=65536,
+                        help='FFT length at the output rate, a power of two (default: 65536)')
+    parser.add_argument('--harmonics', type=int, default=9,
+                        help='Highest harmonic counted in THD (default: 9)')
+    parser.add_argument('--spurs', type=int, default=10,
+                        help='Spur table length (default: 10)')
+    parser.add_argument('-o', '--output', type=str, default=None,
+                        help='JSON report file (default: stdout)')
+    args = parser.parse_args()
+
+    if args.points < 1024 or args.points & (args.points - 1):
+        parser.error('--points must be a power of two of at least 1024')
+    if not 1 <= args.cordic_iterations <= 30 or not 2 <= args.cordic_width <= 16:
+        parser.error('--cordic-iterations must be 1-30 and --cordic-width 2-16')
+    if 'arb' in args.mode and not args.input and not args.arb_file:
+        parser.error('--mode arb needs --arb-file')
+
+    results = []
+    if args.input:
+        rate = args.rate or args.sampling_frequency
+        report = {'source': 'capture', 'rate_hz': rate, 'points': args.points}
+        for path in args.input:
+            samples = read_capture(path, args.channel)[args.skip:]
+            if len(samples) < args.points:
+                sys.exit(f"{path}: {len(samples)} samples, --points needs {args.points}")
+            result = analyze(samples[-args.points:], rate, args.tone,
+                             harmonics=args.harmonics, num_spurs=args.spurs)
+            result['input'] = path
+            results.append(result)
+    else:
+        args.lut = (load_hex_lut(args.lut_file) if args.lut_file
+                    else generate_quarter_wave_lut_np(args.samples, args.bits))
+        args.arb = load_arb_table(args.arb_file) if args.arb_file else None
+        if args.arb is not None and len(args.arb) == 0:
+            sys.exit(f"{args.arb_file}: empty table")
+        report = {'source': 'model', 'config': config_dict(args)}
+        rate = args.sampling_frequency
+        for mode in args.mode:
+            for freq in parse_freqs(args.freq):
+                for phase in args.phase:
+                    samples, step, actual = output_model(mode, freq, phase, args)
+                    if mode in TONELESS:
+                        result = analyze_toneless(samples, rate)
+                    else:
+                        # An ARB table may hold several cycles: find the tone
+                        tone = None if mode == 'arb' else actual
+                        result = analyze(samples, rate, tone,
+                                         window=not args.coherent,
+                                         harmonics=args.harmonics,
+                                         num_spurs=args.spurs)
+                    result.update(mode=mode, freq_hz=freq, actual_freq_hz=actual,
+                                  phase_deg=phase, phase_step=step)
+                    results.append(result)
+
+    report['results'] = results
+    text = json.dumps(report, indent=2)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text + '\n')
+        for r in results:
+            label = r.get('input') or f"{r['mode']} {r['freq_hz']:g} Hz {r['phase_deg']:g} deg"
+            if r.get('mode') in TONELESS:
+                print(f"{label}: level {r['dc_lsb']} LSB, noise {r['noise_dbfs']} dBFS, "
+                      f"ripple {r['ripple_db']} dB")
+            else:
+                print(f"{label}: SFDR {r['sfdr_dbc']} dBc, THD {r['thd_dbc']} dBc, "
+                      f"SNR {r['snr_db']} dB, ENOB {r['enob']}")
+    else:
+        print(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,726 @@
+/*
+ * wavegen_play - play WAV or raw sample files on the waveform generator
+ *
+ * Input files are memory-mapped and converted on the fly: any PCM WAV
+ * (8/16/24/32-bit integer or 32-bit float, any channel count) or a
+ * headerless little-endian int16 file is resampled to the engine sample
+ * rate with linear interpolation and quantized with wavegen_synth.
+ *
+ * Two playback paths, both through ARB memory:
+ *
+ *   table   A single source whose converted length fits the ARB memory
+ *           is stretched over the whole table and played with a phase
+ *           step of one source sample per engine sample (cycles = 1
+ *           unless --loop). Looped sources are resampled as periodic;
+ *           one-shot sources with clamped edges so the end does not
+ *           blend into the start.
+ *
+ *   stream  The ARB memory is used as a ring buffer. The phase step is
+ *           exactly one ARB entry per engine sample, so the play head is
+ *           the channel's sample counter modulo the depth; the tool keeps
+ *           writing converted samples just behind the play head. With
+ *           different sources on A and B, channel B runs at a 180 degree
+ *           phase offset and both rings share the memory, each with about
+ *           half of it as lead. A write that arrives after the play head
+ *           has passed counts as an underrun; the stream skips ahead to
+ *           stay in time.
+ *
+ * Build:
+ *   gcc -O2 -o wavegen_play software/tools/wavegen_play.c \
+ *       software/lib/wavegen_lib.c software/lib/wavegen_synth.c \
+ *       -I software/driver -I software/lib -lm
+ */
+
+#define _DEFAULT_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "wavegen_lib.h"
+
+#define PLAY_MAX_CHUNK      4096
+#define PLAY_GUARD          16      /* Samples of slack for counter latency */
+#define PLAY_PHASE_180      18000   /* Phase offset register, 0.01 degrees */
+
+typedef enum {
+    FMT_U8,
+    FMT_S16,
+    FMT_S24,
+    FMT_S32,
+    FMT_F32
+} sample_fmt_t;
+
+struct source {
+    const char    *path;
+    void          *map;
+    size_t         map_len;
+    const uint8_t *data;        /* First frame */
+    uint64_t       frames;
+    uint32_t       rate;
+    uint32_t       channels;
+    uint32_t       frame_bytes;
+    sample_fmt_t   fmt;
+    uint32_t       channel;     /* Channel within the file */
+    uint64_t       step;        /* Source frames per output sample, 32.32 */
+    uint64_t       pos;         /* Read position, 32.32 */
+    uint64_t       out_len;     /* Converted length in engine samples */
+};
+
+struct stream {
+    struct source *src;
+    uint32_t       slot_offset; /* ARB slot of time t is (t + offset) % depth */
+    uint32_t       window;      /* Samples between the two reads of a slot */
+    uint64_t       written;     /* Next engine sample time to write */
+    uint64_t       underruns;
+};
+
+struct stats {
+    uint64_t samples;           /* Samples written to ARB memory */
+    uint64_t writes;            /* wavegen_write_arb() calls */
+    double   write_time;        /* Seconds spent in those calls */
+};
+
+static volatile sig_atomic_t stop_requested;
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop_requested = 1;
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* ============================================================
+ * Input files
+ * ============================================================ */
+
+static uint32_t le16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+static uint32_t le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int parse_wav(struct source *s, const uint8_t *p, size_t len)
+{
+    const uint8_t *fmt = NULL, *data = NULL;
+    size_t off = 12, data_len = 0;
+    uint32_t format, bits;
+
+    if (len < 12 || memcmp(p, "RIFF", 4) || memcmp(p + 8, "WAVE", 4))
+        return -1;
+
+    while (off + 8 <= len) {
+        uint32_t size = le32(p + off + 4);
+        const uint8_t *body = p + off + 8;
+        size_t avail = len - off - 8;
+
+        if (!memcmp(p + off, "fmt ", 4) && size >= 16 && avail >= 16) {
+            fmt = body;
+        } else if (!memcmp(p + off, "data", 4)) {
+            data = body;
+            /* Streaming writers may leave the size unset */
+            data_len = (size > avail) ? avail : size;
+            break;
+        }
+        off += 8 + (size_t)size + (size & 1);
+    }
+    if (!fmt || !data) {
+        fprintf(stderr, "%s: missing fmt or data chunk\n", s->path);
+        return -1;
+    }
+
+    format = le16(fmt);
+    s->channels = le16(fmt + 2);
+    s->rate = le32(fmt + 4);
+    bits = le16(fmt + 14);
+    if (format == 0xFFFE && le32(fmt - 4) >= 26)
+        format = le16(fmt + 24);    /* WAVE_FORMAT_EXTENSIBLE sub-format */
+
+    if (format == 1 && bits == 8)       s->fmt = FMT_U8;
+    else if (format == 1 && bits == 16) s->fmt = FMT_S16;
+    else if (format == 1 && bits == 24) s->fmt = FMT_S24;
+    else if (format == 1 && bits == 32) s->fmt = FMT_S32;
+    else if (format == 3 && bits == 32) s->fmt = FMT_F32;
+    else {
+        fprintf(stderr, "%s: unsupported format %u/%u-bit\n", s->path,
+                format, bits);
+        return -1;
+    }
+    if (s->channels == 0 || s->rate == 0) {
+        fprintf(stderr, "%s: bad channel count or rate\n", s->path);
+        return -1;
+    }
+
+    s->frame_bytes = s->channels * (bits / 8);
+    s->data = data;
+    s->frames = data_len / s->frame_bytes;
+    return 0;
+}
+
+static int source_open(struct source *s, int raw, uint32_t raw_rate,
+                       uint32_t raw_channels)
+{
+    struct stat st;
+    int fdin;
+
+    fdin = open(s->path, O_RDONLY);
+    if (fdin < 0 || fstat(fdin, &st) < 0) {
+        fprintf(stderr, "%s: %s\n", s->path, strerror(errno));
+        if (fdin >= 0) close(fdin);
+        return -1;
+    }
+    s->map_len = st.st_size;
+    s->map = (s->map_len > 0) ?
+        mmap(NULL, s->map_len, PROT_READ, MAP_PRIVATE, fdin, 0) : MAP_FAILED;
+    close(fdin);
+    if (s->map == MAP_FAILED) {
+        fprintf(stderr, "%s: cannot map file\n", s->path);
+        s->map = NULL;
+        return -1;
+    }
+    madvise(s->map, s->map_len, MADV_SEQUENTIAL);
+
+    if (raw) {
+        s->fmt = FMT_S16;
+        s->rate = raw_rate;
+        s->channels = raw_channels;
+        s->frame_bytes = 2 * raw_channels;
+        s->data = s->map;
+        s->frames = s->map_len / s->frame_bytes;
+    } else if (parse_wav(s, s->map, s->map_len) < 0) {
+        return -1;
+    }
+
+    if (s->frames == 0) {
+        fprintf(stderr, "%s: no samples\n", s->path);
+        return -1;
+    }
+    if (s->channel >= s->channels)
+        s->channel = s->channels - 1;
+    return 0;
+}
+
+static void source_close(struct source *s)
+{
+    if (s->map)
+        munmap(s->map, s->map_len);
+    s->map = NULL;
+}
+
+static float source_frame(const struct source *s, uint64_t frame)
+{
+    const uint8_t *p = s->data + frame * s->frame_bytes;
+    uint32_t u;
+    float f;
+
+    switch (s->fmt) {
+    case FMT_U8:
+        return (p[s->channel] - 128) * (1.0f / 128.0f);
+    case FMT_S16:
+        p += s->channel * 2;
+        return (int16_t)le16(p) * (1.0f / 32768.0f);
+    case FMT_S24:
+        p += s->channel * 3;
+        return ((int32_t)((p[0] << 8) | (p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8)
+               * (1.0f / 8388608.0f);
+    case FMT_S32:
+        p += s->channel * 4;
+        return (int32_t)le32(p) * (1.0f / 2147483648.0f);
+    default:
+        p += s->channel * 4;
+        u = le32(p);
+        memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+}
+
+static void source_set_rate(struct source *s, uint32_t engine_rate)
+{
+    s->step = ((uint64_t)s->rate << 32) / engine_rate;
+    s->pos = 0;
+    s->out_len = ((s->frames << 32) + s->step - 1) / s->step;
+}
+
+/* Render n engine-rate samples; past the end: wrap (loop) or silence */
+static void source_render(struct source *s, float *out, uint32_t n, int loop)
+{
+    const uint64_t end = s->frames << 32;
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        uint64_t idx;
+        float frac, a, b;
+
+        if (s->pos >= end) {
+            if (!loop) {
+                out[i] = 0.0f;
+                continue;
+            }
+            s->pos -= end;
+        }
+        idx = s->pos >> 32;
+        frac = (float)(uint32_t)s->pos * (1.0f / 4294967296.0f);
+        a = source_frame(s, idx);
+        if (idx + 1 < s->frames)
+            b = source_frame(s, idx + 1);
+        else
+            b = loop ? source_frame(s, 0) : a;
+        out[i] = a + frac * (b - a);
+        s->pos += s->step;
+    }
+}
+
+/*
+ * Stretch a one-shot source over count table entries with clamped edges:
+ * the first and last entries land on the first and last source samples,
+ * so the end never interpolates back into the start (the periodic
+ * resampler in wavegen_synth is only right for looped playback).
+ */
+static void resample_clamped(float *dst, uint32_t count,
+                             const float *src, uint32_t src_count)
+{
+    uint64_t step, pos = 0;
+    uint32_t i;
+
+    if (count < 2 || src_count < 2) {
+        for (i = 0; i < count; i++)
+            dst[i] = src[0];
+        return;
+    }
+    step = ((uint64_t)(src_count - 1) << 32) / (count - 1);
+    for (i = 0; i < count; i++) {
+        uint32_t idx = (uint32_t)(pos >> 32);
+        float frac = (float)(uint32_t)pos * (1.0f / 4294967296.0f);
+
+        if (idx >= src_count - 1)
+            dst[i] = src[src_count - 1];
+        else
+            dst[i] = src[idx] + frac * (src[idx + 1] - src[idx]);
+        pos += step;
+    }
+}
+
+/* ============================================================
+ * Engine phase arithmetic
+ * ============================================================ */
+
+/*
+ * Frequency register value that advances WaveForms by `step` phase units
+ * per sample. The engine computes freq * floor(2^32 / rate) and keeps the
+ * low 32 bits, so the exact answer multiplies by the inverse of the odd
+ * part of the scale modulo 2^32 (the step is rounded to the scale's
+ * power-of-two factor).
+ */
+static uint32_t freq_for_step(uint32_t step, uint32_t rate)
+{
+    uint32_t scale = (uint32_t)(0x100000000ULL / rate);
+    uint32_t inv, mask = 0xFFFFFFFFu;
+    unsigned k = 0, i;
+
+    while (!(scale & 1)) {
+        scale >>= 1;
+        k++;
+    }
+    inv = scale;                            /* Correct to 3 bits */
+    for (i = 0; i < 4; i++)
+        inv *= 2 - scale * inv;             /* Newton: 6, 12, 24, 48 bits */
+
+    if (k) {
+        step = (uint32_t)(((uint64_t)step + (1u << (k - 1))) >> k);
+        mask >>= k;
+    }
+    return (step * inv) & mask;
+}
+
+/* ARB slot read by the engine for a phase offset register value */
+static uint32_t slot_for_offset(int16_t phase_offset, unsigned addr_bits)
+{
+    uint32_t scale = (uint32_t)(0x100000000ULL / 36000);
+    uint32_t phase = (uint32_t)((int32_t)phase_offset * (int64_t)scale);
+
+    return phase >> (32 - addr_bits);
+}
+
+/* ============================================================
+ * Streaming
+ * ============================================================ */
+
+static int stream_write(struct stream *st, uint64_t upto, uint32_t depth,
+                        uint32_t chunk, double gain, int loop,
+                        struct stats *stats)
+{
+    float fbuf[PLAY_MAX_CHUNK];
+    uint16_t table[PLAY_MAX_CHUNK];
+
+    while (st->written < upto) {
+        uint32_t slot = (uint32_t)((st->written + st->slot_offset) % depth);
+        uint64_t left = upto - st->written;
+        uint32_t n = chunk;
+        double t0;
+
+        if (n > left) n = (uint32_t)left;
+        if (n > depth - slot) n = depth - slot;
+
+        source_render(st->src, fbuf, n, loop);
+        wavegen_synth_quantize(table, fbuf, n, gain);
+
+        t0 = now_seconds();
+        if (wavegen_write_arb(slot, table, n) != WAVEGEN_OK)
+            return -1;
+        stats->write_time += now_seconds() - t0;
+        stats->writes++;
+        stats->samples += n;
+        st->written += n;
+    }
+    return 0;
+}
+
+/* Drop samples the play head has already passed, keeping time alignment */
+static void stream_skip(struct stream *st, uint64_t to, int loop)
+{
+    float scratch[PLAY_MAX_CHUNK];
+
+    while (st->written < to) {
+        uint64_t n = to - st->written;
+        if (n > PLAY_MAX_CHUNK) n = PLAY_MAX_CHUNK;
+        source_render(st->src, scratch, (uint32_t)n, loop);
+        st->written += n;
+    }
+}
+
+/* ============================================================
+ * Command line
+ * ============================================================ */
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "Usage: %s [options] [FILE]\n"
+        "  -a, --file-a FILE       File for channel A\n"
+        "  -b, --file-b FILE       File for channel B\n"
+        "  -c, --channel a|b|both  Output channel(s) for FILE (default: a)\n"
+        "  -l, --loop              Loop until interrupted\n"
+        "  -g, --gain G            Gain, 1.0 = full scale (default: 1.0)\n"
+        "  -r, --rate HZ           Engine sample rate, SAMPLING_FREQUENCY >>\n"
+        "                          INTERP_STAGES (default: 50000)\n"
+        "  -d, --depth N           ARB memory size, ARB_WAVEFORM_DEPTH\n"
+        "                          (default: 1024)\n"
+        "  -k, --chunk N           Samples per ARB write (default: depth/8)\n"
+        "  -m, --mode MODE         auto, table or stream (default: auto)\n"
+        "  -s, --source-channel N  File channel to play (default: 0; channel B\n"
+        "                          takes 1 when one stereo FILE plays on both)\n"
+        "      --raw               Headerless little-endian int16 input\n"
+        "      --raw-rate HZ       Raw input sample rate (default: engine rate)\n"
+        "      --raw-channels N    Raw input channel count (default: 1)\n"
+        "  -v, --verbose           Print statistics every second\n",
+        prog);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct option longopts[] = {
+        { "file-a",         required_argument, NULL, 'a' },
+        { "file-b",         required_argument, NULL, 'b' },
+        { "channel",        required_argument, NULL, 'c' },
+        { "loop",           no_argument,       NULL, 'l' },
+        { "gain",           required_argument, NULL, 'g' },
+        { "rate",           required_argument, NULL, 'r' },
+        { "depth",          required_argument, NULL, 'd' },
+        { "chunk",          required_argument, NULL, 'k' },
+        { "mode",           required_argument, NULL, 'm' },
+        { "source-channel", required_argument, NULL, 's' },
+        { "raw",            no_argument,       NULL, 'R' },
+        { "raw-rate",       required_argument, NULL, 'S' },
+        { "raw-channels",   required_argument, NULL, 'C' },
+        { "verbose",        no_argument,       NULL, 'v' },
+        { "help",           no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+    struct source src[2];
+    struct stream streams[2];
+    struct stats stats = { 0, 0, 0.0 };
+    const char *file = NULL, *file_a = NULL, *file_b = NULL, *mode = "auto";
+    wavegen_channel_t out = WAVEGEN_CH_A;
+    uint32_t rate = 50000, depth = 1024, chunk = 0, raw_rate = 0;
+    uint32_t raw_channels = 1, src_channel = 0;
+    unsigned addr_bits = 0;
+    int loop = 0, raw = 0, verbose = 0, nsrc = 0, nstreams = 0, opt, i;
+    int table_mode, ret = 1;
+    double gain = 1.0, t_start, t_report;
+    uint64_t play = 0, end_time = 0;
+
+    while ((opt = getopt_long(argc, argv, "a:b:c:lg:r:d:k:m:s:vh",
+                              longopts, NULL)) != -1) {
+        switch (opt) {
+        case 'a': file_a = optarg; break;
+        case 'b': file_b = optarg; break;
+        case 'c':
+            if (!strcmp(optarg, "a"))         out = WAVEGEN_CH_A;
+            else if (!strcmp(optarg, "b"))    out = WAVEGEN_CH_B;
+            else if (!strcmp(optarg, "both")) out = WAVEGEN_CH_BOTH;
+            else { usage(argv[0]); return 1; }
+            break;
+        case 'l': loop = 1; break;
+        case 'g': gain = atof(optarg); break;
+        case 'r': rate = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'd': depth = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'k': chunk = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'm': mode = optarg; break;
+        case 's': src_channel = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'R': raw = 1; break;
+        case 'S': raw_rate = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'C': raw_channels = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'v': verbose = 1; break;
+        default:  usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind < argc)
+        file = argv[optind];
+
+    if (rate < 2 || depth < 16 || (depth & (depth - 1)) || raw_channels == 0 ||
+        (!file && !file_a && !file_b) || (file && (file_a || file_b)) ||
+        (strcmp(mode, "auto") && strcmp(mode, "table") && strcmp(mode, "stream"))) {
+        usage(argv[0]);
+        return 1;
+    }
+    while ((1u << addr_bits) < depth)
+        addr_bits++;
+    if (chunk == 0)
+        chunk = depth / 8;
+    if (chunk > PLAY_MAX_CHUNK)
+        chunk = PLAY_MAX_CHUNK;
+    if (raw_rate == 0)
+        raw_rate = rate;
+
+    /* Sources: one FILE for the selected channel(s), or per-channel files */
+    memset(src, 0, sizeof(src));
+    if (file) {
+        src[0].path = file;
+        src[0].channel = src_channel;
+        nsrc = 1;
+    } else {
+        if (file_a) {
+            src[nsrc].path = file_a;
+            src[nsrc++].channel = src_channel;
+        }
+        if (file_b) {
+            src[nsrc].path = file_b;
+            src[nsrc++].channel = src_channel;
+        }
+        out = (file_a && file_b) ? WAVEGEN_CH_BOTH :
+              file_a ? WAVEGEN_CH_A : WAVEGEN_CH_B;
+    }
+    for (i = 0; i < nsrc; i++) {
+        if (source_open(&src[i], raw, raw_rate, raw_channels) < 0)
+            goto out_close;
+        source_set_rate(&src[i], rate);
+        fprintf(stderr, "%s: %llu frames, %u Hz, %u ch -> %llu samples at %u Hz\n",
+                src[i].path, (unsigned long long)src[i].frames, src[i].rate,
+                src[i].channels, (unsigned long long)src[i].out_len, rate);
+    }
+    /* A stereo FILE on both channels plays left on A and right on B */
+    if (file && out == WAVEGEN_CH_BOTH && src[0].channels > 1 &&
+        src_channel == 0) {
+        src[1] = src[0];
+        src[1].map = NULL;      /* Shared mapping, closed once */
+        src[1].channel = 1;
+        nsrc = 2;
+    }
+
+    table_mode = !strcmp(mode, "table") ||
+                 (!strcmp(mode, "auto") && nsrc == 1 && src[0].out_len <= depth);
+    if (table_mode && (nsrc != 1 || src[0].out_len > depth)) {
+        fprintf(stderr, "table mode needs one source of at most %u samples\n",
+                depth);
+        goto out_close;
+    }
+
+    if (wavegen_init() != WAVEGEN_OK) {
+        fprintf(stderr, "Failed to open /dev/wavegen\n");
+        goto out_close;
+    }
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    wavegen_stop(out);
+    wavegen_set_mode(out, WAVEGEN_MODE_ARB);
+    wavegen_set_amplitude(out, 32767);
+    wavegen_set_offset(out, 0);
+    wavegen_set_arb_depth(depth);
+
+    if (table_mode) {
+        /* ============================================================
+         * Table: stretch the whole source over the ARB memory
+         * ============================================================ */
+        float *fbuf = malloc(src[0].out_len * sizeof(float));
+        float *stretched = malloc(depth * sizeof(float));
+        uint16_t *table = malloc(depth * sizeof(uint16_t));
+        uint32_t step = (uint32_t)((0x100000000ULL + src[0].out_len / 2) /
+                                   src[0].out_len);
+
+        if (!fbuf || !stretched || !table) {
+            free(fbuf);
+            free(stretched);
+            free(table);
+            goto out_wavegen;
+        }
+        source_render(&src[0], fbuf, (uint32_t)src[0].out_len, 0);
+        if (loop) {
+            wavegen_synth_resample(table, depth, fbuf,
+                                   (uint32_t)src[0].out_len, gain);
+        } else {
+            resample_clamped(stretched, depth, fbuf, (uint32_t)src[0].out_len);
+            wavegen_synth_quantize(table, stretched, depth, gain);
+        }
+        t_start = now_seconds();
+        ret = wavegen_load_arb_waveform(table, depth) != WAVEGEN_OK;
+        stats.write_time = now_seconds() - t_start;
+        stats.samples = depth;
+        stats.writes = 1;
+        free(fbuf);
+        free(stretched);
+        free(table);
+        if (ret)
+            goto out_wavegen;
+
+        wavegen_set_frequency(out, freq_for_step(step, rate));
+        wavegen_set_phase_offset(out, 0);
+        wavegen_set_cycles(out, loop ? 0 : 1);
+        wavegen_apply();
+        wavegen_start(out);
+
+        end_time = src[0].out_len;
+        t_start = now_seconds();
+        while (!stop_requested &&
+               (loop || now_seconds() - t_start < (double)end_time / rate))
+            usleep(10000);
+        play = (uint64_t)((now_seconds() - t_start) * rate);
+        nstreams = 0;
+    } else {
+        /* ============================================================
+         * Stream: ARB memory as a ring, one entry per engine sample
+         * ============================================================ */
+        uint32_t lead = slot_for_offset(PLAY_PHASE_180, addr_bits);
+        int dual = (nsrc == 2);
+
+        memset(streams, 0, sizeof(streams));
+        for (i = 0; i < nsrc; i++) {
+            streams[i].src = &src[i];
+            if (!dual) {
+                streams[i].window = depth;
+            } else if (i == 0) {
+                streams[i].window = lead;           /* A after B's read */
+            } else {
+                streams[i].slot_offset = lead;
+                streams[i].window = depth - lead;   /* B after A's read */
+            }
+            if (src[i].out_len > end_time)
+                end_time = src[i].out_len;
+        }
+        nstreams = nsrc;
+        if (chunk > depth / 4)
+            chunk = depth / 4;
+
+        wavegen_set_frequency(out, freq_for_step(1u << (32 - addr_bits), rate));
+        wavegen_set_cycles(out, 0);
+        if (dual) {
+            wavegen_set_phase_offset(WAVEGEN_CH_A, 0);
+            wavegen_set_phase_offset(WAVEGEN_CH_B, PLAY_PHASE_180);
+        } else {
+            wavegen_set_phase_offset(out, 0);
+        }
+        /* Ring entries are plain samples, one per engine sample */
+        if (wavegen_set_arb_format(WAVEGEN_ARB_RAW) != WAVEGEN_OK ||
+            wavegen_set_arb_interpolation(out, 0) != WAVEGEN_OK) {
+            fprintf(stderr, "Failed to select plain ARB samples\n");
+            goto out_wavegen;
+        }
+        wavegen_apply();
+
+        t_start = now_seconds();
+        for (i = 0; i < nstreams; i++)
+            if (stream_write(&streams[i], streams[i].window - PLAY_GUARD, depth,
+                             chunk, gain, loop, &stats) < 0)
+                goto out_stop;
+
+        wavegen_clear_counters();
+        wavegen_start(out);
+        t_start = t_report = now_seconds();
+
+        while (!stop_requested) {
+            wavegen_counters_t cnt;
+
+            if (wavegen_get_counters(&cnt) != WAVEGEN_OK)
+                break;
+            play = (out == WAVEGEN_CH_B) ? cnt.samples_b : cnt.samples_a;
+            if (!loop && play >= end_time)
+                break;
+
+            for (i = 0; i < nstreams; i++) {
+                struct stream *st = &streams[i];
+
+                if (st->written < play + PLAY_GUARD) {
+                    st->underruns++;
+                    stream_skip(st, play + PLAY_GUARD, loop);
+                }
+                if (stream_write(st, play + st->window - PLAY_GUARD, depth,
+                                 chunk, gain, loop, &stats) < 0)
+                    goto out_stop;
+            }
+
+            if (verbose && now_seconds() - t_report >= 1.0) {
+                t_report = now_seconds();
+                fprintf(stderr, "t=%.1fs played=%llu written=%llu underruns=%llu\n",
+                        t_report - t_start, (unsigned long long)play,
+                        (unsigned long long)stats.samples,
+                        (unsigned long long)(streams[0].underruns +
+                                             streams[1].underruns));
+            }
+            /* Sleep for about half a chunk */
+            usleep((useconds_t)(500000.0 * chunk / rate) + 1);
+        }
+    }
+    ret = 0;
+
+out_stop:
+    wavegen_stop(out);
+    {
+        double elapsed = now_seconds() - t_start;
+        uint64_t underruns = 0;
+
+        for (i = 0; i < nstreams; i++)
+            underruns += streams[i].underruns;
+        printf("Mode        : %s\n", table_mode ? "table" : "stream");
+        printf("Played      : %llu samples in %.2f s (%.0f samples/s)\n",
+               (unsigned long long)play, elapsed,
+               elapsed > 0 ? play / elapsed : 0.0);
+        printf("Written     : %llu samples in %llu writes\n",
+               (unsigned long long)stats.samples,
+               (unsigned long long)stats.writes);
+        printf("ARB write   : %.0f samples/s (%.1fx the engine rate)\n",
+               stats.write_time > 0 ? stats.samples / stats.write_time : 0.0,
+               stats.write_time > 0 ? stats.samples / stats.write_time / rate : 0.0);
+        printf("Underruns   : %llu\n", (unsigned long long)underruns);
+    }
+
+out_wavegen:
+    wavegen_close();
+out_close:
+    for (i = 0; i < 2; i++)
+        source_close(&src[i]);
+    return ret;
+}
\ No newline at end of file